@@ -2,419 +2,538 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <gmp.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <time.h>
 
-#include "ecc/ecc.h"
-#include "sha256/sha256.h"
-#include "ripemd160/ripemd160.h"
-#include "base58/base58.h"
-#include "bech32/bech32.h"
+#include "brainwallet/brainwallet.h"
 #include "customutil/customutil.h"
+#include "pipeline/pipeline.h"
+#include "sha256/sha256.h"
+#include "targets/targets.h"
+#include "rules/rules.h"
+#include "combine/combine.h"
+#include "checkpoint/checkpoint.h"
+#include "wordlist/wordlist.h"
+
+/* 输出一个密码短语的完整报告：私钥、WIF、公钥、hash160 以及全部地址 */
+static int report_phrase(const BW_CTX *ctx, const char *password_phrase, const uint8_t phrase_hash[32], uint64_t iterations) {
+    char priv_hex[65] = {0};
+    hex_encode(priv_hex, phrase_hash, 32);
 
-/* secp256k1 椭圆曲线参数 */
-const char *EC_constant_N = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141";
-const char *EC_constant_P = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
-const char *EC_constant_Gx = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
-const char *EC_constant_Gy = "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
-
-/* 辅助函数声明 */
-int hex2bin(const char *hex, uint8_t *bin, size_t bin_len);
-int wif_to_private_key(const char *wif, char *priv_hex, size_t hex_len, bool *compressed);
-int private_key_to_wif(const char *priv_hex, bool compressed, char *wif, size_t wif_len);
-void hash160(const uint8_t *data, size_t data_len, uint8_t *out);
-int base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len);
+    printf("Password Phrase: %s\n", password_phrase);
+    if (iterations == 1)
+        printf("SHA256 Hash (passphrase Hex): %s\n", priv_hex);
+    else
+        printf("SHA256 x%llu Hash (passphrase Hex): %s\n", (unsigned long long)iterations, priv_hex);
+    
 
-/* 新增函数声明 */
-char *public_key_to_address(const char *public_key_hex, const char *address_type);
+    /* 将私钥转换为 WIF 格式（压缩和非压缩） */
+    char wif_compressed[100] = {0};
+    char wif_uncompressed[100] = {0};
 
-/* 将 hex 字符串转换为二进制数据 */
-int hex2bin(const char *hex, uint8_t *bin, size_t bin_len) {
-    size_t hex_len = strlen(hex);
-    if (hex_len != bin_len * 2)
-        return -1;
-    for (size_t i = 0; i < bin_len; i++) {
-        unsigned int byte;
-        if (sscanf(hex + 2 * i, "%02x", &byte) != 1)
-            return -1;
-        bin[i] = (uint8_t)byte;
+    if (bw_wif_encode(phrase_hash, true, wif_compressed, sizeof(wif_compressed)) != 0) {
+        fprintf(stderr, "私钥转换为压缩 WIF 失败\n");
+        return 1;
+    }
+    if (bw_wif_encode(phrase_hash, false, wif_uncompressed, sizeof(wif_uncompressed)) != 0) {
+        fprintf(stderr, "私钥转换为非压缩 WIF 失败\n");
+        return 1;
     }
-    return 0;
-}
 
-/* 将 WIF 解码为私钥的 16 进制字符串，并判断是否为压缩格式 */
-int wif_to_private_key(const char *wif, char *priv_hex, size_t hex_len, bool *compressed) {
-    size_t decoded_len = 100;
-    uint8_t decoded[100] = {0};
+    printf("WIF Private Key (Compressed): %s\n", wif_compressed);
+    printf("WIF Private Key (Uncompressed): %s\n", wif_uncompressed);
 
-    if (!b58tobin(decoded, &decoded_len, wif, strlen(wif)))
-        return -1;
+    /* 由私钥计算公钥 */
+    uint8_t pub_comp_bin[BW_PUBKEY_COMPRESSED_LEN];
+    uint8_t pub_uncomp_bin[BW_PUBKEY_UNCOMPRESSED_LEN];
+    if (bw_privkeys_to_pubkeys(ctx, phrase_hash, 1, pub_comp_bin, pub_uncomp_bin) != 0) {
+        fprintf(stderr, "Error: 无效的私钥\n");
+        return 1;
+    }
 
-    /* 解码后长度应为 37 字节（非压缩）或 38 字节（压缩） */
-    if (decoded_len == 37)
-        *compressed = false;
-    else if (decoded_len == 38)
-        *compressed = true;
-    else
-        return -1;
+    char pub_hex_comp[67] = {0};
+    char pub_hex_uncomp[131] = {0};
+    hex_encode(pub_hex_comp, pub_comp_bin, sizeof(pub_comp_bin));
+    hex_encode(pub_hex_uncomp, pub_uncomp_bin, sizeof(pub_uncomp_bin));
+    printf("\nCompressed Public Key: %s\n", pub_hex_comp);
+    printf("Uncompressed Public Key: %s\n", pub_hex_uncomp);
 
-    /* 检查版本字节：应为 0x80 */
-    if (decoded[0] != 0x80)
-        return -1;
+    /* 计算并显示公钥 hash160 值，地址生成直接复用 */
+    uint8_t pub_comp_hash160[20] = {0};
+    uint8_t pub_uncomp_hash160[20] = {0};
+    bw_pubkeys_to_hash160s(pub_comp_bin, sizeof(pub_comp_bin), 1, pub_comp_hash160);
+    bw_pubkeys_to_hash160s(pub_uncomp_bin, sizeof(pub_uncomp_bin), 1, pub_uncomp_hash160);
+
+    char hash160_hex[41] = {0};
+    hex_encode(hash160_hex, pub_comp_hash160, 20);
+    printf("Compressed Public Key Hash160: %s\n", hash160_hex);
+    hex_encode(hash160_hex, pub_uncomp_hash160, 20);
+    printf("Uncompressed Public Key Hash160: %s\n", hash160_hex);
+
+    ADDRESS_SET addr_comp, addr_uncomp;
+    if (bw_pubkeys_to_addresses(pub_comp_bin, sizeof(pub_comp_bin), pub_comp_hash160, 1, ADDRESS_ALL, &addr_comp) != 0 ||
+        bw_pubkeys_to_addresses(pub_uncomp_bin, sizeof(pub_uncomp_bin), pub_uncomp_hash160, 1, ADDRESS_ALL, &addr_uncomp) != 0) {
+        fprintf(stderr, "Error: 地址生成失败\n");
+        return 1;
+    }
 
-    /* 校验 checksum：对前 decoded_len-4 字节进行双 SHA256 */
-    uint8_t hash1[32], hash2[32];
-    sha256(decoded, decoded_len - 4, hash1);
-    sha256(hash1, 32, hash2);
-    if (memcmp(hash2, decoded + decoded_len - 4, 4) != 0)
-        return -1;
+    printf("\n=== Addresses Generated from Compressed Public Key ===\n");
+    address_print(&addr_comp, "Compressed");
+
+    printf("\n=== Addresses Generated from Uncompressed Public Key ===\n");
+    address_print(&addr_uncomp, "Uncompressed");
 
-    /* 私钥位于 decoded[1..32] */
-    if (hex_len < 65)
-        return -1;
-    for (int i = 0; i < 32; i++) {
-        sprintf(priv_hex + i * 2, "%02x", decoded[1 + i]);
-    }
-    priv_hex[64] = '\0';
     return 0;
 }
 
-/* 将 32 字节私钥（Hex）转换为 WIF 格式 */
-int private_key_to_wif(const char *priv_hex, bool compressed, char *wif, size_t wif_len) {
-    uint8_t priv_bin[32];
-    if (hex2bin(priv_hex, priv_bin, 32) != 0)
+static void free_candidates(char **lines, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        free(lines[i]);
+    free(lines);
+}
+
+/*
+ * 读取一行一个的候选短语，去掉行尾换行，跳过空行。空文件得到 0 条候选。
+ * 成功返回 0，*out 由 free_candidates 释放；打开、读取或内存错误返回 -1。
+ */
+static int read_candidates(const char *path, char ***out, size_t *count) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: 无法打开候选文件 %s\n", path);
         return -1;
-    uint8_t payload[34];
-    payload[0] = 0x80;
-    memcpy(payload + 1, priv_bin, 32);
-    size_t payload_len = 33;
-    if (compressed) {
-        payload[33] = 0x01;
-        payload_len = 34;
     }
-    uint8_t hash1[32], hash2[32];
-    sha256(payload, payload_len, hash1);
-    sha256(hash1, 32, hash2);
-    uint8_t full[38];
-    memcpy(full, payload, payload_len);
-    memcpy(full + payload_len, hash2, 4);
-    size_t full_len = payload_len + 4;
-    size_t encoded_len = wif_len;
-    if (!b58enc(wif, &encoded_len, full, full_len))
+    char **lines = NULL;
+    size_t n = 0, cap = 0;
+    char *line = NULL;
+    size_t line_cap = 0;
+    ssize_t len;
+    int ret = 0;
+    while ((len = getline(&line, &line_cap, fp)) != -1) {
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            line[--len] = '\0';
+        if (len == 0)
+            continue;
+        if (n == cap) {
+            cap = cap ? cap * 2 : 1024;
+            char **grown = (char **)realloc(lines, cap * sizeof(char *));
+            if (grown == NULL) {
+                ret = -1;
+                break;
+            }
+            lines = grown;
+        }
+        if ((lines[n] = strdup(line)) == NULL) {
+            ret = -1;
+            break;
+        }
+        n++;
+    }
+    if (ret == 0 && ferror(fp)) {
+        fprintf(stderr, "Error: 读取候选文件 %s 失败\n", path);
+        ret = -1;
+    } else if (ret != 0) {
+        fprintf(stderr, "Error: Memory allocation failed.\n");
+    }
+    free(line);
+    fclose(fp);
+    if (ret != 0) {
+        free_candidates(lines, n);
         return -1;
+    }
+    *out = lines;
+    *count = n;
     return 0;
 }
 
-/* 计算 hash160 (RIPEMD160(SHA256(data))) */
-void hash160(const uint8_t *data, size_t data_len, uint8_t *out) {
-    uint8_t sha[32];
-    sha256(data, data_len, sha);
-    RMD160Data(sha, 32, out);
+static int compare_phrases(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
 }
 
-/* 根据版本字节和 20 字节数据生成 Base58Check 地址 */
-int base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len) {
-    uint8_t payload[21];
-    payload[0] = version;
-    memcpy(payload + 1, hash20, 20);
-    uint8_t hash1[32], hash2[32];
-    sha256(payload, 21, hash1);
-    sha256(hash1, 32, hash2);
-    uint8_t full[25];
-    memcpy(full, payload, 21);
-    memcpy(full + 21, hash2, 4);
-    size_t encoded_len = addr_len;
-    if (!b58enc(address, &encoded_len, full, 25))
-         return -1;
-    return 0;
-}
+/*
+ * 候选模式：按字典序排序后逐条处理，使共享前缀的短语相邻，
+ * 通过 SHA-256 中间状态缓存跳过公共前缀中完整 64 字节块的压缩。
+ * iterations > 1 时，其余轮次对全部候选批量进行多缓冲迭代。
+ */
+static int run_candidates(const BW_CTX *ctx, const char *path, uint64_t iterations) {
+    size_t count = 0;
+    char **phrases = NULL;
+    if (read_candidates(path, &phrases, &count) != 0)
+        return 1;
+    if (count > 1)
+        qsort(phrases, count, sizeof(char *), compare_phrases);
 
-/* 根据公钥和地址类型生成地址 */
-char *public_key_to_address(const char *public_key_hex, const char *address_type) {
-    uint8_t pub_bin[100] = {0}; // 假设公钥最大长度为 100 bytes
-    size_t pub_bin_len = strlen(public_key_hex) / 2;
-    if (hex2bin(public_key_hex, pub_bin, pub_bin_len) != 0) {
-        fprintf(stderr, "Error: Invalid public key hex.\n");
-        return NULL;
-    }
-    
-    uint8_t hash_160[20] = {0};
-    hash160(pub_bin, pub_bin_len, hash_160);
-    
-    char *address = (char *)malloc(100 * sizeof(char));
-    if (address == NULL) {
+    uint8_t *hashes = (uint8_t *)malloc(count * 32 + 1);
+    if (hashes == NULL) {
         fprintf(stderr, "Error: Memory allocation failed.\n");
-        return NULL;
-    }
-        
-    if (strcmp(address_type, "P2PKH") == 0) {
-      if (base58check_encode(0x00, hash_160, address, 100) != 0) {
-        free(address);
-        return NULL;
-      }
-    } else if (strcmp(address_type, "P2SH") == 0) {
-      if (base58check_encode(0x05, hash_160, address, 100) != 0) {
-        free(address);
-        return NULL;
-      }
-    } else if (strcmp(address_type, "BECH32") == 0) {
-        if(segwit_addr_encode(address, "bc", 0, hash_160, 20) != 1)
-        {
-          free(address);
-           return NULL;
-        }
-    }
-     else if (strcmp(address_type, "BECH32M") == 0) {
-        if(segwit_addr_encode(address, "bc", 1, hash_160, 20) != 1)
-        {
-          free(address);
-          return NULL;
-        }
-     }
-    else if(strcmp(address_type, "P2SH-P2WPKH") == 0){
-        // P2SH wrapped P2WPKH: script is hash160(0014<20 byte key hash>), address is base58(script, 0x05 version)
-        uint8_t redeem_script[22] = {0x00, 0x14};
-        memcpy(redeem_script + 2, hash_160, 20);
-        uint8_t redeem_hash160[20] = {0};
-        hash160(redeem_script, 22, redeem_hash160);
-       if (base58check_encode(0x05, redeem_hash160, address, 100) != 0) {
-            free(address);
-            return NULL;
-        }
+        free_candidates(phrases, count);
+        return 1;
     }
-    else if (strcmp(address_type, "P2WSH") == 0){
-          // P2WSH: script hash is hash256(script), address is bech32(witness_version = 0, script_hash)
-        uint8_t sha[32];
-        sha256(pub_bin, pub_bin_len, sha);
-      if(segwit_addr_encode(address, "bc", 0, sha, 32) != 1)
-       {
-          free(address);
-           return NULL;
-       }
+
+    SHA256_PREFIX_CACHE cache;
+    sha256_cache_init(&cache);
+    uint64_t total_blocks = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = strlen(phrases[i]);
+        sha256_cached(&cache, phrases[i], len, hashes + i * 32);
+        total_blocks += len / 64;
     }
-    else if (strcmp(address_type, "P2WSH-P2WPKH") == 0) {
-        // P2WSH wrapped P2WPKH: redeem_script is 0014<20byte public key hash>, script_hash = sha256(script)
-         uint8_t redeem_script[22] = {0x00, 0x14};
-        memcpy(redeem_script + 2, hash_160, 20);
-         uint8_t sha[32];
-        sha256(redeem_script, 22, sha);
-       if(segwit_addr_encode(address, "bc", 0, sha, 32) != 1)
-       {
-           free(address);
-          return NULL;
-       }
-    } else {
-        free(address);
-        fprintf(stderr, "Error: Invalid address type.\n");
-        return NULL;
+    if (iterations > 1)
+        sha256_iterate_many(hashes, count, iterations - 1, hashes);
+
+    int ret = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0)
+            printf("\n");
+        if (report_phrase(ctx, phrases[i], hashes + i * 32, iterations) != 0)
+            ret = 1;
+        free(phrases[i]);
     }
-   return address;
+    free(phrases);
+    free(hashes);
+    fprintf(stderr, "Candidates: %zu, SHA-256 blocks reused: %llu / %llu\n",
+            count, (unsigned long long)cache.blocks_reused, (unsigned long long)total_blocks);
+    return ret;
 }
 
-int main(int argc, char **argv) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <Password Phrase>\n", argv[0]);
-        return 1;
+/*
+ * 批量模式：从 cfg->in 或映射词表逐行读取短语（去掉行尾换行，跳过空行）或枚举多词组合，由线程池按批推导，
+ * 每条短语输出一行制表符分隔的记录；设置了目标集合时只输出命中的短语。
+ * resume 为真时从 cfg->checkpoint 记录的位置继续。
+ */
+static int run_stream(PIPELINE_STREAM_CONFIG *cfg, bool resume) {
+    PIPELINE_STREAM_STATS stats;
+    CHECKPOINT cp;
+    if (resume) {
+        if (pipeline_stream_resume(cfg, &cp) != 0)
+            return 1;
+        fprintf(stderr, "Resuming: %llu phrases, %llu hits done, %zu ranges left\n",
+                (unsigned long long)cp.phrases, (unsigned long long)cp.hits, cp.nranges);
+        cfg->resume = &cp;
     }
-
-    // 自动拼接所有参数为一个密码短语
-    char password_phrase[1024] = {0};  // 根据需要调整缓冲区大小
-    int offset = 0;
-    for (int i = 1; i < argc; i++) {
-        // 如果不是最后一个参数，在后面加上空格
-        snprintf(password_phrase + offset, sizeof(password_phrase) - offset, "%s%s", 
-                 argv[i], (i < argc - 1 ? " " : ""));
-        offset = strlen(password_phrase);
+    int ret = pipeline_run_stream(cfg, &stats);
+    fflush(stdout);
+    if (ret != 0)
+        fprintf(stderr, "Error: 批量处理失败（读写错误或内存不足）\n");
+    fprintf(stderr, "Phrases: %llu, batches: %llu, threads: %d, stolen batches: %llu\n",
+            (unsigned long long)stats.phrases, (unsigned long long)stats.batches,
+            stats.threads, (unsigned long long)stats.steals);
+    if (cfg->targets != NULL)
+        fprintf(stderr, "Target hits: %llu\n", (unsigned long long)stats.hits);
+    if (resume) {
+        fprintf(stderr, "Total phrases: %llu, total target hits: %llu\n",
+                (unsigned long long)(cp.phrases + stats.phrases), (unsigned long long)(cp.hits + stats.hits));
+        checkpoint_free(&cp);
     }
+    return ret != 0;
+}
 
-    // 使用拼接后的密码短语计算 SHA256 得到私钥
-    uint8_t phrase_hash[32];
-    sha256((const uint8_t*)password_phrase, strlen(password_phrase), phrase_hash);
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [--iterations N] <Password Phrase>\n", prog);
+    fprintf(stderr, "       %s [--iterations N] --candidates <File>\n", prog);
+    fprintf(stderr, "       %s [--iterations N] [--rules <File>] [--targets <File>] [--outputs LIST | --format F] --stdin | --input <File>\n", prog);
+    fprintf(stderr, "       %s [--iterations N] [--rules <File>] [--targets <File>] [--outputs LIST | --format F] --combine <DictA> <DictB> [<DictC>] [--sep S]\n", prog);
+    fprintf(stderr, "  --iterations N     私钥 = SHA256 连续应用 N 次（默认 1）\n");
+    fprintf(stderr, "  --candidates File  按前缀排序处理文件中的每行短语\n");
+    fprintf(stderr, "  --stdin            批量模式：从标准输入逐行读取短语，每条输出一行记录\n");
+    fprintf(stderr, "  --input File       批量模式：从文件逐行读取短语\n");
+    fprintf(stderr, "  --combine A B [C]  批量模式：枚举各词表各取一词组成的全部短语（最后一个词表变化最快）\n");
+    fprintf(stderr, "  --sep S            --combine 的词间分隔符（默认为一个空格）\n");
+    fprintf(stderr, "  --checkpoint File  批量模式定期把进度（剩余输入区间、累计计数）原子地写入状态文件\n");
+    fprintf(stderr, "  --checkpoint-every S  检查点间隔秒数（默认 60）\n");
+    fprintf(stderr, "  --resume           从 --checkpoint 文件记录的位置继续，输出应追加到原输出文件\n");
+    fprintf(stderr, "  --shard i/N        批量模式只处理 N 个分片中的第 i 个（0 <= i < N），各分片互不重叠\n");
+    fprintf(stderr, "  --shard-by M       分片方式：range（按字节或组合序号均分为连续段，映射文件与 --combine 的默认）、\n");
+    fprintf(stderr, "                     hash（按短语哈希，--stdin 等逐行输入只能用此方式）\n");
+    fprintf(stderr, "  --threads N        批量模式的工作线程数（默认为 CPU 核数）\n");
+    fprintf(stderr, "  --unordered        批量模式按完成顺序输出（默认按输入顺序）\n");
+    fprintf(stderr, "  --targets File     批量模式只输出 hash160 命中目标集合（loadtargets 生成）的短语\n");
+    fprintf(stderr, "  --rules File       批量模式对每个输入词应用规则文件中的每条规则（hashcat 规则子集）\n");
+    fprintf(stderr, "  --outputs LIST     批量模式只计算并输出指定的列，逗号分隔，例如 wif-c,p2pkh-c,p2wpkh-c\n");
+    fprintf(stderr, "                     可用：priv、wif、pub、hash160 及各地址类型（P2PKH、P2SH、P2SH-P2WPKH、\n");
+    fprintf(stderr, "                     BECH32/P2WPKH、BECH32M、P2WSH、P2WSH-P2WPKH），加 -c/-u 只取压缩/非压缩\n");
+    fprintf(stderr, "  --format F         批量模式输出格式：text（默认）、bin（定长二进制记录，含短语偏移）、\n");
+    fprintf(stderr, "                     bin-nooffset（不含偏移）；二进制记录可用 keydump 还原为文本\n");
+}
 
-    char priv_hex[65] = {0};
-    for (int i = 0; i < 32; i++) {
-        sprintf(priv_hex + i * 2, "%02x", phrase_hash[i]);
+int main(int argc, char **argv) {
+    uint64_t iterations = 1;
+    const char *candidates = NULL;
+    const char *input = NULL;
+    const char *targets_path = NULL;
+    const char *rules_path = NULL;
+    const char *combine_paths[COMBINE_MAX_DICTS];
+    size_t combine_count = 0;
+    const char *sep = NULL;
+    const char *checkpoint_path = NULL;
+    unsigned checkpoint_interval = 60;
+    bool resume = false;
+    unsigned shard_index = 0, shard_count = 1;
+    const char *shard_by = NULL;
+    PIPELINE_FORMAT format = PIPELINE_FORMAT_TEXT;
+    unsigned bin_flags = 0;
+    PIPELINE_PLAN plan;
+    bool has_plan = false;
+    bool use_stdin = false;
+    bool ordered = true;
+    int threads = 0;
+    int argi = 1;
+    while (argi < argc && strncmp(argv[argi], "--", 2) == 0) {
+        if (strcmp(argv[argi], "--") == 0) {
+            argi++;
+            break;
+        } else if (strcmp(argv[argi], "--candidates") == 0 && argi + 1 < argc) {
+            candidates = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--stdin") == 0) {
+            use_stdin = true;
+            argi++;
+        } else if (strcmp(argv[argi], "--unordered") == 0) {
+            ordered = false;
+            argi++;
+        } else if (strcmp(argv[argi], "--threads") == 0 && argi + 1 < argc) {
+            char *end = NULL;
+            long n = strtol(argv[argi + 1], &end, 10);
+            if (*end != '\0' || n < 1 || n > 4096) {
+                fprintf(stderr, "Error: 无效的线程数 %s\n", argv[argi + 1]);
+                return 1;
+            }
+            threads = (int)n;
+            argi += 2;
+        } else if (strcmp(argv[argi], "--outputs") == 0 && argi + 1 < argc) {
+            const char *bad = NULL;
+            if (pipeline_plan_parse(argv[argi + 1], &plan, &bad) != 0) {
+                fprintf(stderr, "Error: 无效的输出列 %.*s\n", (int)strcspn(bad, ","), bad);
+                return 1;
+            }
+            has_plan = true;
+            argi += 2;
+        } else if (strcmp(argv[argi], "--format") == 0 && argi + 1 < argc) {
+            const char *name = argv[argi + 1];
+            if (strcmp(name, "text") == 0) {
+                format = PIPELINE_FORMAT_TEXT;
+            } else if (strcmp(name, "bin") == 0) {
+                format = PIPELINE_FORMAT_BIN;
+                bin_flags = PIPELINE_BIN_OFFSETS;
+            } else if (strcmp(name, "bin-nooffset") == 0) {
+                format = PIPELINE_FORMAT_BIN;
+                bin_flags = 0;
+            } else {
+                fprintf(stderr, "Error: 未知的输出格式 %s\n", name);
+                return 1;
+            }
+            argi += 2;
+        } else if (strcmp(argv[argi], "--combine") == 0) {
+            /* 之后不以 -- 开头的参数都是词表 */
+            argi++;
+            combine_count = 0;
+            while (argi < argc && strncmp(argv[argi], "--", 2) != 0) {
+                if (combine_count == COMBINE_MAX_DICTS) {
+                    fprintf(stderr, "Error: --combine 最多 %d 个词表\n", COMBINE_MAX_DICTS);
+                    return 1;
+                }
+                combine_paths[combine_count++] = argv[argi++];
+            }
+            if (combine_count < 2) {
+                fprintf(stderr, "Error: --combine 至少需要 2 个词表\n");
+                return 1;
+            }
+        } else if (strcmp(argv[argi], "--sep") == 0 && argi + 1 < argc) {
+            sep = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--checkpoint") == 0 && argi + 1 < argc) {
+            checkpoint_path = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--checkpoint-every") == 0 && argi + 1 < argc) {
+            char *end = NULL;
+            unsigned long n = strtoul(argv[argi + 1], &end, 10);
+            if (*end != '\0' || n > 86400) {
+                fprintf(stderr, "Error: 无效的检查点间隔 %s\n", argv[argi + 1]);
+                return 1;
+            }
+            checkpoint_interval = (unsigned)n;
+            argi += 2;
+        } else if (strcmp(argv[argi], "--shard") == 0 && argi + 1 < argc) {
+            if (pipeline_shard_parse(argv[argi + 1], &shard_index, &shard_count) != 0) {
+                fprintf(stderr, "Error: 无效的分片 %s，应为 i/N 且 0 <= i < N\n", argv[argi + 1]);
+                return 1;
+            }
+            argi += 2;
+        } else if (strcmp(argv[argi], "--shard-by") == 0 && argi + 1 < argc) {
+            shard_by = argv[argi + 1];
+            if (strcmp(shard_by, "range") != 0 && strcmp(shard_by, "hash") != 0) {
+                fprintf(stderr, "Error: 未知的分片方式 %s\n", shard_by);
+                return 1;
+            }
+            argi += 2;
+        } else if (strcmp(argv[argi], "--resume") == 0) {
+            resume = true;
+            argi++;
+        } else if (strcmp(argv[argi], "--rules") == 0 && argi + 1 < argc) {
+            rules_path = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--targets") == 0 && argi + 1 < argc) {
+            targets_path = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--input") == 0 && argi + 1 < argc) {
+            input = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--iterations") == 0 && argi + 1 < argc) {
+            char *end = NULL;
+            iterations = strtoull(argv[argi + 1], &end, 10);
+            if (*end != '\0' || iterations == 0) {
+                fprintf(stderr, "Error: 无效的迭代次数 %s\n", argv[argi + 1]);
+                return 1;
+            }
+            argi += 2;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
     }
-    priv_hex[64] = '\0';
-
-    printf("Password Phrase: %s\n", password_phrase);
-    printf("SHA256 Hash (passphrase Hex): %s\n", priv_hex);
-    
-
-    /* 将私钥转换为 WIF 格式（压缩和非压缩） */
-    char wif_compressed[100] = {0};
-    char wif_uncompressed[100] = {0};
-
-    if (private_key_to_wif(priv_hex, true, wif_compressed, sizeof(wif_compressed)) != 0) {
-        fprintf(stderr, "私钥转换为压缩 WIF 失败\n");
+    /* 短语参数、--candidates、--stdin、--input、--combine 只能选一 */
+    int sources = (candidates != NULL) + (input != NULL) + use_stdin + (combine_count > 0) + (argi < argc);
+    bool batch_mode = input != NULL || use_stdin || combine_count > 0;
+    if (sources != 1 || (sep != NULL && combine_count == 0) || (resume && checkpoint_path == NULL) ||
+        (!batch_mode && (targets_path != NULL || rules_path != NULL || checkpoint_path != NULL || has_plan ||
+                         shard_count > 1 || shard_by != NULL || format != PIPELINE_FORMAT_TEXT)) ||
+        (has_plan && format != PIPELINE_FORMAT_TEXT)) {
+        print_usage(argv[0]);
         return 1;
     }
-    if (private_key_to_wif(priv_hex, false, wif_uncompressed, sizeof(wif_uncompressed)) != 0) {
-        fprintf(stderr, "私钥转换为非压缩 WIF 失败\n");
+    /* 二进制记录的偏移只能指回输入词表中的行，无法还原变换后的候选或生成的组合 */
+    if ((rules_path != NULL || combine_count > 0) && format == PIPELINE_FORMAT_BIN && (bin_flags & PIPELINE_BIN_OFFSETS)) {
+        fprintf(stderr, "Error: %s 不能与 --format bin 同时使用，请改用 bin-nooffset\n",
+                rules_path != NULL ? "--rules" : "--combine");
         return 1;
     }
 
-    printf("WIF Private Key (Compressed): %s\n", wif_compressed);
-    printf("WIF Private Key (Uncompressed): %s\n", wif_uncompressed);
-
-    /* 初始化 secp256k1 参数 */
-    EllipticCurve EC;
-    Point G;
-    mpz_inits(EC.p, EC.a, EC.b, EC.n, NULL);
-    mpz_set_str(EC.p, EC_constant_P, 16);
-    mpz_set_ui(EC.a, 0);    // secp256k1: a = 0
-    mpz_set_ui(EC.b, 7);    // secp256k1: b = 7
-    mpz_set_str(EC.n, EC_constant_N, 16);
-
-    point_init(&G);
-    mpz_set_str(G.x, EC_constant_Gx, 16);
-    mpz_set_str(G.y, EC_constant_Gy, 16);
-    G.infinity = 0;
-
-    /* 由私钥计算公钥 */
-    mpz_t priv;
-    mpz_init_set_str(priv, priv_hex, 16);
-    Point pub;
-    point_init(&pub);
-    /* 调用标量乘法： pub = priv * G */
-    scalar_multiplication(&EC, &G, &pub, priv);
-    
-    char pub_hex_comp[67] = {0};
-    char pub_hex_uncomp[131] = {0};
-    /* 生成公钥字符串（由 customutil 模块提供） */
-    generate_strpublickey(&pub, true, pub_hex_comp);    // 生成压缩格式
-    generate_strpublickey(&pub, false, pub_hex_uncomp);   // 生成非压缩格式
-    printf("\nCompressed Public Key: %s\n", pub_hex_comp);
-    printf("Uncompressed Public Key: %s\n", pub_hex_uncomp);
+    RULE_SET rules;
+    if (rules_path != NULL && rules_load(rules_path, &rules) != 0)
+        return 1;
 
-    /* 计算并显示公钥 hash160 值 */
-    {
-        uint8_t pub_comp_bin[33] = {0};
-        if (hex2bin(pub_hex_comp, pub_comp_bin, 33) != 0) {
-            fprintf(stderr, "Error: 无法转换压缩公钥\n");
+    /* 目标集合：mmap 的排序记录 + 内存中的 Bloom 过滤器 */
+    TARGET_SET target_set;
+    TARGET_INDEX target_index;
+    if (targets_path != NULL) {
+        if (targets_open(targets_path, &target_set) != 0)
             return 1;
-        }
-        uint8_t pub_comp_hash160[20] = {0};
-        hash160(pub_comp_bin, 33, pub_comp_hash160);
-        char pub_comp_hash160_hex[41] = {0};
-        for (int i = 0; i < 20; i++) {
-            sprintf(pub_comp_hash160_hex + i * 2, "%02x", pub_comp_hash160[i]);
-        }
-        printf("Compressed Public Key Hash160: %s\n", pub_comp_hash160_hex);
-    }
-    
-    {
-        uint8_t pub_uncomp_bin[65] = {0};
-        if (hex2bin(pub_hex_uncomp, pub_uncomp_bin, 65) != 0) {
-            fprintf(stderr, "Error: 无法转换非压缩公钥\n");
+        if (target_index_build(&target_index, &target_set) != 0) {
+            fprintf(stderr, "Error: 内存不足，无法建立目标索引\n");
+            targets_close(&target_set);
             return 1;
         }
-        uint8_t pub_uncomp_hash160[20] = {0};
-        hash160(pub_uncomp_bin, 65, pub_uncomp_hash160);
-        char pub_uncomp_hash160_hex[41] = {0};
-        for (int i = 0; i < 20; i++) {
-            sprintf(pub_uncomp_hash160_hex + i * 2, "%02x", pub_uncomp_hash160[i]);
-        }
-        printf("Uncompressed Public Key Hash160: %s\n", pub_uncomp_hash160_hex);
+        fprintf(stderr, "Targets: %llu hash160s\n", (unsigned long long)target_index.count);
+        if (target_set.count > target_index.count)
+            fprintf(stderr, "Warning: 忽略 %llu 条无法匹配的 32 字节程序（P2WSH、Taproot 等）\n",
+                    (unsigned long long)(target_set.count - target_index.count));
     }
 
-    printf("\n=== Addresses Generated from Compressed Public Key ===\n");
-    char *p2pkh_address_compressed = public_key_to_address(pub_hex_comp, "P2PKH");
-    if (p2pkh_address_compressed != NULL) {
-        printf("P2PKH (Starts with 1) Address (Compressed): %s\n", p2pkh_address_compressed);
-        free(p2pkh_address_compressed);
-    }
-
-    char *p2sh_address_compressed = public_key_to_address(pub_hex_comp, "P2SH");
-    if (p2sh_address_compressed != NULL) {
-        printf("P2SH (Starts with 3) Address (Compressed): %s (P2SH => P2PKH)\n", p2sh_address_compressed);
-        free(p2sh_address_compressed);
-    }
-    
-    char *p2sh_p2wpkh_address_compressed = public_key_to_address(pub_hex_comp, "P2SH-P2WPKH");
-    if (p2sh_p2wpkh_address_compressed != NULL) {
-        printf("P2SH (Starts with 3) Address (Compressed): %s (P2SH => P2WPKH)\n", p2sh_p2wpkh_address_compressed);
-        free(p2sh_p2wpkh_address_compressed);
-    }
-
-    char *bech32_address_compressed = public_key_to_address(pub_hex_comp, "BECH32");
-    if (bech32_address_compressed != NULL) {
-        printf("Bech32 (Starts with bc1) Address (Compressed): %s\n", bech32_address_compressed);
-        free(bech32_address_compressed);
-    }
-
-    char *bech32m_address_compressed = public_key_to_address(pub_hex_comp, "BECH32M");
-    if (bech32m_address_compressed != NULL) {
-        printf("Bech32m (Starts with bc1p) Address (Compressed): %s\n", bech32m_address_compressed);
-        free(bech32m_address_compressed);
-    }
-
-    char *p2wsh_address_compressed = public_key_to_address(pub_hex_comp, "P2WSH");
-    if (p2wsh_address_compressed != NULL) {
-        printf("P2WSH (Starts with bc1) Address (Compressed): %s (P2WSH => P2PKH)\n", p2wsh_address_compressed);
-        free(p2wsh_address_compressed);
-    }
-     
-    char *p2wsh_p2wpkh_address_compressed = public_key_to_address(pub_hex_comp, "P2WSH-P2WPKH");
-    if (p2wsh_p2wpkh_address_compressed != NULL) {
-        printf("P2WSH (Starts with bc1) Address (Compressed): %s (P2WSH => P2WPKH)\n", p2wsh_p2wpkh_address_compressed);
-        free(p2wsh_p2wpkh_address_compressed);
+    /* 组合词表与普通文件直接映射；管道等不能映射的输入退回逐行读取 */
+    FILE *in = use_stdin ? stdin : NULL;
+    WORDLIST wl;
+    bool mapped = false;
+    COMBINATOR comb;
+    bool input_failed = false;
+    if (combine_count > 0) {
+        if (combinator_open(&comb, combine_paths, combine_count, sep != NULL ? sep : " ") != 0)
+            input_failed = true;
+        else
+            fprintf(stderr, "Combinations: %llu\n", (unsigned long long)comb.total);
+    } else if (input != NULL) {
+        if (wordlist_open(&wl, input) == 0) {
+            mapped = true;
+        } else if (errno == ESPIPE) {
+            in = fopen(input, "r");
+        }
+        if (!mapped && in == NULL) {
+            fprintf(stderr, "Error: 无法打开输入文件 %s\n", input);
+            input_failed = true;
+        }
     }
-
-    printf("\n=== Addresses Generated from Uncompressed Public Key ===\n");
-    char *p2pkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2PKH");
-    if (p2pkh_address_uncompressed != NULL) {
-        printf("P2PKH (Starts with 1) Address (Uncompressed): %s\n", p2pkh_address_uncompressed);
-        free(p2pkh_address_uncompressed);
+    /* 按范围分片需要知道输入大小：逐行读取的流只能按哈希分片 */
+    PIPELINE_SHARD_MODE shard_mode = mapped || combine_count > 0 ? PIPELINE_SHARD_RANGE : PIPELINE_SHARD_HASH;
+    if (shard_by != NULL)
+        shard_mode = strcmp(shard_by, "hash") == 0 ? PIPELINE_SHARD_HASH : PIPELINE_SHARD_RANGE;
+    if (shard_count > 1 && shard_mode == PIPELINE_SHARD_RANGE && !input_failed && !mapped && combine_count == 0) {
+        fprintf(stderr, "Error: 逐行读取的输入不能按范围分片，请使用 --shard-by hash\n");
+        input_failed = true;
     }
-
-    char *p2sh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2SH");
-    if (p2sh_address_uncompressed != NULL) {
-        printf("P2SH (Starts with 3) Address (Uncompressed): %s (P2SH => P2PKH)\n", p2sh_address_uncompressed);
-        free(p2sh_address_uncompressed);
+    if (input_failed) {
+        if (in != NULL && in != stdin)
+            fclose(in);
+        if (targets_path != NULL) {
+            target_index_free(&target_index);
+            targets_close(&target_set);
+        }
+        if (rules_path != NULL)
+            rules_free(&rules);
+        return 1;
     }
 
-    char *p2sh_p2wpkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2SH-P2WPKH");
-    if (p2sh_p2wpkh_address_uncompressed != NULL) {
-        printf("P2SH (Starts with 3) Address (Uncompressed): %s (P2SH => P2WPKH)\n", p2sh_p2wpkh_address_uncompressed);
-        free(p2sh_p2wpkh_address_uncompressed);
-    }
-    
-    char *bech32_address_uncompressed = public_key_to_address(pub_hex_uncomp, "BECH32");
-    if (bech32_address_uncompressed != NULL) {
-        printf("Bech32 (Starts with bc1) Address (Uncompressed): %s\n", bech32_address_uncompressed);
-        free(bech32_address_uncompressed);
-    }
+    /* 初始化 secp256k1 参数 */
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+
+    int ret;
+    if (candidates != NULL) {
+        ret = run_candidates(&ctx, candidates, iterations);
+    } else if (in != NULL || mapped || combine_count > 0) {
+        PIPELINE_STREAM_CONFIG cfg = {
+            .ctx = &ctx,
+            .iterations = iterations,
+            .threads = threads,
+            .ordered = ordered,
+            .in = in,
+            .out = stdout,
+            .wordlist = mapped ? &wl : NULL,
+            .targets = targets_path != NULL ? &target_index : NULL,
+            .format = format,
+            .bin_flags = bin_flags,
+            .plan = has_plan ? &plan : NULL,
+            .rules = rules_path != NULL ? &rules : NULL,
+            .combinator = combine_count > 0 ? &comb : NULL,
+            .checkpoint = checkpoint_path,
+            .checkpoint_interval = checkpoint_interval,
+            .shard_mode = shard_mode,
+            .shard_index = shard_index,
+            .shard_count = shard_count,
+        };
+        ret = run_stream(&cfg, resume);
+        if (combine_count > 0)
+            combinator_close(&comb);
+        else if (mapped)
+            wordlist_close(&wl);
+        else if (in != stdin)
+            fclose(in);
+    } else {
+        // 自动拼接所有参数为一个密码短语
+        char password_phrase[1024] = {0};  // 根据需要调整缓冲区大小
+        int offset = 0;
+        for (int i = argi; i < argc; i++) {
+            // 如果不是最后一个参数，在后面加上空格
+            snprintf(password_phrase + offset, sizeof(password_phrase) - offset, "%s%s", 
+                     argv[i], (i < argc - 1 ? " " : ""));
+            offset = strlen(password_phrase);
+        }
 
-    char *bech32m_address_uncompressed = public_key_to_address(pub_hex_uncomp, "BECH32M");
-    if (bech32m_address_uncompressed != NULL) {
-        printf("Bech32m (Starts with bc1p) Address (Uncompressed): %s\n", bech32m_address_uncompressed);
-        free(bech32m_address_uncompressed);
-    }
-    
-    char *p2wsh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2WSH");
-    if (p2wsh_address_uncompressed != NULL) {
-        printf("P2WSH (Starts with bc1) Address (Uncompressed): %s (P2WSH => P2PKH)\n", p2wsh_address_uncompressed);
-        free(p2wsh_address_uncompressed);
-    }
-    
-    char *p2wsh_p2wpkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2WSH-P2WPKH");
-    if (p2wsh_p2wpkh_address_uncompressed != NULL) {
-        printf("P2WSH (Starts with bc1) Address (Uncompressed): %s (P2WSH => P2WPKH)\n", p2wsh_p2wpkh_address_uncompressed);
-        free(p2wsh_p2wpkh_address_uncompressed);
+        // 使用拼接后的密码短语计算 SHA256 得到私钥
+        uint8_t phrase_hash[32];
+        sha256((const uint8_t*)password_phrase, strlen(password_phrase), phrase_hash);
+        if (iterations > 1)
+            sha256_iterate(phrase_hash, iterations - 1, phrase_hash);
+        ret = report_phrase(&ctx, password_phrase, phrase_hash, iterations);
     }
 
     /* 释放 GMP 与 ECC 资源 */
-    mpz_clear(priv);
-    point_clear(&pub);
-    point_clear(&G);
-    mpz_clear(EC.p);
-    mpz_clear(EC.a);
-    mpz_clear(EC.b);
-    mpz_clear(EC.n);
+    bw_ctx_free(&ctx);
+    if (targets_path != NULL) {
+        target_index_free(&target_index);
+        targets_close(&target_set);
+    }
+    if (rules_path != NULL)
+        rules_free(&rules);
     
-    return 0;
+    return ret;
 }
-
@@ -0,0 +1,102 @@
+/*
+ * address.c
+ *
+ * 由二进制公钥生成本工具输出的全部地址类型。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include "address.h"
+
+#include "../sha256/sha256.h"
+#include "../hash160/hash160.h"
+#include "../base58/base58.h"
+#include "../bech32/bech32.h"
+
+static const char *ADDRESS_NAMES[ADDRESS_TYPE_COUNT] = {
+    "P2PKH", "P2SH", "P2SH-P2WPKH", "BECH32", "BECH32M", "P2WSH", "P2WSH-P2WPKH"
+};
+
+/* base58check(version, hash20)，不分配内存 */
+static void base58check_20(uint8_t version, const uint8_t hash20[20], char *out) {
+    uint8_t payload[25], hash1[32], hash2[32];
+    payload[0] = version;
+    memcpy(payload + 1, hash20, 20);
+    sha256(payload, 21, hash1);
+    sha256(hash1, 32, hash2);
+    memcpy(payload + 21, hash2, 4);
+    b58enc_25(out, payload);
+}
+
+int address_from_pubkey(const uint8_t *pubkey, size_t pubkey_len, const uint8_t *pubkey_hash160,
+                        unsigned types, ADDRESS_SET *set) {
+    set->types = 0;
+    if (pubkey_hash160 != NULL)
+        memcpy(set->hash160, pubkey_hash160, 20);
+    else if (types & ADDRESS_NEEDS_HASH160)
+        hash160_pubkeys(pubkey, pubkey_len, 1, set->hash160);
+    else
+        memset(set->hash160, 0, 20);
+
+    if (types & ADDRESS_P2PKH)
+        base58check_20(0x00, set->hash160, ADDRESS_GET(set, ADDRESS_P2PKH));
+    if (types & ADDRESS_P2SH)
+        base58check_20(0x05, set->hash160, ADDRESS_GET(set, ADDRESS_P2SH));
+    if ((types & ADDRESS_BECH32) &&
+        segwit_addr_encode(ADDRESS_GET(set, ADDRESS_BECH32), "bc", 0, set->hash160, 20) != 1)
+        return -1;
+    if ((types & ADDRESS_BECH32M) &&
+        segwit_addr_encode(ADDRESS_GET(set, ADDRESS_BECH32M), "bc", 1, set->hash160, 20) != 1)
+        return -1;
+    if (types & ADDRESS_P2WSH) {
+        uint8_t sha[32];
+        sha256(pubkey, pubkey_len, sha);
+        if (segwit_addr_encode(ADDRESS_GET(set, ADDRESS_P2WSH), "bc", 0, sha, 32) != 1)
+            return -1;
+    }
+
+    /* P2WPKH 赎回脚本 0x0014<hash160>，两种嵌套地址共用 */
+    if (types & (ADDRESS_P2SH_P2WPKH | ADDRESS_P2WSH_P2WPKH)) {
+        uint8_t redeem_script[22] = {0x00, 0x14};
+        memcpy(redeem_script + 2, set->hash160, 20);
+        if (types & ADDRESS_P2SH_P2WPKH) {
+            uint8_t redeem_hash160[20];
+            hash160_pubkeys(redeem_script, sizeof(redeem_script), 1, redeem_hash160);
+            base58check_20(0x05, redeem_hash160, ADDRESS_GET(set, ADDRESS_P2SH_P2WPKH));
+        }
+        if (types & ADDRESS_P2WSH_P2WPKH) {
+            uint8_t sha[32];
+            sha256(redeem_script, 22, sha);
+            if (segwit_addr_encode(ADDRESS_GET(set, ADDRESS_P2WSH_P2WPKH), "bc", 0, sha, 32) != 1)
+                return -1;
+        }
+    }
+    set->types = types & ADDRESS_ALL;
+    return 0;
+}
+
+void address_print(const ADDRESS_SET *set, const char *label) {
+    printf("P2PKH (Starts with 1) Address (%s): %s\n", label, ADDRESS_GET(set, ADDRESS_P2PKH));
+    printf("P2SH (Starts with 3) Address (%s): %s (P2SH => P2PKH)\n", label, ADDRESS_GET(set, ADDRESS_P2SH));
+    printf("P2SH (Starts with 3) Address (%s): %s (P2SH => P2WPKH)\n", label, ADDRESS_GET(set, ADDRESS_P2SH_P2WPKH));
+    printf("Bech32 (Starts with bc1) Address (%s): %s\n", label, ADDRESS_GET(set, ADDRESS_BECH32));
+    printf("Bech32m (Starts with bc1p) Address (%s): %s\n", label, ADDRESS_GET(set, ADDRESS_BECH32M));
+    printf("P2WSH (Starts with bc1) Address (%s): %s (P2WSH => P2PKH)\n", label, ADDRESS_GET(set, ADDRESS_P2WSH));
+    printf("P2WSH (Starts with bc1) Address (%s): %s (P2WSH => P2WPKH)\n", label, ADDRESS_GET(set, ADDRESS_P2WSH_P2WPKH));
+}
+
+const char *address_type_name(ADDRESS_TYPE type) {
+    if (type == 0 || (type & (type - 1)) != 0 || (type & ~ADDRESS_ALL) != 0)
+        return NULL;
+    return ADDRESS_NAMES[__builtin_ctz(type)];
+}
+
+ADDRESS_TYPE address_type_from_name(const char *name) {
+    for (int i = 0; i < ADDRESS_TYPE_COUNT; i++) {
+        if (strcasecmp(name, ADDRESS_NAMES[i]) == 0)
+            return (ADDRESS_TYPE)(1 << i);
+    }
+    return (ADDRESS_TYPE)0;
+}
@@ -0,0 +1,74 @@
+/*
+ * address.h
+ *
+ * 由二进制公钥生成本工具输出的全部地址类型。每个公钥的 hash160、
+ * 赎回脚本 0x0014<hash160> 及其哈希只计算一次，结果写入调用者提供的结构体，
+ * 不分配内存。
+ */
+
+#ifndef ADDRESS_H
+#define ADDRESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 地址类型，可按位或组合 */
+typedef enum address_type {
+    ADDRESS_P2PKH        = 1 << 0,  /* 1...，base58check(0x00, hash160(pubkey)) */
+    ADDRESS_P2SH         = 1 << 1,  /* 3...，base58check(0x05, hash160(pubkey)) */
+    ADDRESS_P2SH_P2WPKH  = 1 << 2,  /* 3...，base58check(0x05, hash160(0x0014<hash160>)) */
+    ADDRESS_BECH32       = 1 << 3,  /* bc1q...，witness v0，hash160(pubkey) */
+    ADDRESS_BECH32M      = 1 << 4,  /* bc1p...，witness v1，hash160(pubkey)（Bech32 校验常数） */
+    ADDRESS_P2WSH        = 1 << 5,  /* bc1q...，witness v0，sha256(pubkey) */
+    ADDRESS_P2WSH_P2WPKH = 1 << 6,  /* bc1q...，witness v0，sha256(0x0014<hash160>) */
+    ADDRESS_ALL          = (1 << 7) - 1
+} ADDRESS_TYPE;
+
+/* 需要公钥 hash160 的类型（P2WSH 只用公钥本身） */
+#define ADDRESS_NEEDS_HASH160 (ADDRESS_ALL & ~ADDRESS_P2WSH)
+
+#define ADDRESS_TYPE_COUNT 7
+#define ADDRESS_MAX_LEN    62   /* 最长为 32 字节程序的 bech32 地址 */
+
+/* 按类型取 ADDRESS_SET 中的地址字符串，type 为单个 ADDRESS_TYPE */
+#define ADDRESS_GET(set, type) ((set)->addr[__builtin_ctz(type)])
+
+typedef struct address_set {
+    uint8_t hash160[20];                                /* 公钥的 hash160 */
+    unsigned types;                                     /* 已生成的类型 */
+    char addr[ADDRESS_TYPE_COUNT][ADDRESS_MAX_LEN + 2]; /* 以类型位序号为下标 */
+} ADDRESS_SET;
+
+/**
+ * address_from_pubkey - 生成公钥对应的地址
+ *
+ * @pubkey: 序列化公钥（33 字节压缩或 65 字节非压缩）
+ * @pubkey_len: 公钥长度
+ * @pubkey_hash160: 已算好的公钥 hash160，为 NULL 时在函数内计算
+ *                  （types 不含 ADDRESS_NEEDS_HASH160 中的类型时不计算，set->hash160 置零）
+ * @types: 需要生成的地址类型（ADDRESS_TYPE 按位或）
+ * @set: 输出结构体
+ *
+ * 成功返回 0，编码失败返回 -1。
+ */
+int address_from_pubkey(const uint8_t *pubkey, size_t pubkey_len, const uint8_t *pubkey_hash160,
+                        unsigned types, ADDRESS_SET *set);
+
+/* 按固定顺序把 set 中的全部地址打印到 stdout（Brain 与 key 的单条报告），label 为 "Compressed" 或 "Uncompressed" */
+void address_print(const ADDRESS_SET *set, const char *label);
+
+/* 类型名称，与旧接口 public_key_to_address 的类型字符串一致，例如 "P2SH-P2WPKH" */
+const char *address_type_name(ADDRESS_TYPE type);
+
+/* 由名称查找类型（不区分大小写），未知名称返回 0 */
+ADDRESS_TYPE address_type_from_name(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADDRESS_H */
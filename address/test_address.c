@@ -0,0 +1,96 @@
+// gcc -O2 -o test_address test_address.c address.c ../sha256/sha256.c ../sha256/sha256_simd.c ../ripemd160/ripemd160.c ../ripemd160/ripemd160_simd.c ../hash160/hash160.c ../base58/base58.c ../bech32/bech32.c
+// ./test_address
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "address.h"
+
+/* 私钥 1 对应的压缩公钥（生成元 G） */
+static const uint8_t G_COMPRESSED[33] = {
+    0x02, 0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b,
+    0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17,
+    0x98
+};
+
+/* 与 key 1 的输出一致，按类型位序号排列 */
+static const char *G_ADDRESSES[ADDRESS_TYPE_COUNT] = {
+    "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH",
+    "3CNHUhP3uyB9EUtRLsmvFUmvGdjGdkTxJw",
+    "3JvL6Ymt8MVWiCNHC7oWU6nLeHNJKLZGLN",
+    "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4",
+    "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7k8e76x7",
+    "bc1qpac4ht6afshdx2tctnhjnetz7u6g3j9zhwwmc4cqkdsa2jumq42qd3drf7",
+    "bc1q3qu0094lf9ctzjrhnszmwjuvf9g4kv3dqsp47la2tkdjxawlywtqs5vvrc"
+};
+
+static int check_set(const ADDRESS_SET *set, unsigned types, const char *what) {
+    int failed = 0;
+    if (set->types != types) {
+        printf("  FAIL %s: types %#x, expected %#x\n", what, set->types, types);
+        return 1;
+    }
+    for (int i = 0; i < ADDRESS_TYPE_COUNT; i++) {
+        if (!(types & (1u << i)))
+            continue;
+        if (strcmp(set->addr[i], G_ADDRESSES[i]) != 0) {
+            printf("  FAIL %s %s: %s\n", what, address_type_name((ADDRESS_TYPE)(1 << i)), set->addr[i]);
+            failed = 1;
+        }
+    }
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+    ADDRESS_SET set;
+
+    printf("Testing all address types of the generator point...\n");
+    if (address_from_pubkey(G_COMPRESSED, 33, NULL, ADDRESS_ALL, &set) != 0) {
+        printf("  FAIL address_from_pubkey\n");
+        failed = 1;
+    } else {
+        failed |= check_set(&set, ADDRESS_ALL, "all");
+    }
+
+    printf("Testing precomputed hash160 and type subsets...\n");
+    uint8_t h160[20];
+    memcpy(h160, set.hash160, 20);
+    for (unsigned types = 1; types <= ADDRESS_ALL; types += 5) {
+        ADDRESS_SET subset;
+        memset(&subset, 0, sizeof(subset));
+        if (address_from_pubkey(G_COMPRESSED, 33, (types & 1) ? h160 : NULL, types, &subset) != 0) {
+            printf("  FAIL address_from_pubkey types %#x\n", types);
+            failed = 1;
+            continue;
+        }
+        failed |= check_set(&subset, types, "subset");
+        if (memcmp(subset.hash160, h160, 20) != 0) {
+            printf("  FAIL hash160 types %#x\n", types);
+            failed = 1;
+        }
+    }
+
+    printf("Testing type names...\n");
+    for (int i = 0; i < ADDRESS_TYPE_COUNT; i++) {
+        ADDRESS_TYPE type = (ADDRESS_TYPE)(1 << i);
+        if (address_type_from_name(address_type_name(type)) != type) {
+            printf("  FAIL name round trip %d\n", i);
+            failed = 1;
+        }
+    }
+    if (address_type_from_name("p2sh-p2wpkh") != ADDRESS_P2SH_P2WPKH ||
+        address_type_from_name("P2TR") != 0 ||
+        address_type_name(ADDRESS_P2PKH | ADDRESS_P2SH) != NULL) {
+        printf("  FAIL name lookup\n");
+        failed = 1;
+    }
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
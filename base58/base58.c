@@ -82,67 +82,250 @@ static char *base58_encode(const uint8_t *data, size_t data_len) {
 }
 
 /*
- * 内部函数：base58_decode
+ * 定长编码：先把输入按大端 32 位分组，用 64 位运算以 58^5 为基数做
+ * Horner 累加（每次除以常数 58^5，编译器会转为乘法），最后再把每个
+ * 58^5 分组拆成 5 个 Base58 数字。运算量只与分组数有关，不分配内存。
+ * binlen 在调用处为常量，因此每个长度都会生成一份展开的专用代码。
+ */
+#define B58_LIMB_BASE 656356768ULL   /* 58^5 */
+
+static inline __attribute__((always_inline))
+size_t b58enc_fixed(char *b58, const uint8_t *bin, size_t binlen) {
+    /* 58^5 分组数：binlen * log(256)/log(58) 向上取整后按 5 位一组 */
+    enum { MAX_LIMBS = 16 };
+    size_t out_limbs = (binlen * 138 / 100 + 1 + 4) / 5;
+    uint32_t limbs[MAX_LIMBS] = {0};
+
+    size_t zeros = 0;
+    while (zeros < binlen && bin[zeros] == 0)
+        zeros++;
+
+    /* 最高的一组可能不满 4 字节 */
+    size_t first = binlen % 4 ? binlen % 4 : 4;
+    size_t pos = 0;
+    while (pos < binlen) {
+        size_t take = pos == 0 ? first : 4;
+        uint64_t carry = 0;
+        for (size_t k = 0; k < take; k++)
+            carry = (carry << 8) | bin[pos + k];
+        pos += take;
+        for (size_t j = out_limbs; j-- > 0; ) {
+            uint64_t t = ((uint64_t)limbs[j] << (8 * take)) + carry;
+            limbs[j] = (uint32_t)(t % B58_LIMB_BASE);
+            carry = t / B58_LIMB_BASE;
+        }
+    }
+
+    /* 拆分为 Base58 数字（大端），跳过前导 0 数字 */
+    uint8_t digits[MAX_LIMBS * 5];
+    for (size_t j = 0; j < out_limbs; j++) {
+        uint32_t v = limbs[j];
+        for (int k = 4; k >= 0; k--) {
+            digits[j * 5 + k] = (uint8_t)(v % 58);
+            v /= 58;
+        }
+    }
+    size_t skip = 0;
+    while (skip < out_limbs * 5 && digits[skip] == 0)
+        skip++;
+
+    /* 前导 0x00 字节编码为 '1' */
+    size_t len = 0;
+    for (size_t i = 0; i < zeros; i++)
+        b58[len++] = BASE58_ALPHABET[0];
+    for (size_t i = skip; i < out_limbs * 5; i++)
+        b58[len++] = BASE58_ALPHABET[digits[i]];
+    b58[len] = '\0';
+    return len;
+}
+
+size_t b58enc_25(char *b58, const uint8_t *bin) {
+    return b58enc_fixed(b58, bin, 25);
+}
+
+size_t b58enc_37(char *b58, const uint8_t *bin) {
+    return b58enc_fixed(b58, bin, 37);
+}
+
+size_t b58enc_38(char *b58, const uint8_t *bin) {
+    return b58enc_fixed(b58, bin, 38);
+}
+
+/* 反向查找表：字符 -> Base58 数值，非法字符为 -1 */
+static const int8_t BASE58_MAP[256] = {
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8,-1,-1,-1,-1,-1,-1,
+    -1, 9,10,11,12,13,14,15,16,-1,17,18,19,20,21,-1,
+    22,23,24,25,26,27,28,29,30,31,32,-1,-1,-1,-1,-1,
+    -1,33,34,35,36,37,38,39,40,41,42,43,-1,44,45,46,
+    47,48,49,50,51,52,53,54,55,56,57,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+};
+
+/* 58 的各次幂，用于把不满 5 位的一组数字并入累加值 */
+static const uint32_t BASE58_POW[6] = {
+    1, 58, 3364, 195112, 11316496, 656356768
+};
+
+/*
+ * 把 Base58 数字累加到大端 32 位分组 limbs[0..n) 中：
+ * 每 5 个数字合成一个小于 58^5 的值 v，再做一次 limbs = limbs * 58^k + v，
+ * 全部使用 64 位运算。返回 0 表示含非法字符或数值超出 n 个分组。
+ */
+static inline __attribute__((always_inline))
+int b58_accumulate(uint32_t *limbs, size_t n, const char *b58, size_t b58len) {
+    size_t pos = 0;
+    size_t first = b58len % 5 ? b58len % 5 : 5;
+    while (pos < b58len) {
+        size_t take = pos == 0 ? first : 5;
+        uint64_t v = 0;
+        for (size_t k = 0; k < take; k++) {
+            int8_t d = BASE58_MAP[(uint8_t)b58[pos + k]];
+            if (d < 0)
+                return 0;
+            v = v * 58 + (uint64_t)d;
+        }
+        pos += take;
+        uint64_t mul = BASE58_POW[take];
+        for (size_t j = n; j-- > 0; ) {
+            uint64_t t = (uint64_t)limbs[j] * mul + v;
+            limbs[j] = (uint32_t)t;
+            v = t >> 32;
+        }
+        if (v != 0)
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * 定长解码：结果必须恰好为 binlen 字节，且前导 '1' 的个数等于结果的
+ * 前导零字节数（与 b58tobin 给出的长度一致）。
+ */
+static inline __attribute__((always_inline))
+int b58dec_fixed(uint8_t *bin, size_t binlen, const char *b58, size_t b58len) {
+    enum { MAX_LIMBS = 16 };
+    size_t n = (binlen + 3) / 4;
+    uint32_t limbs[MAX_LIMBS] = {0};
+    if (!b58_accumulate(limbs, n, b58, b58len))
+        return 0;
+
+    /* 多出来的高位字节必须为 0 */
+    size_t extra = n * 4 - binlen;
+    if (extra && (limbs[0] >> (8 * (4 - extra))) != 0)
+        return 0;
+    for (size_t i = 0; i < binlen; i++) {
+        size_t byte = i + extra;
+        bin[i] = (uint8_t)(limbs[byte / 4] >> (8 * (3 - byte % 4)));
+    }
+
+    size_t ones = 0;
+    while (ones < b58len && b58[ones] == BASE58_ALPHABET[0])
+        ones++;
+    size_t zeros = 0;
+    while (zeros < binlen && bin[zeros] == 0)
+        zeros++;
+    return ones == zeros;
+}
+
+int b58dec_25(uint8_t *bin, const char *b58, size_t b58len) {
+    return b58dec_fixed(bin, 25, b58, b58len);
+}
+
+int b58dec_37(uint8_t *bin, const char *b58, size_t b58len) {
+    return b58dec_fixed(bin, 37, b58, b58len);
+}
+
+int b58dec_38(uint8_t *bin, const char *b58, size_t b58len) {
+    return b58dec_fixed(bin, 38, b58, b58len);
+}
+
+/*
+ * 内部函数：base58_decode_into
  *
- * 对 Base58 编码字符串进行解码，返回 malloc 分配的二进制数据缓冲区，
- * 并在 result_len 中保存解码后数据长度。
- * 调用者需要使用 free() 释放返回的内存。
+ * 通用解码，直接写入调用者的缓冲区。不超过约 700 个字符时中间结果放在栈上，
+ * 更长的输入改用堆上的临时缓冲区，长度不受限制。
+ * 前导 '1' 解码为 0x00，其余部分取最短的大端表示。
+ * binlen 输入为缓冲区大小，输出为实际长度；成功返回 1。
  */
-static uint8_t *base58_decode(const char *b58, size_t *result_len) {
+#define B58_DECODE_MAX_LIMBS 128   /* 栈上缓冲区，约 700 个字符 */
+
+static int base58_decode_into(uint8_t *bin, size_t *binlen, const char *b58, size_t b58_len) {
     /* 跳过前导空格 */
-    while (*b58 == ' ')
+    while (b58_len > 0 && *b58 == ' ') {
         b58++;
-    size_t b58_len = strlen(b58);
+        b58_len--;
+    }
 
     /* 统计前导 '1' 的个数（代表原数据中的 0x00） */
     size_t zeros = 0;
     while (zeros < b58_len && b58[zeros] == BASE58_ALPHABET[0])
         zeros++;
 
-    /* 估计输出缓冲区大小：b58_len * log(58)/log(256) + 1
-       这里取：b58_len * 733/1000 + 1 （约 0.733） */
-    size_t size = b58_len * 733 / 1000 + 1;
-    uint8_t *bin = calloc(size, 1);
-    if (!bin)
-        return NULL;
-
-    for (size_t i = 0; i < b58_len; i++) {
-        const char *p = strchr(BASE58_ALPHABET, b58[i]);
-        if (!p) {
-            free(bin);
-            return NULL;  /* 出现非法字符 */
-        }
-        int digit = p - BASE58_ALPHABET;
-        int carry = digit;
-        for (int j = (int)size - 1; j >= 0; j--) {
-            carry += 58 * bin[j];
-            bin[j] = carry % 256;
-            carry /= 256;
-        }
-        if (carry != 0) {  /* 溢出 */
-            free(bin);
-            return NULL;
-        }
+    /* 分组数：b58_len * log(58)/log(256) 字节向上取整 */
+    size_t n = (b58_len * 733 / 1000 + 1 + 3) / 4 + 1;
+    uint32_t stack_limbs[B58_DECODE_MAX_LIMBS];
+    uint32_t *limbs = stack_limbs;
+    if (n > B58_DECODE_MAX_LIMBS) {
+        limbs = (uint32_t *)malloc(n * sizeof(uint32_t));
+        if (limbs == NULL)
+            return 0;
     }
+    memset(limbs, 0, n * sizeof(uint32_t));
+    int ret = 0;
+    if (!b58_accumulate(limbs, n, b58, b58_len))
+        goto out;
 
-    /* 跳过 bin 数组中前导的零 */
-    size_t i = 0;
-    while (i < size && bin[i] == 0)
-        i++;
+    /* 跳过数值部分的前导零字节 */
+    size_t skip = 0;
+    while (skip < n * 4 && ((limbs[skip / 4] >> (8 * (3 - skip % 4))) & 0xff) == 0)
+        skip++;
 
     /* 最终输出 = 前导零（由 '1' 转换而来） + 剩余二进制数据 */
-    size_t decoded_size = zeros + (size - i);
-    uint8_t *decoded = malloc(decoded_size);
-    if (!decoded) {
-        free(bin);
+    size_t decoded_size = zeros + (n * 4 - skip);
+    if (*binlen < decoded_size)
+        goto out;
+    memset(bin, 0, zeros);
+    for (size_t i = skip; i < n * 4; i++)
+        bin[zeros + i - skip] = (uint8_t)(limbs[i / 4] >> (8 * (3 - i % 4)));
+    *binlen = decoded_size;
+    ret = 1;
+out:
+    if (limbs != stack_limbs)
+        free(limbs);
+    return ret;
+}
+
+/*
+ * 内部函数：base58_decode
+ *
+ * 对 Base58 编码字符串进行解码，返回 malloc 分配的二进制数据缓冲区，
+ * 并在 result_len 中保存解码后数据长度。
+ * 调用者需要使用 free() 释放返回的内存。
+ */
+static uint8_t *base58_decode(const char *b58, size_t *result_len) {
+    /* 前导零最多与字符数相同，数值部分不超过 base58_decode_into 的分组字节数 */
+    size_t b58_len = strlen(b58);
+    size_t decoded_size = b58_len + ((b58_len * 733 / 1000 + 1 + 3) / 4 + 1) * 4;
+    uint8_t *ret = malloc(decoded_size);
+    if (!ret)
+        return NULL;
+    if (!base58_decode_into(ret, &decoded_size, b58, b58_len)) {
+        free(ret);
         return NULL;
     }
-    memset(decoded, 0, zeros);
-    memcpy(decoded + zeros, bin + i, size - i);
-    free(bin);
     if (result_len)
         *result_len = decoded_size;
-    return decoded;
+    return ret;
 }
 
 /*
@@ -210,8 +393,20 @@ uint8_t *base58_decode_check(const char *b58, size_t *result_len) {
 
 /* 
  * b58enc - 封装 base58_encode，将 malloc 分配的字符串复制到用户提供的缓冲区。
+ * 地址（25 字节）与 WIF（37/38 字节）长度走不分配内存的定长编码。
  */
 int b58enc(char *b58, size_t *b58len, const uint8_t *bin, size_t binlen) {
+    if (binlen == 25 || binlen == 37 || binlen == 38) {
+        char fixed[B58_MAX_WIF_LEN + 1];
+        size_t len = binlen == 25 ? b58enc_25(fixed, bin)
+                   : binlen == 37 ? b58enc_37(fixed, bin)
+                   : b58enc_38(fixed, bin);
+        if (*b58len < len + 1)
+            return 0;
+        memcpy(b58, fixed, len + 1);
+        *b58len = len;
+        return 1;
+    }
     char *encoded = base58_encode(bin, binlen);
     if (!encoded)
         return 0;
@@ -227,28 +422,21 @@ int b58enc(char *b58, size_t *b58len, const uint8_t *bin, size_t binlen) {
 }
 
 /*
- * b58tobin - 封装 base58_decode，将解码后的数据复制到用户提供的缓冲区。
+ * b58tobin - 解码到用户提供的缓冲区，不分配内存。
+ * 34 字符（地址）与 51/52 字符（WIF）优先尝试定长解码。
  */
 int b58tobin(uint8_t *bin, size_t *binlen, const char *b58, size_t b58len) {
-    /* 复制 b58 字符串到临时缓冲区以确保 null 结尾 */
-    char *temp = malloc(b58len + 1);
-    if (!temp)
-        return 0;
-    memcpy(temp, b58, b58len);
-    temp[b58len] = '\0';
-
-    size_t decoded_len;
-    uint8_t *decoded = base58_decode(temp, &decoded_len);
-    free(temp);
-    if (!decoded)
-        return 0;
-    if (*binlen < decoded_len) {
-        free(decoded);
-        return 0;
+    if (b58len == 34 && *binlen >= 25 && b58dec_25(bin, b58, b58len)) {
+        *binlen = 25;
+        return 1;
     }
-    memcpy(bin, decoded, decoded_len);
-    *binlen = decoded_len;
-    free(decoded);
-    return 1;
+    if (b58len == 51 && *binlen >= 37 && b58dec_37(bin, b58, b58len)) {
+        *binlen = 37;
+        return 1;
+    }
+    if (b58len == 52 && *binlen >= 38 && b58dec_38(bin, b58, b58len)) {
+        *binlen = 38;
+        return 1;
+    }
+    return base58_decode_into(bin, binlen, b58, b58len);
 }
-
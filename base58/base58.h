@@ -28,6 +28,49 @@ extern "C" {
  */
 int b58enc(char *b58, size_t *b58len, const uint8_t *bin, size_t binlen);
 
+/* 定长编码结果的最大长度（不含结尾 0） */
+#define B58_MAX_ADDRESS_LEN 35   /* 25 字节地址载荷 */
+#define B58_MAX_WIF_LEN     52   /* 37/38 字节 WIF 载荷 */
+
+/**
+ * b58enc_25 / b58enc_37 / b58enc_38 - 定长 Base58 编码，不分配内存。
+ *
+ * @b58: 输出缓冲区，至少 B58_MAX_ADDRESS_LEN + 1（25 字节）
+ *       或 B58_MAX_WIF_LEN + 1（37/38 字节）字节，结果以 null 结尾。
+ * @bin: 输入数据，分别为 25 字节（地址）、37 字节（非压缩 WIF）、38 字节（压缩 WIF）。
+ *
+ * 返回编码后字符串的长度（不含结尾 0）。
+ */
+size_t b58enc_25(char *b58, const uint8_t *bin);
+size_t b58enc_37(char *b58, const uint8_t *bin);
+size_t b58enc_38(char *b58, const uint8_t *bin);
+
+/**
+ * b58enc_many - 批量编码 count 条 25 字节地址载荷（AVX2/AVX-512 多路并行）。
+ *
+ * @b58: 输出缓冲区，第 i 条结果以 null 结尾写在 b58 + i * stride 处。
+ * @stride: 每条结果占用的字节数，至少 B58_MAX_ADDRESS_LEN + 1。
+ * @bin: count 条连续存放的 25 字节载荷（版本 + hash160 + 校验和）。
+ * @count: 条数。
+ *
+ * 结果与逐条调用 b58enc_25 相同。
+ */
+void b58enc_many(char *b58, size_t stride, const uint8_t *bin, size_t count);
+
+/**
+ * b58dec_25 / b58dec_37 / b58dec_38 - 定长 Base58 解码，不分配内存。
+ *
+ * @bin: 输出缓冲区，分别为 25、37、38 字节。
+ * @b58: 输入字符串（无需 null 结尾）。
+ * @b58len: 输入字符串长度。
+ *
+ * 仅当字符串恰好解码为对应长度（前导 '1' 个数等于前导零字节数）时返回 1，
+ * 否则返回 0。不校验 checksum。
+ */
+int b58dec_25(uint8_t *bin, const char *b58, size_t b58len);
+int b58dec_37(uint8_t *bin, const char *b58, size_t b58len);
+int b58dec_38(uint8_t *bin, const char *b58, size_t b58len);
+
 /**
  * b58tobin - 将 Base58 字符串解码为二进制数据。
  *
@@ -0,0 +1,215 @@
+/*
+ * base58_simd.c
+ *
+ * 批量 Base58 编码：同时编码多条 25 字节地址载荷，每条占用向量寄存器中的一路。
+ *
+ * 25 字节输入视为 13 个 16 位字 w[k]（k = 0 为最低位），预先算好每个 2^(16k)
+ * 在 58^5 进制下的 7 个分组，于是 58^5 分组 j 的未规约值为
+ *     acc[j] = sum_k w[k] * B58_POW2_TABLE[k][j]
+ * 每项小于 2^16 * 58^5，13 项之和小于 2^49，可以用 double 精确表示。
+ * 随后从低位到高位做一次进位规约，再把每个分组拆成 5 个 Base58 数字。
+ * 所有除法都用乘以倒数再按最近整数取整完成（进位规约时按余数符号修正一次，
+ * 拆分数字时预先偏移半个单位），结果是精确的。
+ * 数字以每 4 个一组压成 32 位整数存放，字符映射在 32 字节向量上对整组完成，
+ * 这样每路的字符在内存中按 4 字节一段连续，写出时无需逐字节转置。
+ *
+ * 代码使用 GCC 向量扩展编写，通过 target 属性分别编译为 AVX2（每组两次 4 路）
+ * 与 AVX-512（8 路）版本，运行时按 CPU 支持情况选择；剩余部分使用 b58enc_25。
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "base58.h"
+
+typedef double b58_v4d __attribute__((vector_size(32)));
+typedef int64_t b58_v4l __attribute__((vector_size(32)));
+typedef int32_t b58_v4i __attribute__((vector_size(16)));
+typedef double b58_v8d __attribute__((vector_size(64)));
+typedef int64_t b58_v8l __attribute__((vector_size(64)));
+typedef int32_t b58_v8i __attribute__((vector_size(32)));
+
+#define B58_MANY_WORDS  13   /* 25 字节 = 12 个完整 16 位字 + 最高 1 字节 */
+#define B58_MANY_LIMBS  7    /* 58^35 > 2^200 */
+#define B58_MANY_DIGITS (B58_MANY_LIMBS * 5)
+
+/* 2^(16k) 的 58^5 进制表示，分组按大端排列 */
+static const double B58_POW2_TABLE[B58_MANY_WORDS][B58_MANY_LIMBS] = {
+    {         0,         0,         0,         0,         0,         0,         1 },  /* 2^0 */
+    {         0,         0,         0,         0,         0,         0,     65536 },  /* 2^16 */
+    {         0,         0,         0,         0,         0,         6, 356826688 },  /* 2^32 */
+    {         0,         0,         0,         0,         0,    428844, 314894464 },  /* 2^48 */
+    {         0,         0,         0,         0,        42, 537767569, 410450016 },  /* 2^64 */
+    {         0,         0,         0,         0,   2806207,  58785206, 439182400 },  /* 2^80 */
+    {         0,         0,         0,       280, 127692781, 389432875, 357132832 },  /* 2^96 */
+    {         0,         0,         0,  18362829, 581699268,  96364747,  31287840 },  /* 2^112 */
+    {         0,         0,      1833, 324463681, 385795061, 551597588,  21339008 },  /* 2^128 */
+    {         0,         0, 120159885,  61623640, 602469411, 650531698, 433312448 },  /* 2^144 */
+    {         0,     11997, 486083817,   3737691, 294005210, 247894721, 289024608 },  /* 2^160 */
+    {         1, 129927158, 369653173, 132272267, 572542671, 542099546, 373098944 },  /* 2^176 */
+    {     78508, 646269101, 118408823,  91512303, 209184527, 413102373, 153715680 },  /* 2^192 */
+};
+
+#define B58_MANY_BASE  656356768.0            /* 58^5 */
+#define B58_ROUND_MAGIC 6755399441055744.0    /* 1.5 * 2^52：加减后按最近整数取整 */
+
+/*
+ * q = x / d 取整，r = x - q * d。x 为小于 2^50 的非负整数值：
+ * x * (1/d) 的误差远小于 1，最近取整的 q 只可能比真值大 1，
+ * 此时余数为负，修正一次即可。VT 为 double 向量，VI 为同宽度的 int64 向量。
+ */
+#define B58_DIVMOD(VT, VI, x, d, q, r) do {                                   \
+    VT d_ = (VT){0} + (d);                                                    \
+    (q) = ((x) * (1.0 / (d)) + B58_ROUND_MAGIC) - B58_ROUND_MAGIC;            \
+    (r) = (x) - (q) * d_;                                                     \
+    VI neg_ = (r) < 0;                                                        \
+    (q) -= (VT)(neg_ & (VI)((VT){0} + 1.0));                                  \
+    (r) += (VT)(neg_ & (VI)d_);                                               \
+} while (0)
+
+/*
+ * floor(x / d)，x 为小于 2^30 的非负整数值，无需修正：x / d 的小数部分至多为
+ * 1 - 1/d，先减去 0.5 - 0.5/d 再按最近整数取整，舍入误差远小于 0.5/d。
+ */
+#define B58_FLOOR_DIV(x, d) \
+    ((((x) * (1.0 / (d)) - (0.5 - 0.5 / (d))) + B58_ROUND_MAGIC) - B58_ROUND_MAGIC)
+
+typedef int8_t b58_v32c __attribute__((vector_size(32)));
+
+#define B58_MANY_PACKED 9    /* 36 个数字（第 36 个恒为 0）每 4 个压成一个 32 位字 */
+
+/* 一组 8 条地址的中间结果：packed[m][l] 的 4 个字节依次为第 l 路第 4m..4m+3 个数字 */
+typedef struct {
+    int32_t packed[B58_MANY_PACKED][8];
+} B58_MANY_GROUP;
+
+/*
+ * 数字 d (0..57) 转为字母表字符：字母表由 6 段连续的 ASCII 区间组成，
+ * 用比较结果（真为 -1）做掩码累加分段偏移，避免逐字节查表。
+ */
+#define B58_DIGIT_CHAR(d) \
+    ((d) + '1' + (((d) > 8) & 7) + (((d) > 16) & 1) + (((d) > 21) & 1) + (((d) > 32) & 6) + (((d) > 43) & 1))
+
+/*
+ * VT/VI/VS：double 向量、同宽 int64 向量、同路数 int32 向量；LANES 为路数。
+ * 编码 bin 开始的 LANES 条 25 字节载荷，数字写入 group 的第 lane0.. 路。
+ */
+#define B58_MANY_BODY(VT, VI, VS, LANES, bin, group, lane0) do {              \
+    /* 按大端取 16 位字，先以 int32 排成“字 x 路”再整向量转为 double */      \
+    int32_t wi_[B58_MANY_WORDS][LANES];                                       \
+    for (int l = 0; l < (LANES); l++) {                                       \
+        const uint8_t *p_ = (bin) + l * 25;                                   \
+        for (int k = 0; k < B58_MANY_WORDS - 1; k++)                          \
+            wi_[k][l] = ((int32_t)p_[23 - 2 * k] << 8) | p_[24 - 2 * k];      \
+        wi_[B58_MANY_WORDS - 1][l] = p_[0];                                   \
+    }                                                                         \
+    VT w[B58_MANY_WORDS], acc[B58_MANY_LIMBS];                                \
+    for (int k = 0; k < B58_MANY_WORDS; k++) {                                \
+        VS t_;                                                                \
+        memcpy(&t_, wi_[k], sizeof(t_));                                      \
+        w[k] = __builtin_convertvector(t_, VT);                               \
+    }                                                                         \
+                                                                              \
+    _Pragma("GCC unroll 7")                                                   \
+    for (int j = 0; j < B58_MANY_LIMBS; j++) {                                \
+        acc[j] = (VT){0};                                                     \
+        _Pragma("GCC unroll 13")                                              \
+        for (int k = 0; k < B58_MANY_WORDS; k++)                              \
+            if (B58_POW2_TABLE[k][j] != 0)                                    \
+                acc[j] += w[k] * B58_POW2_TABLE[k][j];                        \
+    }                                                                         \
+                                                                              \
+    /* 进位规约：先对所有分组并行求商与余数，商并入高一组后每组小于       \
+       2 * 58^5，再自低向高传递至多为 1 的进位 */                           \
+    VT carry_[B58_MANY_LIMBS];                                                \
+    for (int j = 1; j < B58_MANY_LIMBS; j++)                                  \
+        B58_DIVMOD(VT, VI, acc[j], B58_MANY_BASE, carry_[j], acc[j]);         \
+    for (int j = 0; j < B58_MANY_LIMBS - 1; j++)                              \
+        acc[j] += carry_[j + 1];                                              \
+    for (int j = B58_MANY_LIMBS - 1; j > 0; j--) {                            \
+        VI ge_ = acc[j] >= B58_MANY_BASE;                                     \
+        acc[j] -= (VT)(ge_ & (VI)((VT){0} + B58_MANY_BASE));                  \
+        acc[j - 1] += (VT)(ge_ & (VI)((VT){0} + 1.0));                        \
+    }                                                                         \
+                                                                              \
+    /* 每个分组拆成 5 个数字：q[k] = floor(v / 58^k) 互相独立，             \
+       第 k 位数字为 q[k] - 58 * q[k + 1] */                                \
+    VT dig_[B58_MANY_PACKED * 4];                                             \
+    for (int j = 0; j < B58_MANY_LIMBS; j++) {                                \
+        VT q_[5];                                                             \
+        q_[0] = acc[j];                                                       \
+        q_[1] = B58_FLOOR_DIV(acc[j], 58.0);                                  \
+        q_[2] = B58_FLOOR_DIV(acc[j], 3364.0);                                \
+        q_[3] = B58_FLOOR_DIV(acc[j], 195112.0);                              \
+        q_[4] = B58_FLOOR_DIV(acc[j], 11316496.0);                            \
+        for (int k = 0; k < 4; k++)                                           \
+            dig_[j * 5 + 4 - k] = q_[k] - q_[k + 1] * 58.0;                   \
+        dig_[j * 5] = q_[4];                                                  \
+    }                                                                         \
+    dig_[B58_MANY_DIGITS] = (VT){0};                                          \
+                                                                              \
+    /* 每 4 个数字压成一个 32 位字（小端：低字节为靠前的数字） */             \
+    for (int m = 0; m < B58_MANY_PACKED; m++) {                               \
+        VT p_ = dig_[4 * m] + dig_[4 * m + 1] * 256.0 +                       \
+                dig_[4 * m + 2] * 65536.0 + dig_[4 * m + 3] * 16777216.0;     \
+        VS pi_ = __builtin_convertvector(p_, VS);                             \
+        memcpy(&(group)->packed[m][lane0], &pi_, sizeof(pi_));                \
+    }                                                                         \
+} while (0)
+
+/*
+ * 把 group 中 8 路的数字转为字符并写到输出。前导 0x00 字节编码为 '1'，而数字 0
+ * 的字符也是 '1'：前导零字节数不会超过前导 0 数字个数，所以只需从每路的 35 个
+ * 字符中去掉开头多出的 '1' 即可。
+ */
+static inline __attribute__((always_inline))
+void b58_many_store(B58_MANY_GROUP *group, char *b58, size_t stride, const uint8_t *bin) {
+    for (size_t i = 0; i < sizeof(group->packed); i += sizeof(b58_v32c)) {
+        b58_v32c d;
+        memcpy(&d, (char *)group->packed + i, sizeof(d));
+        d = B58_DIGIT_CHAR(d);
+        memcpy((char *)group->packed + i, &d, sizeof(d));
+    }
+    for (int l = 0; l < 8; l++) {
+        /* 35 个字符后补 0，使从任意 drop 处起固定复制 36 字节都以 null 结尾 */
+        char chars[B58_MANY_PACKED * 4 + 36] = {0};
+        for (int m = 0; m < B58_MANY_PACKED; m++)
+            memcpy(chars + 4 * m, &group->packed[m][l], 4);
+        chars[B58_MANY_DIGITS] = '\0';
+        const uint8_t *in = bin + l * 25;
+        int zeros = 0, ones = 0;
+        while (zeros < 25 && in[zeros] == 0)
+            zeros++;
+        while (ones < B58_MANY_DIGITS && chars[ones] == '1')
+            ones++;
+        memcpy(b58 + l * stride, chars + (ones - zeros), B58_MAX_ADDRESS_LEN + 1);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void b58enc_many_x8_avx2(char *b58, size_t stride, const uint8_t *bin) {
+    B58_MANY_GROUP group;
+    B58_MANY_BODY(b58_v4d, b58_v4l, b58_v4i, 4, bin, &group, 0);
+    B58_MANY_BODY(b58_v4d, b58_v4l, b58_v4i, 4, bin + 4 * 25, &group, 4);
+    b58_many_store(&group, b58, stride, bin);
+}
+
+__attribute__((target("avx512f")))
+static void b58enc_many_x8_avx512(char *b58, size_t stride, const uint8_t *bin) {
+    B58_MANY_GROUP group;
+    B58_MANY_BODY(b58_v8d, b58_v8l, b58_v8i, 8, bin, &group, 0);
+    b58_many_store(&group, b58, stride, bin);
+}
+
+void b58enc_many(char *b58, size_t stride, const uint8_t *bin, size_t count) {
+    size_t i = 0;
+    if (__builtin_cpu_supports("avx512f")) {
+        for (; i + 8 <= count; i += 8)
+            b58enc_many_x8_avx512(b58 + i * stride, stride, bin + i * 25);
+    } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        for (; i + 8 <= count; i += 8)
+            b58enc_many_x8_avx2(b58 + i * stride, stride, bin + i * 25);
+    }
+    for (; i < count; i++)
+        b58enc_25(b58 + i * stride, bin + i * 25);
+}
@@ -0,0 +1,191 @@
+// gcc -O2 -o test_base58 test_base58.c base58.c base58_simd.c ../sha256/sha256.c
+// ./test_base58
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "base58.h"
+
+/* 已知的地址与 WIF（私钥 1 以及 README 中的示例） */
+static const char *VECTORS[] = {
+    "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH",
+    "1EHNa6Q4Jz2uvNExL497mE43ikXhwF6kZm",
+    "3JvL6Ymt8MVWiCNHC7oWU6nLeHNJKLZGLN",
+    "1111111111111111111114oLvT2",
+    "KwDiBf89QgGbjEhKnhXJuH7LrciVrZi3qYjgd9M7rFU73sVHnoWn",
+    "5HpHagT65TZzG1PH3CSu63k8DbpvD8s5ip4nEB3kEsreAnchuDf",
+    "L2fnZUEo3pjdzGNZdRwBV7m3tR3LLrXGh9xvkh8U9JEHkZcn9vTj",
+    "5K3u1ZTEc5ULFnd9kbeeiiQaHBRzrMjezakV3CMiwtwDQU7epGh",
+};
+
+/* 解码后再用定长编码器编码，应得到原字符串 */
+static int check_fixed_encode(const char *b58) {
+    uint8_t bin[64];
+    size_t bin_len = sizeof(bin);
+    char out[64];
+    if (!b58tobin(bin, &bin_len, b58, strlen(b58))) {
+        printf("  FAIL decode %s\n", b58);
+        return 1;
+    }
+    size_t len;
+    if (bin_len == 25)
+        len = b58enc_25(out, bin);
+    else if (bin_len == 37)
+        len = b58enc_37(out, bin);
+    else if (bin_len == 38)
+        len = b58enc_38(out, bin);
+    else {
+        printf("  FAIL unexpected length %zu for %s\n", bin_len, b58);
+        return 1;
+    }
+    if (len != strlen(b58) || strcmp(out, b58) != 0) {
+        printf("  FAIL encode %s -> %s\n", b58, out);
+        return 1;
+    }
+    return 0;
+}
+
+/* 前导零字节与全 0xff 的边界情况：b58enc 分发到定长编码后应能正确往返 */
+static int check_edges(void) {
+    static const size_t lens[] = {25, 37, 38};
+    for (size_t n = 0; n < 3; n++) {
+        for (size_t zeros = 0; zeros <= lens[n]; zeros++) {
+            uint8_t bin[38], back[64];
+            memset(bin, 0xff, sizeof(bin));
+            memset(bin, 0, zeros);
+            char b58[64];
+            size_t b58_len = sizeof(b58);
+            size_t back_len = sizeof(back);
+            if (!b58enc(b58, &b58_len, bin, lens[n]) ||
+                !b58tobin(back, &back_len, b58, b58_len) ||
+                back_len != lens[n] || memcmp(back, bin, lens[n]) != 0) {
+                printf("  FAIL round trip len %zu zeros %zu\n", lens[n], zeros);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* 超过栈上缓冲区（约 700 个字符）的输入改用堆缓冲区，仍能往返 */
+static int check_long(void) {
+    static uint8_t bin[1000], back[1100];
+    static char b58[1500];
+    for (size_t i = 0; i < sizeof(bin); i++)
+        bin[i] = i < 3 ? 0 : (uint8_t)(i * 131 + 7);
+    size_t b58_len = sizeof(b58), back_len = sizeof(back);
+    if (!b58enc(b58, &b58_len, bin, sizeof(bin)) || b58_len < 1000 ||
+        !b58tobin(back, &back_len, b58, b58_len) ||
+        back_len != sizeof(bin) || memcmp(back, bin, sizeof(bin)) != 0) {
+        printf("  FAIL long round trip\n");
+        return 1;
+    }
+    char *check = base58_encode_check(bin, sizeof(bin));
+    size_t check_len = 0;
+    uint8_t *decoded = check != NULL ? base58_decode_check(check, &check_len) : NULL;
+    int failed = decoded == NULL || check_len != sizeof(bin) || memcmp(decoded, bin, sizeof(bin)) != 0;
+    if (failed)
+        printf("  FAIL long Base58Check round trip\n");
+    free(check);
+    free(decoded);
+    return failed;
+}
+
+/* 定长解码与通用解码结果一致；非法字符与长度不符时返回失败 */
+static int check_fixed_decode(const char *b58) {
+    uint8_t expect[64], got[38];
+    size_t expect_len = sizeof(expect);
+    size_t len = strlen(b58);
+    if (!b58tobin(expect, &expect_len, b58, len)) {
+        printf("  FAIL decode %s\n", b58);
+        return 1;
+    }
+    int ok = expect_len == 25 ? b58dec_25(got, b58, len)
+           : expect_len == 37 ? b58dec_37(got, b58, len)
+           : b58dec_38(got, b58, len);
+    if (!ok || memcmp(got, expect, expect_len) != 0) {
+        printf("  FAIL fixed decode %s\n", b58);
+        return 1;
+    }
+    /* 长度不符：25 字节地址不能按 37/38 字节解码 */
+    if (expect_len == 25 && (b58dec_37(got, b58, len) || b58dec_38(got, b58, len))) {
+        printf("  FAIL fixed decode accepted wrong length for %s\n", b58);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_invalid(void) {
+    const char *bad[] = {
+        "0BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH",
+        "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMO",
+        "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMI",
+        "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMl",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        uint8_t bin[64];
+        size_t bin_len = sizeof(bin);
+        if (b58dec_25(bin, bad[i], strlen(bad[i])) || b58tobin(bin, &bin_len, bad[i], strlen(bad[i]))) {
+            printf("  FAIL accepted invalid string %s\n", bad[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* 批量编码与逐条 b58enc_25 一致，覆盖向量分组、剩余部分与前导零 */
+static int check_many(void) {
+    enum { COUNT = 203, STRIDE = B58_MAX_ADDRESS_LEN + 1 };
+    static uint8_t bin[COUNT * 25];
+    static char got[COUNT * STRIDE];
+    uint32_t x = 12345;
+    for (size_t i = 0; i < sizeof(bin); i++) {
+        x = x * 1103515245u + 12345u;
+        bin[i] = (uint8_t)(x >> 24);
+    }
+    for (size_t n = 0; n < 26; n++) {
+        memset(bin + n * 25, 0, n);                 /* 0..25 个前导零字节 */
+        memset(bin + (n + 30) * 25, 0xff, 25 - n);  /* 接近最大值 */
+    }
+    for (size_t count = 0; count <= COUNT; count += 29) {
+        memset(got, 0x55, sizeof(got));
+        b58enc_many(got, STRIDE, bin, count);
+        for (size_t i = 0; i < count; i++) {
+            char expect[STRIDE];
+            b58enc_25(expect, bin + i * 25);
+            if (strcmp(expect, got + i * STRIDE) != 0) {
+                printf("  FAIL b58enc_many count %zu item %zu\n", count, i);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    printf("Testing fixed-size Base58 encoders...\n");
+    for (size_t i = 0; i < sizeof(VECTORS) / sizeof(VECTORS[0]); i++) {
+        failed |= check_fixed_encode(VECTORS[i]);
+    }
+    printf("Testing fixed-size Base58 decoders...\n");
+    for (size_t i = 0; i < sizeof(VECTORS) / sizeof(VECTORS[0]); i++) {
+        failed |= check_fixed_decode(VECTORS[i]);
+    }
+    failed |= check_invalid();
+    printf("Testing leading zeros and edge values...\n");
+    failed |= check_edges();
+    printf("Testing long inputs...\n");
+    failed |= check_long();
+    printf("Testing batch Base58 encoder...\n");
+    failed |= check_many();
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
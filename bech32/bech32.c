@@ -16,23 +16,29 @@ static const char *CHARSET = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
 
 /* --- 内部函数 --- */
 
+/* polymod 的单步：移入一个 5 位值 */
+static uint32_t bech32_polymod_step(uint32_t chk, uint32_t value) {
+    uint32_t top = chk >> 25;
+    chk = ((chk & 0x1ffffff) << 5) ^ value;
+    for (int j = 0; j < 5; j++) {
+        if ((top >> j) & 1) {
+            switch(j) {
+                case 0: chk ^= 0x3b6a57b2; break;
+                case 1: chk ^= 0x26508e6d; break;
+                case 2: chk ^= 0x1ea119fa; break;
+                case 3: chk ^= 0x3d4233dd; break;
+                case 4: chk ^= 0x2a1462b3; break;
+            }
+        }
+    }
+    return chk;
+}
+
 /* 计算 Bech32 校验和（polymod） */
 static uint32_t bech32_polymod(const int *values, size_t values_len) {
     uint32_t chk = 1;
     for (size_t i = 0; i < values_len; i++) {
-        int top = chk >> 25;
-        chk = ((chk & 0x1ffffff) << 5) ^ (uint32_t)values[i];
-        for (int j = 0; j < 5; j++) {
-            if ((top >> j) & 1) {
-                switch(j) {
-                    case 0: chk ^= 0x3b6a57b2; break;
-                    case 1: chk ^= 0x26508e6d; break;
-                    case 2: chk ^= 0x1ea119fa; break;
-                    case 3: chk ^= 0x3d4233dd; break;
-                    case 4: chk ^= 0x2a1462b3; break;
-                }
-            }
-        }
+        chk = bech32_polymod_step(chk, (uint32_t)values[i]);
     }
     return chk;
 }
@@ -243,10 +249,211 @@ static char *segwit_addr_encode_internal(const char *hrp, int witver, const uint
     return ret;
 }
 
+/* --- 快速编码路径 --- */
+
+/*
+ * polymod 对移入的值是 GF(2) 线性的：连续移入两个 5 位值 v1、v2 后，
+ *     chk' = ((chk & 0xfffff) << 10) ^ (v1 << 5 | v2) ^ BECH32_POLYMOD2[chk >> 20]
+ * 其中表项只取决于 chk 的高 10 位。BECH32_POLYMOD1 为单步移入时的对应表。
+ */
+static uint32_t BECH32_POLYMOD1[32];
+static uint32_t BECH32_POLYMOD2[1024];
+
+/* "bc" 与 "tb" 扩展后的 HRP 已移入时的 polymod 状态 */
+static uint32_t BECH32_HRP_STATE_BC;
+static uint32_t BECH32_HRP_STATE_TB;
+
+static uint32_t bech32_hrp_state(const char *hrp) {
+    int expanded[2 * 83 + 1];
+    int n = bech32_hrp_expand(hrp, expanded);
+    return bech32_polymod(expanded, (size_t)n);
+}
+
+__attribute__((constructor))
+static void bech32_init_tables(void) {
+    for (uint32_t top = 0; top < 32; top++)
+        BECH32_POLYMOD1[top] = bech32_polymod_step(top << 25, 0);
+    for (uint32_t hi = 0; hi < 1024; hi++)
+        BECH32_POLYMOD2[hi] = bech32_polymod_step(bech32_polymod_step(hi << 20, 0), 0);
+    BECH32_HRP_STATE_BC = bech32_hrp_state("bc");
+    BECH32_HRP_STATE_TB = bech32_hrp_state("tb");
+}
+
+static inline uint32_t bech32_polymod_push1(uint32_t chk, uint32_t v) {
+    return ((chk & 0x1ffffff) << 5) ^ v ^ BECH32_POLYMOD1[chk >> 25];
+}
+
+static inline uint32_t bech32_polymod_push2(uint32_t chk, uint32_t v1, uint32_t v2) {
+    return ((chk & 0xfffff) << 10) ^ (v1 << 5 | v2) ^ BECH32_POLYMOD2[chk >> 20];
+}
+
+/*
+ * 对 "bc"/"tb" 直接编码到调用者缓冲区：witness 程序按位打包成 5 位值，
+ * 校验和用查表的 polymod 每次移入两个值。仅处理解码端会接受的组合
+ * （版本 0..16，程序 2..40 字节，版本 0 时为 20 或 32 字节），
+ * 因此无需像通用路径那样再解码一次自检。返回 0 表示交由通用路径处理。
+ *
+ * 与通用路径一致，所有版本都使用 Bech32 校验常数 1。
+ */
+static int segwit_addr_encode_fast(char *output, const char *hrp, int witver, const uint8_t *witprog, size_t witprog_len) {
+    uint32_t chk;
+    if (hrp[0] == 'b' && hrp[1] == 'c' && hrp[2] == '\0')
+        chk = BECH32_HRP_STATE_BC;
+    else if (hrp[0] == 't' && hrp[1] == 'b' && hrp[2] == '\0')
+        chk = BECH32_HRP_STATE_TB;
+    else
+        return 0;
+    if (witver < 0 || witver > 16 || witprog_len < 2 || witprog_len > 40)
+        return 0;
+    if (witver == 0 && witprog_len != 20 && witprog_len != 32)
+        return 0;
+
+    /* 版本号 + 程序的 5 位分组（末尾不足 5 位补 0） */
+    uint8_t data[1 + 64];
+    size_t n = 0;
+    data[n++] = (uint8_t)witver;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < witprog_len; i++) {
+        acc = (acc << 8) | witprog[i];
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            data[n++] = (acc >> bits) & 31;
+        }
+    }
+    if (bits > 0)
+        data[n++] = (acc << (5 - bits)) & 31;
+
+    char *out = output;
+    *out++ = hrp[0];
+    *out++ = hrp[1];
+    *out++ = '1';
+    size_t i = 0;
+    if (n & 1) {
+        chk = bech32_polymod_push1(chk, data[0]);
+        *out++ = CHARSET[data[0]];
+        i = 1;
+    }
+    for (; i < n; i += 2) {
+        chk = bech32_polymod_push2(chk, data[i], data[i + 1]);
+        out[0] = CHARSET[data[i]];
+        out[1] = CHARSET[data[i + 1]];
+        out += 2;
+    }
+    /* 再移入 6 个 0 得到校验值 */
+    chk = bech32_polymod_push2(chk, 0, 0);
+    chk = bech32_polymod_push2(chk, 0, 0);
+    chk = bech32_polymod_push2(chk, 0, 0);
+    chk ^= 1;
+    for (int k = 0; k < 6; k++)
+        *out++ = CHARSET[(chk >> (5 * (5 - k))) & 31];
+    *out = '\0';
+    return 1;
+}
+
+/* 反向查找表：字符 -> 5 位值（大小写均可），非法字符为 -1 */
+static const int8_t BECH32_CHARSET_REV[128] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    15, -1, 10, 17, 21, 20, 26, 30,  7,  5, -1, -1, -1, -1, -1, -1,
+    -1, 29, -1, 24, 13, 25,  9,  8, 23, -1, 18, 22, 31, 27, 19, -1,
+     1,  0,  3, 16, 11, 28, 12, 14,  6,  4,  2, -1, -1, -1, -1, -1,
+    -1, 29, -1, 24, 13, 25,  9,  8, 23, -1, 18, 22, 31, 27, 19, -1,
+     1,  0,  3, 16, 11, 28, 12, 14,  6,  4,  2, -1, -1, -1, -1, -1
+};
+
+#define BECH32M_CONST 0x2bc830a3
+
+/*
+ * 解码一个地址：hrp_state 为预期 HRP 移入后的 polymod 状态。
+ * 地址中的 HRP 与预期 HRP 按不区分大小写比较，但整个地址不得大小写混合。
+ */
+static int segwit_decode_one(const char *hrp, size_t hrp_len, uint32_t hrp_state,
+                             const char *addr, size_t len, SEGWIT_RECORD *rec) {
+    rec->encoding = BECH32_ENCODING_NONE;
+    /* HRP + '1' + 版本 + 至少 2 字节程序（4 个值）+ 6 位校验 */
+    if (len > 90 || len < hrp_len + 1 + 1 + 4 + 6 || addr[hrp_len] != '1')
+        return 0;
+    int has_lower = 0, has_upper = 0;
+    for (size_t i = 0; i < hrp_len; i++) {
+        unsigned char c = (unsigned char)addr[i];
+        if (c >= 'A' && c <= 'Z') {
+            has_upper = 1;
+            c = (unsigned char)(c - 'A' + 'a');
+        } else if (c >= 'a' && c <= 'z') {
+            has_lower = 1;
+        }
+        if (c != (unsigned char)hrp[i])
+            return 0;
+    }
+
+    uint8_t data[90];
+    size_t n = len - hrp_len - 1;
+    const char *p = addr + hrp_len + 1;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)p[i];
+        int8_t v = c < 128 ? BECH32_CHARSET_REV[c] : -1;
+        if (v < 0)
+            return 0;
+        has_upper |= c >= 'A' && c <= 'Z';
+        has_lower |= c >= 'a' && c <= 'z';
+        data[i] = (uint8_t)v;
+    }
+    if (has_lower && has_upper)
+        return 0;
+
+    uint32_t chk = hrp_state;
+    size_t i = 0;
+    if (n & 1) {
+        chk = bech32_polymod_push1(chk, data[0]);
+        i = 1;
+    }
+    for (; i < n; i += 2)
+        chk = bech32_polymod_push2(chk, data[i], data[i + 1]);
+    uint8_t encoding;
+    if (chk == 1)
+        encoding = BECH32_ENCODING_BECH32;
+    else if (chk == BECH32M_CONST)
+        encoding = BECH32_ENCODING_BECH32M;
+    else
+        return 0;
+
+    /* 版本号之后的值按 5 -> 8 位转换，不允许补位 */
+    size_t nvals = n - 6 - 1;
+    if (data[0] > 16 || nvals * 5 / 8 > sizeof(rec->witprog))
+        return 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t out = 0;
+    for (size_t k = 1; k <= nvals; k++) {
+        acc = (acc << 5) | data[k];
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            rec->witprog[out++] = (uint8_t)(acc >> bits);
+        }
+    }
+    if (bits >= 5 || (acc & ((1u << bits) - 1)) != 0)
+        return 0;
+    if (out < 2 || (data[0] == 0 && out != 20 && out != 32))
+        return 0;
+    /* BIP350：v0 只能用 Bech32 常数；v1 及以上两种常数都接受（本工具的编码器仍输出 Bech32） */
+    if (data[0] == 0 && encoding == BECH32_ENCODING_BECH32M)
+        return 0;
+    rec->witprog_len = (uint8_t)out;
+    rec->witver = data[0];
+    rec->encoding = encoding;
+    return 1;
+}
+
 /* --- 对外接口 --- */
 
 /* segwit_addr_encode: 将 witness 程序编码为 Bech32 格式地址 */
 int segwit_addr_encode(char *output, const char *hrp, int witver, const uint8_t *witprog, size_t witprog_len) {
+    if (segwit_addr_encode_fast(output, hrp, witver, witprog, witprog_len))
+        return 1;
     char *encoded = segwit_addr_encode_internal(hrp, witver, witprog, witprog_len);
     if (!encoded) return 0;
     strcpy(output, encoded);
@@ -259,3 +466,19 @@ int segwit_addr_decode(const char *addr, const char *hrp, int *witver, uint8_t *
     return segwit_addr_decode_internal(addr, hrp, witver, witprog, witprog_len);
 }
 
+/* segwit_addr_decode_many: 批量解码 segwit 地址 */
+size_t segwit_addr_decode_many(const char *hrp, const char *const *addrs, const size_t *addr_lens, size_t count, SEGWIT_RECORD *records) {
+    size_t hrp_len = strlen(hrp);
+    size_t ok = 0;
+    if (hrp_len == 0 || hrp_len > 83) {
+        for (size_t i = 0; i < count; i++)
+            records[i].encoding = BECH32_ENCODING_NONE;
+        return 0;
+    }
+    uint32_t hrp_state = strcmp(hrp, "bc") == 0 ? BECH32_HRP_STATE_BC
+                       : strcmp(hrp, "tb") == 0 ? BECH32_HRP_STATE_TB
+                       : bech32_hrp_state(hrp);
+    for (size_t i = 0; i < count; i++)
+        ok += segwit_decode_one(hrp, hrp_len, hrp_state, addrs[i], addr_lens[i], &records[i]);
+    return ok;
+}
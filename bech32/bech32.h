@@ -42,6 +42,35 @@ int segwit_addr_encode(char *output, const char *hrp, int witver, const uint8_t
  */
 int segwit_addr_decode(const char *addr, const char *hrp, int *witver, uint8_t *witprog, size_t *witprog_len);
 
+/* 校验和类型 */
+#define BECH32_ENCODING_NONE    0   /* 解码失败 */
+#define BECH32_ENCODING_BECH32  1   /* 校验常数 1（BIP173） */
+#define BECH32_ENCODING_BECH32M 2   /* 校验常数 0x2bc830a3（BIP350） */
+
+/* 批量解码的结果记录 */
+typedef struct segwit_record {
+    uint8_t witprog[40];
+    uint8_t witprog_len;
+    uint8_t witver;
+    uint8_t encoding;       /* BECH32_ENCODING_*，为 BECH32_ENCODING_NONE 时其余字段无意义 */
+} SEGWIT_RECORD;
+
+/**
+ * segwit_addr_decode_many - 批量解码 segwit 地址
+ *
+ * @hrp: 预期的人类可读部分（例如 "bc"），对所有地址相同
+ * @addrs: count 个地址指针，无需 null 结尾
+ * @addr_lens: 各地址长度
+ * @count: 地址个数
+ * @records: 输出 count 条记录，第 i 条对应 addrs[i]
+ *
+ * 校验和用查表的 polymod 计算，常数记录在 encoding 中。witness v0 只接受 Bech32
+ * 常数（BIP350）；v1 及以上两种常数都接受，这是有意偏离 BIP350：本工具的编码器对
+ * 所有版本都使用 Bech32 常数，其输出必须能够原样载入。其余规则与 segwit_addr_decode
+ * 相同。返回成功解码的个数。
+ */
+size_t segwit_addr_decode_many(const char *hrp, const char *const *addrs, const size_t *addr_lens, size_t count, SEGWIT_RECORD *records);
+
 #ifdef __cplusplus
 }
 #endif
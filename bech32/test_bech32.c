@@ -1,134 +1,168 @@
-// gcc -o test_bech32 test_bech32.c bech32.c
+// gcc -O2 -o test_bech32 test_bech32.c bech32.c
 // ./test_bech32
 
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
-#include <assert.h>
 
 #include "bech32.h"
 
-void print_hex(const uint8_t *data, size_t len) {
-    for (size_t i = 0; i < len; i++) {
-        printf("%02x", data[i]);
-    }
-    printf("\n");
-}
-
-int test_encode_decode(const char *hrp, int witver, const uint8_t *witprog, size_t proglen) {
-    char encoded[200];
-    int decoded_ver;
-    uint8_t decoded_prog[200];
-    size_t decoded_prog_len = sizeof(decoded_prog);
-
-    printf("Testing HRP: %s, Version: %d, Program Length: %zu\n", hrp, witver, proglen);
-    printf("  Original program: ");
-    print_hex(witprog, proglen);
-
-    // Encode
-    if (!segwit_addr_encode(encoded, hrp, witver, witprog, proglen)) {
-        printf("  Encoding failed.\n");
+/* 私钥 1 对应压缩公钥的 hash160 */
+static const uint8_t G_HASH160[20] = {
+    0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x23,
+    0xf1, 0x43, 0x3b, 0xd6
+};
+
+static const struct {
+    const char *hrp;
+    int witver;
+    const char *addr;
+} VECTORS[] = {
+    { "bc", 0, "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4" },
+    { "tb", 0, "tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx" },
+    /* 本工具的 witness v1 地址沿用 Bech32 校验常数 */
+    { "bc", 1, "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7k8e76x7" },
+};
+
+/* 编码结果解码后应得到原始版本与程序 */
+static int check_round_trip(const char *hrp, int witver, const uint8_t *prog, size_t len) {
+    char addr[100];
+    uint8_t back[40];
+    size_t back_len = sizeof(back);
+    int ver;
+    if (!segwit_addr_encode(addr, hrp, witver, prog, len) ||
+        !segwit_addr_decode(addr, hrp, &ver, back, &back_len) ||
+        ver != witver || back_len != len || memcmp(back, prog, len) != 0) {
+        printf("  FAIL round trip %s v%d len %zu\n", hrp, witver, len);
         return 1;
     }
-    printf("  Encoded address: %s\n", encoded);
+    return 0;
+}
 
-    // Decode
-    if (!segwit_addr_decode(encoded, hrp, &decoded_ver, decoded_prog, &decoded_prog_len)) {
-        printf("  Decoding failed.\n");
-        return 1;
+/* 批量解码：两种校验常数（v0 只接受 Bech32）、大小写、非法输入 */
+static int check_decode_many(void) {
+    static const struct {
+        const char *addr;
+        int encoding;
+        int witver;
+        size_t len;
+    } cases[] = {
+        { "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", BECH32_ENCODING_BECH32, 0, 20 },
+        { "BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4", BECH32_ENCODING_BECH32, 0, 20 },
+        { "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7k8e76x7", BECH32_ENCODING_BECH32, 1, 20 },
+        { "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", BECH32_ENCODING_BECH32M, 1, 32 },
+        { "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", BECH32_ENCODING_BECH32M, 1, 40 },
+        { "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh", BECH32_ENCODING_NONE, 0, 0 },   /* v0 使用 Bech32m 常数 */
+        { "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5", BECH32_ENCODING_NONE, 0, 0 },   /* 校验和错误 */
+        { "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7Kv8f3t4", BECH32_ENCODING_NONE, 0, 0 },   /* 大小写混合 */
+        { "tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx", BECH32_ENCODING_NONE, 0, 0 },   /* HRP 不符 */
+        { "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3tb", BECH32_ENCODING_NONE, 0, 0 },   /* 非法字符 */
+        { "bc1", BECH32_ENCODING_NONE, 0, 0 },
+    };
+    enum { N = sizeof(cases) / sizeof(cases[0]) };
+    const char *addrs[N];
+    size_t lens[N];
+    SEGWIT_RECORD recs[N];
+    size_t expect_ok = 0;
+    for (size_t i = 0; i < N; i++) {
+        addrs[i] = cases[i].addr;
+        lens[i] = strlen(cases[i].addr);
+        expect_ok += cases[i].encoding != BECH32_ENCODING_NONE;
     }
-    printf("  Decoded version: %d\n", decoded_ver);
-    printf("  Decoded program: ");
-    print_hex(decoded_prog, decoded_prog_len);
-
-    // Verify
-    if (witver != decoded_ver) {
-        printf("  Version mismatch.\n");
+    if (segwit_addr_decode_many("bc", addrs, lens, N, recs) != expect_ok) {
+        printf("  FAIL segwit_addr_decode_many count\n");
         return 1;
     }
-    if (proglen != decoded_prog_len) {
-        printf("  Program length mismatch.\n");
-        return 1;
+    for (size_t i = 0; i < N; i++) {
+        if (recs[i].encoding != cases[i].encoding ||
+            (cases[i].encoding != BECH32_ENCODING_NONE &&
+             (recs[i].witver != cases[i].witver || recs[i].witprog_len != cases[i].len))) {
+            printf("  FAIL decode_many %s\n", cases[i].addr);
+            return 1;
+        }
     }
-    if (memcmp(witprog, decoded_prog, proglen) != 0) {
-        printf("  Program data mismatch.\n");
+    if (memcmp(recs[0].witprog, G_HASH160, 20) != 0 || memcmp(recs[2].witprog, G_HASH160, 20) != 0) {
+        printf("  FAIL decode_many program\n");
         return 1;
     }
-    printf("  Test passed.\n\n");
     return 0;
 }
 
-int test_invalid_decode(const char *hrp, const char *address)
-{
-    int decoded_ver;
-    uint8_t decoded_prog[200];
-    size_t decoded_prog_len = sizeof(decoded_prog);
-    printf("Testing invalid decode HRP: %s,  Address: %s\n", hrp, address);
-    if(segwit_addr_decode(address, hrp, &decoded_ver, decoded_prog, &decoded_prog_len)) {
-        printf("  Error: Invalid address should have failed to decode, but it did not.\n");
-        return 1;
-    } else {
-       printf("  Test Passed, invalid address failed to decode as expected.\n");
+/* 单条解码应拒绝的地址：校验和、大小写混合、版本、长度与 HRP 错误 */
+static int check_invalid_decode(void) {
+    static const char *bad[] = {
+        "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5",
+        "BC1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5",
+        "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kw5rljs5",
+        "bc10w508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kw5rljs5",
+        "bc10qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5a",
+        "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5w",
+        "bc1zqw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5",
+        "tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5",
+    };
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        int ver;
+        uint8_t prog[64];
+        size_t prog_len = sizeof(prog);
+        if (segwit_addr_decode(bad[i], "bc", &ver, prog, &prog_len)) {
+            printf("  FAIL decoded invalid address %s\n", bad[i]);
+            failed = 1;
+        }
     }
-    return 0;
-
+    return failed;
 }
 
-
-int test_uppercase_hrp_fail(const char *hrp, int witver, const uint8_t *witprog, size_t proglen) {
-     char encoded[200];
-     printf("Testing uppercase HRP fail: %s, Version: %d, Program Length: %zu\n", hrp, witver, proglen);
-
-    if (segwit_addr_encode(encoded, hrp, witver, witprog, proglen)) {
-        printf("  Error: Uppercase HRP should have failed to encode, but it did not.\n");
-       return 1;
-    } else {
-       printf("  Test Passed, uppercase HRP failed to encode as expected.\n");
+int main(void) {
+    int failed = 0;
+    char addr[100];
+
+    printf("Testing known addresses...\n");
+    for (size_t i = 0; i < sizeof(VECTORS) / sizeof(VECTORS[0]); i++) {
+        if (!segwit_addr_encode(addr, VECTORS[i].hrp, VECTORS[i].witver, G_HASH160, 20) ||
+            strcmp(addr, VECTORS[i].addr) != 0) {
+            printf("  FAIL %s\n", VECTORS[i].addr);
+            failed = 1;
+        }
     }
-    return 0;
-}
-
 
+    printf("Testing round trips...\n");
+    uint8_t prog[40];
+    for (size_t i = 0; i < sizeof(prog); i++)
+        prog[i] = (uint8_t)(i * 37 + 11);
+    for (int ver = 0; ver <= 16; ver++) {
+        for (size_t len = 2; len <= 40; len++) {
+            if (ver == 0 && len != 20 && len != 32)
+                continue;
+            failed |= check_round_trip("bc", ver, prog, len);
+            failed |= check_round_trip("tb", ver, prog, len);
+            failed |= check_round_trip("bcrt", ver, prog, len);
+        }
+    }
 
-int main(void) {
-    uint8_t prog20[] = {0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x1c, 0x0e, 0xf6, 0x4b, 0x8e};
-    uint8_t prog32[] = {
-        0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x1c,
-        0x0e, 0xf6, 0x4b, 0x8e, 0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45
-    };
-    uint8_t prog40[] = {
-        0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x1c,
-        0x0e, 0xf6, 0x4b, 0x8e, 0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45,
-        0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,
-    };
+    printf("Testing batch decoding...\n");
+    failed |= check_decode_many();
 
-    // Test valid cases
-    if(test_encode_decode("bc", 0, prog20, sizeof(prog20)) != 0) return 1;
-    if(test_encode_decode("tb", 0, prog20, sizeof(prog20)) != 0) return 1;
-    if(test_encode_decode("bc", 1, prog20, sizeof(prog20)) != 0) return 1;
-    if(test_uppercase_hrp_fail("BC", 0, prog20, sizeof(prog20)) != 0) return 1; // test uppercase HRP fail
-    if(test_encode_decode("test", 0, prog32, sizeof(prog32)) != 0) return 1;
-    if(test_encode_decode("test", 0, prog40, sizeof(prog40)) != 0) return 1;
-    if(test_encode_decode("z", 0, prog20, sizeof(prog20)) != 0) return 1; // test short HRP
+    printf("Testing invalid addresses...\n");
+    failed |= check_invalid_decode();
 
-    uint8_t short_prog[] = {0x01, 0x02, 0x03};
-    if(test_encode_decode("test", 0, short_prog, sizeof(short_prog)) != 0) return 1;
-    uint8_t long_prog[64];
-    for (size_t i = 0; i < 64; i++) {
-        long_prog[i] = i;
+    printf("Testing rejected inputs...\n");
+    if (segwit_addr_encode(addr, "BC", 0, prog, 20)) {
+        printf("  FAIL accepted uppercase HRP\n");
+        failed = 1;
+    }
+    if (segwit_addr_encode(addr, "bc", 0, prog, 21) ||
+        segwit_addr_encode(addr, "bc", 17, prog, 20) ||
+        segwit_addr_encode(addr, "bc", 1, prog, 41) ||
+        segwit_addr_encode(addr, "bc", 1, prog, 1)) {
+        printf("  FAIL accepted invalid witness program\n");
+        failed = 1;
     }
-    if(test_encode_decode("test", 0, long_prog, sizeof(long_prog)) != 0) return 1;
-
-    // Test invalid decode cases
-     if(test_invalid_decode("bc","bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5") != 0) return 1;
-    if(test_invalid_decode("bc", "BC1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5") != 0) return 1;
-    if(test_invalid_decode("bc", "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kw5rljs5") != 0) return 1;
-    if(test_invalid_decode("bc", "bc10w508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kw5rljs5") != 0) return 1;
-     if(test_invalid_decode("bc","bc10qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5a") != 0) return 1;
-    if(test_invalid_decode("bc","bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5w") != 0) return 1;
-    if(test_invalid_decode("bc","bc1zqw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5") != 0) return 1;
-    if(test_invalid_decode("bc","tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5") != 0) return 1;
 
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
     printf("All tests passed.\n");
     return 0;
 }
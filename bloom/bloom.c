@@ -0,0 +1,86 @@
+/*
+ * bloom.c
+ *
+ * 分块 Bloom 过滤器。键的前 16 字节混合出 64 位哈希 h：h 的高位通过乘法取模选块，
+ * 低 32 位再与 8 个奇数常数相乘，各取乘积的高 6 位作为对应字内的位号。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bloom.h"
+
+static const uint32_t BLOOM_SALT[BLOOM_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+static inline uint64_t bloom_hash(const uint8_t *key) {
+    uint64_t a, b;
+    memcpy(&a, key, 8);
+    memcpy(&b, key + 8, 8);
+    uint64_t h = a ^ (b * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline uint64_t *bloom_block(const BLOOM *bf, uint64_t h) {
+    uint64_t index = (uint64_t)(((unsigned __int128)h * bf->nblocks) >> 64);
+    return bf->blocks + index * BLOOM_BLOCK_WORDS;
+}
+
+/* 块内 8 个字各自的位掩码 */
+static inline void bloom_mask(uint64_t h, uint64_t mask[BLOOM_BLOCK_WORDS]) {
+    uint32_t lo = (uint32_t)h;
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        mask[i] = 1ULL << ((lo * BLOOM_SALT[i]) >> 26);
+}
+
+int bloom_init(BLOOM *bf, uint64_t expected, unsigned bits_per_key) {
+    if (bits_per_key == 0)
+        bits_per_key = BLOOM_DEFAULT_BITS_PER_KEY;
+    uint64_t bits = expected * bits_per_key;
+    bf->nblocks = (bits + BLOOM_BLOCK_WORDS * 64 - 1) / (BLOOM_BLOCK_WORDS * 64);
+    if (bf->nblocks == 0)
+        bf->nblocks = 1;
+    size_t bytes = (size_t)bf->nblocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+    bf->blocks = (uint64_t *)aligned_alloc(64, bytes);
+    if (bf->blocks == NULL) {
+        bf->nblocks = 0;
+        return -1;
+    }
+    memset(bf->blocks, 0, bytes);
+    return 0;
+}
+
+void bloom_free(BLOOM *bf) {
+    free(bf->blocks);
+    bf->blocks = NULL;
+    bf->nblocks = 0;
+}
+
+void bloom_add(BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]) {
+    uint64_t h = bloom_hash(key);
+    uint64_t *block = bloom_block(bf, h);
+    uint64_t mask[BLOOM_BLOCK_WORDS];
+    bloom_mask(h, mask);
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        block[i] |= mask[i];
+}
+
+int bloom_query(const BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]) {
+    uint64_t h = bloom_hash(key);
+    const uint64_t *block = bloom_block(bf, h);
+    uint64_t mask[BLOOM_BLOCK_WORDS];
+    bloom_mask(h, mask);
+    uint64_t missing = 0;
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        missing |= mask[i] & ~block[i];
+    return missing == 0;
+}
+
+void bloom_prefetch(const BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]) {
+    __builtin_prefetch(bloom_block(bf, bloom_hash(key)));
+}
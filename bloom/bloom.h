@@ -0,0 +1,53 @@
+/*
+ * bloom.h
+ *
+ * 按缓存行分块的 Bloom 过滤器（split block Bloom filter）。
+ *
+ * 每个键只落在一个 64 字节块内：块由键的哈希选出，块内 8 个 64 位字各置 1 位，
+ * 一次查询只访问一条缓存行。键本身应当已是均匀分布的哈希值（例如 hash160），
+ * 这里只再做一次廉价的混合。
+ */
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLOOM_KEY_LEN 20            /* 键长度：hash160 */
+#define BLOOM_BLOCK_WORDS 8         /* 每块 8 个 64 位字 = 64 字节 */
+#define BLOOM_DEFAULT_BITS_PER_KEY 16
+
+typedef struct bloom {
+    uint64_t *blocks;               /* nblocks * BLOOM_BLOCK_WORDS 个字，64 字节对齐 */
+    uint64_t nblocks;
+} BLOOM;
+
+/**
+ * bloom_init - 按预计键数分配过滤器
+ *
+ * @expected: 预计插入的键数
+ * @bits_per_key: 每个键分配的位数，16 时误判率约为 0.1%
+ *
+ * 成功返回 0，内存不足返回 -1。
+ */
+int bloom_init(BLOOM *bf, uint64_t expected, unsigned bits_per_key);
+void bloom_free(BLOOM *bf);
+
+void bloom_add(BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]);
+
+/* 可能包含返回 1，一定不包含返回 0 */
+int bloom_query(const BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]);
+
+/* 预取键所在的块，批量查询前对整批调用可以重叠各次缓存未命中 */
+void bloom_prefetch(const BLOOM *bf, const uint8_t key[BLOOM_KEY_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOOM_H */
@@ -0,0 +1,81 @@
+// gcc -O2 -o test_bloom test_bloom.c bloom.c
+// ./test_bloom
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bloom.h"
+
+#define KEYS 100000
+
+/* 简单的可重复伪随机键 */
+static void make_key(uint64_t seed, uint8_t key[BLOOM_KEY_LEN]) {
+    for (int i = 0; i < BLOOM_KEY_LEN; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        key[i] = (uint8_t)seed;
+    }
+}
+
+int main(void) {
+    int failed = 0;
+    BLOOM bf;
+    uint8_t key[BLOOM_KEY_LEN];
+
+    printf("Testing bloom_add / bloom_query...\n");
+    if (bloom_init(&bf, KEYS, BLOOM_DEFAULT_BITS_PER_KEY) != 0) {
+        printf("  FAIL bloom_init\n");
+        return 1;
+    }
+    for (uint64_t i = 1; i <= KEYS; i++) {
+        make_key(i, key);
+        bloom_add(&bf, key);
+    }
+    /* 插入过的键一定命中 */
+    for (uint64_t i = 1; i <= KEYS; i++) {
+        make_key(i, key);
+        if (!bloom_query(&bf, key)) {
+            printf("  FAIL inserted key %llu not found\n", (unsigned long long)i);
+            failed = 1;
+            break;
+        }
+    }
+
+    printf("Testing false positive rate...\n");
+    uint64_t fp = 0;
+    for (uint64_t i = KEYS + 1; i <= 11 * KEYS; i++) {
+        make_key(i, key);
+        fp += bloom_query(&bf, key);
+    }
+    double rate = (double)fp / (10.0 * KEYS);
+    printf("  false positives: %llu / %d (%.4f%%)\n", (unsigned long long)fp, 10 * KEYS, rate * 100);
+    if (rate > 0.002) {
+        printf("  FAIL false positive rate too high\n");
+        failed = 1;
+    }
+    bloom_free(&bf);
+
+    /* 空过滤器什么都不包含 */
+    printf("Testing empty filter...\n");
+    if (bloom_init(&bf, 0, 0) != 0 || bf.nblocks != 1) {
+        printf("  FAIL empty init\n");
+        failed = 1;
+    } else {
+        make_key(42, key);
+        if (bloom_query(&bf, key)) {
+            printf("  FAIL empty filter reported a key\n");
+            failed = 1;
+        }
+        bloom_free(&bf);
+    }
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
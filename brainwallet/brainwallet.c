@@ -0,0 +1,267 @@
+/*
+ * brainwallet.c
+ *
+ * libbrainwallet：密钥与地址推导的批量接口。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+
+#include "brainwallet.h"
+
+#include "../sha256/sha256.h"
+#include "../hash160/hash160.h"
+#include "../base58/base58.h"
+#include "../customutil/customutil.h"
+
+/* secp256k1 椭圆曲线参数 */
+static const char *EC_constant_N = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141";
+static const char *EC_constant_P = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
+static const char *EC_constant_Gx = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+static const char *EC_constant_Gy = "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+
+/* 批量计算 hash160 时每组的公钥个数 */
+#define BW_HASH_BATCH 256
+
+int bw_ctx_init(BW_CTX *ctx) {
+    mpz_inits(ctx->ec.p, ctx->ec.a, ctx->ec.b, ctx->ec.n, NULL);
+    mpz_set_str(ctx->ec.p, EC_constant_P, 16);
+    mpz_set_ui(ctx->ec.a, 0);    // secp256k1: a = 0
+    mpz_set_ui(ctx->ec.b, 7);    // secp256k1: b = 7
+    mpz_set_str(ctx->ec.n, EC_constant_N, 16);
+
+    point_init(&ctx->G);
+    mpz_set_str(ctx->G.x, EC_constant_Gx, 16);
+    mpz_set_str(ctx->G.y, EC_constant_Gy, 16);
+    ctx->G.infinity = 0;
+    return 0;
+}
+
+void bw_ctx_free(BW_CTX *ctx) {
+    point_clear(&ctx->G);
+    mpz_clears(ctx->ec.p, ctx->ec.a, ctx->ec.b, ctx->ec.n, NULL);
+}
+
+/* 将 hex 字符串转换为二进制数据 */
+int bw_hex2bin(const char *hex, uint8_t *bin, size_t bin_len) {
+    size_t hex_len = strlen(hex);
+    if (hex_len != bin_len * 2)
+        return -1;
+    return hex_decode(bin, hex, hex_len);
+}
+
+/* 将 WIF 解码为 32 字节私钥，并判断是否为压缩格式 */
+int bw_wif_decode(const char *wif, uint8_t priv[BW_PRIVKEY_LEN], bool *compressed) {
+    size_t decoded_len = 100;
+    uint8_t decoded[100] = {0};
+
+    if (!b58tobin(decoded, &decoded_len, wif, strlen(wif)))
+        return -1;
+
+    /* 解码后长度应为 37 字节（非压缩）或 38 字节（压缩） */
+    if (decoded_len == 37)
+        *compressed = false;
+    else if (decoded_len == 38)
+        *compressed = true;
+    else
+        return -1;
+
+    /* 检查版本字节：应为 0x80 */
+    if (decoded[0] != 0x80)
+        return -1;
+
+    /* 校验 checksum：对前 decoded_len-4 字节进行双 SHA256 */
+    uint8_t hash1[32], hash2[32];
+    sha256(decoded, decoded_len - 4, hash1);
+    sha256(hash1, 32, hash2);
+    if (memcmp(hash2, decoded + decoded_len - 4, 4) != 0)
+        return -1;
+
+    /* 私钥位于 decoded[1..32] */
+    memcpy(priv, decoded + 1, BW_PRIVKEY_LEN);
+    return 0;
+}
+
+/* 将 32 字节私钥转换为 WIF 格式 */
+int bw_wif_encode(const uint8_t priv[BW_PRIVKEY_LEN], bool compressed, char *wif, size_t wif_len) {
+    uint8_t payload[34];
+    payload[0] = 0x80;
+    memcpy(payload + 1, priv, BW_PRIVKEY_LEN);
+    size_t payload_len = 33;
+    if (compressed) {
+        payload[33] = 0x01;
+        payload_len = 34;
+    }
+    uint8_t hash1[32], hash2[32];
+    sha256(payload, payload_len, hash1);
+    sha256(hash1, 32, hash2);
+    uint8_t full[38];
+    memcpy(full, payload, payload_len);
+    memcpy(full + payload_len, hash2, 4);
+    size_t full_len = payload_len + 4;
+    if (wif_len > B58_MAX_WIF_LEN) {
+        /* 定长编码器，不分配内存 */
+        if (compressed)
+            b58enc_38(wif, full);
+        else
+            b58enc_37(wif, full);
+        return 0;
+    }
+    size_t encoded_len = wif_len;
+    if (!b58enc(wif, &encoded_len, full, full_len))
+        return -1;
+    return 0;
+}
+
+/* 根据版本字节和 20 字节数据生成 Base58Check 地址 */
+int bw_base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len) {
+    uint8_t full[25];
+    full[0] = version;
+    memcpy(full + 1, hash20, 20);
+    uint8_t hash1[32], hash2[32];
+    sha256(full, 21, hash1);
+    sha256(hash1, 32, hash2);
+    memcpy(full + 21, hash2, 4);
+    size_t encoded_len = addr_len;
+    if (!b58enc(address, &encoded_len, full, 25))
+        return -1;
+    return 0;
+}
+
+/* 根据公钥和地址类型生成地址（兼容旧接口，返回的字符串由调用者 free） */
+char *bw_public_key_to_address(const char *public_key_hex, const char *address_type) {
+    uint8_t pub_bin[100] = {0}; // 假设公钥最大长度为 100 bytes
+    size_t pub_bin_len = strlen(public_key_hex) / 2;
+    if (pub_bin_len > sizeof(pub_bin) || bw_hex2bin(public_key_hex, pub_bin, pub_bin_len) != 0) {
+        fprintf(stderr, "Error: Invalid public key hex.\n");
+        return NULL;
+    }
+
+    ADDRESS_TYPE type = address_type_from_name(address_type);
+    if (type == 0) {
+        fprintf(stderr, "Error: Invalid address type.\n");
+        return NULL;
+    }
+
+    ADDRESS_SET set;
+    if (address_from_pubkey(pub_bin, pub_bin_len, NULL, type, &set) != 0)
+        return NULL;
+
+    char *address = strdup(ADDRESS_GET(&set, type));
+    if (address == NULL)
+        fprintf(stderr, "Error: Memory allocation failed.\n");
+    return address;
+}
+
+void bw_phrases_to_privkeys(const char *const *phrases, const size_t *phrase_lens, size_t count,
+                            uint64_t iterations, uint8_t *privkeys) {
+    SHA256_PREFIX_CACHE cache;
+    sha256_cache_init(&cache);
+    for (size_t i = 0; i < count; i++) {
+        size_t len = phrase_lens != NULL ? phrase_lens[i] : strlen(phrases[i]);
+        sha256_cached(&cache, phrases[i], len, privkeys + i * BW_PRIVKEY_LEN);
+    }
+    if (iterations > 1)
+        sha256_iterate_many(privkeys, count, iterations - 1, privkeys);
+}
+
+int bw_privkeys_to_pubkeys(const BW_CTX *ctx, const uint8_t *privkeys, size_t count,
+                           uint8_t *pubkeys_comp, uint8_t *pubkeys_uncomp) {
+    int ret = 0;
+    mpz_t priv;
+    Point pub;
+    mpz_init(priv);
+    point_init(&pub);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t *comp = pubkeys_comp != NULL ? pubkeys_comp + i * BW_PUBKEY_COMPRESSED_LEN : NULL;
+        uint8_t *uncomp = pubkeys_uncomp != NULL ? pubkeys_uncomp + i * BW_PUBKEY_UNCOMPRESSED_LEN : NULL;
+
+        mpz_import(priv, BW_PRIVKEY_LEN, 1, 1, 1, 0, privkeys + i * BW_PRIVKEY_LEN);
+        /* 调用标量乘法： pub = priv * G */
+        scalar_multiplication(&ctx->ec, &ctx->G, &pub, priv);
+        if (point_is_infinity(&pub)) {
+            if (comp != NULL)
+                memset(comp, 0, BW_PUBKEY_COMPRESSED_LEN);
+            if (uncomp != NULL)
+                memset(uncomp, 0, BW_PUBKEY_UNCOMPRESSED_LEN);
+            ret = -1;
+            continue;
+        }
+
+        if (comp != NULL)
+            generate_binpublickey(&pub, true, comp);
+        if (uncomp != NULL)
+            generate_binpublickey(&pub, false, uncomp);
+    }
+    point_clear(&pub);
+    mpz_clear(priv);
+    return ret;
+}
+
+void bw_pubkeys_to_hash160s(const uint8_t *pubkeys, size_t pubkey_len, size_t count, uint8_t *hashes) {
+    hash160_pubkeys(pubkeys, pubkey_len, count, hashes);
+}
+
+/* Base58Check 编码的地址类型，整组批量编码 */
+#define BW_BASE58_TYPES (ADDRESS_P2PKH | ADDRESS_P2SH | ADDRESS_P2SH_P2WPKH)
+
+/*
+ * n 个 base58check(version, hash20) 写入 out + i * stride：校验和用多缓冲 SHA-256，
+ * 编码用 b58enc_many。
+ */
+static void base58check_many(uint8_t version, const uint8_t *hash20s, size_t n, char *out, size_t stride) {
+    uint8_t payloads[BW_HASH_BATCH * 25];
+    uint8_t hash1[BW_HASH_BATCH * 32], hash2[BW_HASH_BATCH * 32];
+    for (size_t i = 0; i < n; i++) {
+        payloads[i * 25] = version;
+        memcpy(payloads + i * 25 + 1, hash20s + i * BW_HASH160_LEN, BW_HASH160_LEN);
+    }
+    sha256_batch(payloads, 25, 21, n, hash1);
+    sha256_batch(hash1, 32, 32, n, hash2);
+    for (size_t i = 0; i < n; i++)
+        memcpy(payloads + i * 25 + 21, hash2 + i * 32, 4);
+    b58enc_many(out, stride, payloads, n);
+}
+
+int bw_pubkeys_to_addresses(const uint8_t *pubkeys, size_t pubkey_len, const uint8_t *hashes,
+                            size_t count, unsigned types, ADDRESS_SET *sets) {
+    uint8_t batch[BW_HASH_BATCH * BW_HASH160_LEN];
+    for (size_t base = 0; base < count; base += BW_HASH_BATCH) {
+        size_t n = count - base < BW_HASH_BATCH ? count - base : BW_HASH_BATCH;
+        const uint8_t *h = hashes != NULL ? hashes + base * BW_HASH160_LEN : batch;
+        if (hashes == NULL && (types & ADDRESS_NEEDS_HASH160))
+            hash160_pubkeys(pubkeys + base * pubkey_len, pubkey_len, n, batch);
+        else if (hashes == NULL)
+            h = NULL;
+        /* Base58Check 类型在下面整组编码，逐条只生成 Bech32 类型 */
+        for (size_t i = 0; i < n; i++) {
+            if (address_from_pubkey(pubkeys + (base + i) * pubkey_len, pubkey_len,
+                                    h != NULL ? h + i * BW_HASH160_LEN : NULL,
+                                    types & ~BW_BASE58_TYPES, &sets[base + i]) != 0)
+                return -1;
+        }
+        if ((types & BW_BASE58_TYPES) == 0)
+            continue;
+        ADDRESS_SET *set = &sets[base];
+        if (types & ADDRESS_P2PKH)
+            base58check_many(0x00, h, n, ADDRESS_GET(set, ADDRESS_P2PKH), sizeof(ADDRESS_SET));
+        if (types & ADDRESS_P2SH)
+            base58check_many(0x05, h, n, ADDRESS_GET(set, ADDRESS_P2SH), sizeof(ADDRESS_SET));
+        if (types & ADDRESS_P2SH_P2WPKH) {
+            /* 赎回脚本 0x0014<hash160> 的 hash160 */
+            uint8_t scripts[BW_HASH_BATCH * 22], redeem[BW_HASH_BATCH * BW_HASH160_LEN];
+            for (size_t i = 0; i < n; i++) {
+                scripts[i * 22] = 0x00;
+                scripts[i * 22 + 1] = 0x14;
+                memcpy(scripts + i * 22 + 2, h + i * BW_HASH160_LEN, BW_HASH160_LEN);
+            }
+            hash160_pubkeys(scripts, 22, n, redeem);
+            base58check_many(0x05, redeem, n, ADDRESS_GET(set, ADDRESS_P2SH_P2WPKH), sizeof(ADDRESS_SET));
+        }
+        for (size_t i = 0; i < n; i++)
+            sets[base + i].types |= types & BW_BASE58_TYPES;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * brainwallet.h
+ *
+ * libbrainwallet：Brain 与 key 共用的密钥与地址推导库。
+ * 批量接口在调用者分配的连续数组上工作，可直接链接到其他程序，
+ * 无需为每个密钥启动进程、解析文本输出。
+ *
+ * 推导链：短语 -> 私钥 -> 公钥 -> hash160 -> 地址
+ *
+ * BW_CTX 初始化后只读，多个线程可共享同一个上下文。
+ */
+
+#ifndef BRAINWALLET_H
+#define BRAINWALLET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../ecc/ecc.h"
+#include "../address/address.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BW_PRIVKEY_LEN             32
+#define BW_PUBKEY_COMPRESSED_LEN   33
+#define BW_PUBKEY_UNCOMPRESSED_LEN 65
+#define BW_HASH160_LEN             20
+#define BW_WIF_MAX_LEN             52   /* 压缩 WIF 的字符数，不含结尾 '\0' */
+
+/* secp256k1 曲线参数与生成元 */
+typedef struct bw_ctx {
+    EllipticCurve ec;
+    Point G;
+} BW_CTX;
+
+/* 初始化 secp256k1 上下文，成功返回 0 */
+int bw_ctx_init(BW_CTX *ctx);
+
+/* 释放上下文中的 GMP 资源 */
+void bw_ctx_free(BW_CTX *ctx);
+
+/*
+ * 单条辅助函数
+ */
+
+/* hex 字符串转二进制，hex 长度必须恰为 bin_len * 2，成功返回 0 */
+int bw_hex2bin(const char *hex, uint8_t *bin, size_t bin_len);
+
+/**
+ * bw_wif_decode - 解码 WIF 私钥
+ *
+ * @wif: WIF 字符串（主网版本字节 0x80）
+ * @priv: 输出 32 字节私钥
+ * @compressed: 输出是否为压缩格式
+ *
+ * 成功返回 0，长度、版本或校验和错误时返回 -1。
+ */
+int bw_wif_decode(const char *wif, uint8_t priv[BW_PRIVKEY_LEN], bool *compressed);
+
+/* 将 32 字节私钥编码为 WIF，wif_len 为缓冲区大小，成功返回 0 */
+int bw_wif_encode(const uint8_t priv[BW_PRIVKEY_LEN], bool compressed, char *wif, size_t wif_len);
+
+/* 由版本字节和 20 字节哈希生成 Base58Check 地址，成功返回 0 */
+int bw_base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len);
+
+/*
+ * 由 hex 公钥和类型名（"P2PKH"、"P2SH-P2WPKH" 等）生成单个地址。
+ * 返回 malloc 分配的字符串，由调用者 free；出错返回 NULL。
+ */
+char *bw_public_key_to_address(const char *public_key_hex, const char *address_type);
+
+/*
+ * 批量接口：输入输出均为连续数组，第 i 条记录位于 i * 记录长度 处
+ */
+
+/**
+ * bw_phrases_to_privkeys - 短语的 SHA-256（迭代 iterations 次）作为私钥
+ *
+ * @phrases: 短语数组
+ * @phrase_lens: 各短语字节数，为 NULL 时使用 strlen
+ * @count: 短语个数
+ * @iterations: SHA-256 应用次数（至少为 1）
+ * @privkeys: 输出 count * 32 字节
+ *
+ * 按字典序排列的输入可复用公共前缀的 SHA-256 中间状态。
+ */
+void bw_phrases_to_privkeys(const char *const *phrases, const size_t *phrase_lens, size_t count,
+                            uint64_t iterations, uint8_t *privkeys);
+
+/**
+ * bw_privkeys_to_pubkeys - 计算私钥对应的公钥
+ *
+ * @ctx: 已初始化的上下文
+ * @privkeys: count * 32 字节私钥
+ * @count: 私钥个数
+ * @pubkeys_comp: 输出 count * 33 字节压缩公钥，可为 NULL
+ * @pubkeys_uncomp: 输出 count * 65 字节非压缩公钥，可为 NULL
+ *
+ * 全部成功返回 0；若有私钥为 0（模 n），其公钥置零并返回 -1。
+ */
+int bw_privkeys_to_pubkeys(const BW_CTX *ctx, const uint8_t *privkeys, size_t count,
+                           uint8_t *pubkeys_comp, uint8_t *pubkeys_uncomp);
+
+/* 批量 hash160，pubkey_len 为每个公钥的长度（33 或 65） */
+void bw_pubkeys_to_hash160s(const uint8_t *pubkeys, size_t pubkey_len, size_t count, uint8_t *hashes);
+
+/**
+ * bw_pubkeys_to_addresses - 批量生成地址
+ *
+ * @pubkeys: count * pubkey_len 字节公钥
+ * @pubkey_len: 每个公钥的长度（33 或 65）
+ * @hashes: 已算好的 count * 20 字节 hash160，为 NULL 时在函数内批量计算
+ * @count: 公钥个数
+ * @types: 需要生成的地址类型（ADDRESS_TYPE 按位或）
+ * @sets: 输出 count 个 ADDRESS_SET
+ *
+ * Base58Check 地址（P2PKH、P2SH、P2SH-P2WPKH）每组用多缓冲 SHA-256 算校验和，
+ * 再用 b58enc_many 整组编码；其余类型逐条生成。
+ *
+ * 成功返回 0，任一编码失败返回 -1。
+ */
+int bw_pubkeys_to_addresses(const uint8_t *pubkeys, size_t pubkey_len, const uint8_t *hashes,
+                            size_t count, unsigned types, ADDRESS_SET *sets);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRAINWALLET_H */
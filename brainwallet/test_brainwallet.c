@@ -0,0 +1,166 @@
+// make lib && gcc -O2 -o test_brainwallet brainwallet/test_brainwallet.c libbrainwallet.a -lgmp
+// ./test_brainwallet
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "brainwallet.h"
+
+/* 与 Brain "you are so sexy" 的输出一致 */
+static const char *PHRASE = "you are so sexy";
+static const char *PHRASE_PRIV_HEX = "a299e70c5dcec3357eb6beffe71206f63580f7217adab656fffc217df95fa484";
+static const char *PHRASE_WIF_COMP = "L2fnZUEo3pjdzGNZdRwBV7m3tR3LLrXGh9xvkh8U9JEHkZcn9vTj";
+static const char *PHRASE_WIF_UNCOMP = "5K3u1ZTEc5ULFnd9kbeeiiQaHBRzrMjezakV3CMiwtwDQU7epGh";
+static const char *PHRASE_PUB_COMP_HEX = "037966a6973797d78d29d14fa3251591e14afde3aea2de3a009b69088077314087";
+static const char *PHRASE_HASH160_HEX = "a297dc14a08bac02f0a06f11543a2fd54f960e4a";
+static const char *PHRASE_P2PKH = "1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfr";
+
+static int check_single(const BW_CTX *ctx) {
+    int failed = 0;
+    uint8_t priv[32], expect_priv[32];
+    const char *phrases[1] = { PHRASE };
+
+    bw_phrases_to_privkeys(phrases, NULL, 1, 1, priv);
+    bw_hex2bin(PHRASE_PRIV_HEX, expect_priv, 32);
+    if (memcmp(priv, expect_priv, 32) != 0) {
+        printf("  FAIL bw_phrases_to_privkeys\n");
+        failed = 1;
+    }
+
+    char wif[BW_WIF_MAX_LEN + 1];
+    if (bw_wif_encode(priv, true, wif, sizeof(wif)) != 0 || strcmp(wif, PHRASE_WIF_COMP) != 0) {
+        printf("  FAIL bw_wif_encode compressed\n");
+        failed = 1;
+    }
+    if (bw_wif_encode(priv, false, wif, sizeof(wif)) != 0 || strcmp(wif, PHRASE_WIF_UNCOMP) != 0) {
+        printf("  FAIL bw_wif_encode uncompressed\n");
+        failed = 1;
+    }
+
+    uint8_t decoded[32];
+    bool compressed = false;
+    if (bw_wif_decode(PHRASE_WIF_COMP, decoded, &compressed) != 0 || !compressed ||
+        memcmp(decoded, priv, 32) != 0) {
+        printf("  FAIL bw_wif_decode compressed\n");
+        failed = 1;
+    }
+    if (bw_wif_decode(PHRASE_WIF_UNCOMP, decoded, &compressed) != 0 || compressed ||
+        memcmp(decoded, priv, 32) != 0) {
+        printf("  FAIL bw_wif_decode uncompressed\n");
+        failed = 1;
+    }
+    if (bw_wif_decode("L2fnZUEo3pjdzGNZdRwBV7m3tR3LLrXGh9xvkh8U9JEHkZcn9vTk", decoded, &compressed) == 0) {
+        printf("  FAIL bw_wif_decode accepted a bad checksum\n");
+        failed = 1;
+    }
+
+    uint8_t pub[33], expect_pub[33], h160[20], expect_h160[20];
+    if (bw_privkeys_to_pubkeys(ctx, priv, 1, pub, NULL) != 0) {
+        printf("  FAIL bw_privkeys_to_pubkeys\n");
+        return 1;
+    }
+    bw_hex2bin(PHRASE_PUB_COMP_HEX, expect_pub, 33);
+    if (memcmp(pub, expect_pub, 33) != 0) {
+        printf("  FAIL compressed public key\n");
+        failed = 1;
+    }
+    bw_pubkeys_to_hash160s(pub, 33, 1, h160);
+    bw_hex2bin(PHRASE_HASH160_HEX, expect_h160, 20);
+    if (memcmp(h160, expect_h160, 20) != 0) {
+        printf("  FAIL hash160\n");
+        failed = 1;
+    }
+
+    ADDRESS_SET set;
+    if (bw_pubkeys_to_addresses(pub, 33, NULL, 1, ADDRESS_P2PKH, &set) != 0 ||
+        strcmp(ADDRESS_GET(&set, ADDRESS_P2PKH), PHRASE_P2PKH) != 0) {
+        printf("  FAIL bw_pubkeys_to_addresses\n");
+        failed = 1;
+    }
+
+    char *address = bw_public_key_to_address(PHRASE_PUB_COMP_HEX, "P2PKH");
+    if (address == NULL || strcmp(address, PHRASE_P2PKH) != 0) {
+        printf("  FAIL bw_public_key_to_address\n");
+        failed = 1;
+    }
+    free(address);
+    return failed;
+}
+
+/* 批量结果与逐条调用比较，覆盖 hash160 分组边界 */
+static int check_batch(const BW_CTX *ctx) {
+    enum { COUNT = 300 };
+    static char texts[COUNT][32];
+    static const char *phrases[COUNT];
+    static size_t lens[COUNT];
+    static uint8_t privs[COUNT * 32], pubs_comp[COUNT * 33], pubs_uncomp[COUNT * 65];
+    static uint8_t hashes[COUNT * 20];
+    static ADDRESS_SET sets[COUNT], sets_hashed[COUNT];
+    int failed = 0;
+
+    for (size_t i = 0; i < COUNT; i++) {
+        lens[i] = (size_t)snprintf(texts[i], sizeof(texts[i]), "phrase %zu", i);
+        phrases[i] = texts[i];
+    }
+    bw_phrases_to_privkeys(phrases, lens, COUNT, 3, privs);
+    if (bw_privkeys_to_pubkeys(ctx, privs, COUNT, pubs_comp, pubs_uncomp) != 0) {
+        printf("  FAIL bw_privkeys_to_pubkeys batch\n");
+        return 1;
+    }
+    bw_pubkeys_to_hash160s(pubs_uncomp, 65, COUNT, hashes);
+    if (bw_pubkeys_to_addresses(pubs_uncomp, 65, NULL, COUNT, ADDRESS_ALL, sets) != 0 ||
+        bw_pubkeys_to_addresses(pubs_uncomp, 65, hashes, COUNT, ADDRESS_ALL, sets_hashed) != 0) {
+        printf("  FAIL bw_pubkeys_to_addresses batch\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < COUNT && !failed; i++) {
+        uint8_t priv[32], pub_comp[33], pub_uncomp[65];
+        const char *one[1] = { phrases[i] };
+        bw_phrases_to_privkeys(one, NULL, 1, 3, priv);
+        bw_privkeys_to_pubkeys(ctx, priv, 1, pub_comp, pub_uncomp);
+        ADDRESS_SET set;
+        address_from_pubkey(pub_uncomp, 65, NULL, ADDRESS_ALL, &set);
+        if (memcmp(priv, privs + i * 32, 32) != 0 ||
+            memcmp(pub_comp, pubs_comp + i * 33, 33) != 0 ||
+            memcmp(pub_uncomp, pubs_uncomp + i * 65, 65) != 0 ||
+            memcmp(set.hash160, sets[i].hash160, 20) != 0 ||
+            memcmp(set.addr, sets[i].addr, sizeof(set.addr)) != 0 ||
+            memcmp(set.addr, sets_hashed[i].addr, sizeof(set.addr)) != 0) {
+            printf("  FAIL batch entry %zu\n", i);
+            failed = 1;
+        }
+    }
+
+    /* 私钥 0 没有对应的公钥 */
+    uint8_t zero[64] = {0}, pub[66];
+    memcpy(zero + 32, privs, 32);
+    if (bw_privkeys_to_pubkeys(ctx, zero, 2, pub, NULL) != -1 ||
+        memcmp(pub + 33, pubs_comp, 33) != 0) {
+        printf("  FAIL zero private key\n");
+        failed = 1;
+    }
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+
+    printf("Testing single phrase derivation...\n");
+    failed |= check_single(&ctx);
+
+    printf("Testing batch derivation...\n");
+    failed |= check_batch(&ctx);
+
+    bw_ctx_free(&ctx);
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
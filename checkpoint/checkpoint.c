@@ -0,0 +1,118 @@
+/*
+ * checkpoint.c
+ *
+ * 检查点状态文件的读写。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#include "checkpoint.h"
+
+int checkpoint_save(const char *path, const CHECKPOINT *cp) {
+    size_t plen = strlen(path);
+    char *tmp = (char *)malloc(plen + 5);
+    if (tmp == NULL)
+        return -1;
+    memcpy(tmp, path, plen);
+    memcpy(tmp + plen, ".tmp", 5);
+
+    FILE *fp = fopen(tmp, "w");
+    if (fp == NULL) {
+        free(tmp);
+        return -1;
+    }
+    fprintf(fp, "%s %d\n", CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    fprintf(fp, "source %d\n", (int)cp->source);
+    fprintf(fp, "size %" PRIu64 "\n", cp->size);
+    fprintf(fp, "iterations %" PRIu64 "\n", cp->iterations);
+    fprintf(fp, "shard %u %u %u\n", cp->shard_mode, cp->shard_index, cp->shard_count);
+    fprintf(fp, "phrases %" PRIu64 "\n", cp->phrases);
+    fprintf(fp, "hits %" PRIu64 "\n", cp->hits);
+    fprintf(fp, "output %" PRIu64 "\n", cp->output);
+    fprintf(fp, "ranges %zu\n", cp->nranges);
+    for (size_t i = 0; i < cp->nranges; i++)
+        fprintf(fp, "%" PRIu64 " %" PRIu64 "\n", cp->ranges[i].begin, cp->ranges[i].end);
+
+    /* 数据落盘后再重命名，崩溃时不会留下半个状态文件 */
+    int ret = fflush(fp) == 0 && fsync(fileno(fp)) == 0 ? 0 : -1;
+    int saved = errno;
+    if (fclose(fp) != 0 && ret == 0) {
+        ret = -1;
+        saved = errno;
+    }
+    if (ret == 0 && rename(tmp, path) != 0) {
+        ret = -1;
+        saved = errno;
+    }
+    if (ret != 0)
+        unlink(tmp);
+    free(tmp);
+    errno = saved;
+    return ret;
+}
+
+/* 读取 "name 值" 一行 */
+static int read_field(FILE *fp, const char *name, uint64_t *value) {
+    char key[32];
+    return fscanf(fp, "%31s %" SCNu64, key, value) == 2 && strcmp(key, name) == 0 ? 0 : -1;
+}
+
+int checkpoint_load(const char *path, CHECKPOINT *cp) {
+    memset(cp, 0, sizeof(*cp));
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+        return -1;
+
+    char magic[32];
+    int version;
+    uint64_t source, nranges;
+    int ret = -2;
+    if (fscanf(fp, "%31s %d", magic, &version) != 2 || strcmp(magic, CHECKPOINT_MAGIC) != 0 ||
+        version < 1 || version > CHECKPOINT_VERSION)
+        goto out;
+    if (read_field(fp, "source", &source) != 0 || source > CHECKPOINT_SOURCE_INDEX ||
+        read_field(fp, "size", &cp->size) != 0 ||
+        read_field(fp, "iterations", &cp->iterations) != 0)
+        goto out;
+    cp->shard_count = 1;
+    if (version >= 2 && (fscanf(fp, " shard %" SCNu32 " %" SCNu32 " %" SCNu32, &cp->shard_mode,
+                                &cp->shard_index, &cp->shard_count) != 3 ||
+                         cp->shard_count == 0 || cp->shard_index >= cp->shard_count))
+        goto out;
+    if (read_field(fp, "phrases", &cp->phrases) != 0 ||
+        read_field(fp, "hits", &cp->hits) != 0 ||
+        read_field(fp, "output", &cp->output) != 0 ||
+        read_field(fp, "ranges", &nranges) != 0 || nranges > SIZE_MAX / sizeof(CHECKPOINT_RANGE))
+        goto out;
+    cp->source = (CHECKPOINT_SOURCE)source;
+    if (nranges > 0) {
+        cp->ranges = (CHECKPOINT_RANGE *)malloc(nranges * sizeof(CHECKPOINT_RANGE));
+        if (cp->ranges == NULL)
+            goto out;
+    }
+    /* 区间必须非空、有序且互不重叠 */
+    for (uint64_t i = 0; i < nranges; i++) {
+        CHECKPOINT_RANGE *r = &cp->ranges[i];
+        if (fscanf(fp, "%" SCNu64 " %" SCNu64, &r->begin, &r->end) != 2 || r->begin >= r->end ||
+            (i > 0 && r->begin < cp->ranges[i - 1].end))
+            goto out;
+        cp->nranges++;
+    }
+    ret = 0;
+out:
+    fclose(fp);
+    if (ret != 0)
+        checkpoint_free(cp);
+    return ret;
+}
+
+void checkpoint_free(CHECKPOINT *cp) {
+    free(cp->ranges);
+    cp->ranges = NULL;
+    cp->nranges = 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * checkpoint.h
+ *
+ * 长时间扫描的检查点：记录尚未完成的输入区间与累计计数，原子地写入状态文件，
+ * 重启后据此从上一个安全点继续。
+ *
+ * 进度用“剩余区间”表示：每个区间 [begin, end) 是输入中还没有写出结果的一段，
+ * 单位为字节偏移（词表、逐行输入）或生成器序号（组合）。各线程的区间起点即其进度水位；
+ * 水位之后已经乱序完成的段被从区间中挖去，因此恢复时不会重复输出。
+ *
+ * 文件为文本格式，便于查看：
+ *     brainwallet-checkpoint 2
+ *     source 1
+ *     size 1048576
+ *     iterations 1
+ *     shard 0 3 8
+ *     phrases 81920
+ *     hits 2
+ *     output 655360
+ *     ranges 2
+ *     524288 786432
+ *     802816 1048576
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHECKPOINT_MAGIC "brainwallet-checkpoint"
+#define CHECKPOINT_VERSION 2   /* 版本 1 没有 shard 行，读取时视为不分片 */
+
+/* 区间的单位与含义 */
+typedef enum {
+    CHECKPOINT_SOURCE_LINES = 0,    /* 逐行读取的流，字节偏移，size 为 0（未知） */
+    CHECKPOINT_SOURCE_WORDLIST,     /* 映射词表，字节偏移，size 为文件大小 */
+    CHECKPOINT_SOURCE_INDEX         /* 生成器，序号，size 为序号总数 */
+} CHECKPOINT_SOURCE;
+
+typedef struct checkpoint_range {
+    uint64_t begin;
+    uint64_t end;
+} CHECKPOINT_RANGE;
+
+typedef struct checkpoint {
+    CHECKPOINT_SOURCE source;
+    uint64_t size;          /* 输入大小或序号总数，恢复时用于核对输入未变 */
+    uint64_t iterations;
+    uint32_t shard_mode;    /* 分片方式、本节点的分片序号与分片总数，不分片时为 0 0 1 */
+    uint32_t shard_index;
+    uint32_t shard_count;
+    uint64_t phrases;       /* 累计推导并写出的短语数 */
+    uint64_t hits;          /* 累计命中数 */
+    uint64_t output;        /* 累计写出的字节数（含二进制文件头） */
+    size_t nranges;         /* 剩余区间数，0 表示已全部完成 */
+    CHECKPOINT_RANGE *ranges;
+} CHECKPOINT;
+
+/**
+ * checkpoint_save - 原子地写入状态文件
+ *
+ * 先写入 path.tmp 并 fsync，再重命名为 path，任何时刻 path 都是完整的旧状态或新状态。
+ * 成功返回 0，失败返回 -1（errno 有效）。
+ */
+int checkpoint_save(const char *path, const CHECKPOINT *cp);
+
+/*
+ * 读取状态文件，ranges 由 checkpoint_free 释放。
+ * 成功返回 0；无法打开返回 -1（errno 有效）；格式错误返回 -2。
+ */
+int checkpoint_load(const char *path, CHECKPOINT *cp);
+
+void checkpoint_free(CHECKPOINT *cp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKPOINT_H */
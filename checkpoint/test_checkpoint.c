@@ -0,0 +1,96 @@
+// gcc -O2 -o test_checkpoint test_checkpoint.c checkpoint.c
+// ./test_checkpoint
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "checkpoint.h"
+
+static int failures = 0;
+
+static void check(int cond, const char *what) {
+    if (!cond) {
+        printf("  FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static int write_file(const char *path, const char *data) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL)
+        return -1;
+    fputs(data, fp);
+    return fclose(fp);
+}
+
+static void test_round_trip(void) {
+    printf("Testing checkpoint_save / checkpoint_load...\n");
+    char dir[] = "/tmp/test_checkpoint_XXXXXX";
+    check(mkdtemp(dir) != NULL, "mkdtemp");
+    char path[64], tmp[64];
+    snprintf(path, sizeof(path), "%s/state", dir);
+    snprintf(tmp, sizeof(tmp), "%s/state.tmp", dir);
+
+    CHECKPOINT_RANGE ranges[] = { { 100, 200 }, { 300, 301 }, { 4096, UINT64_MAX } };
+    CHECKPOINT cp = { CHECKPOINT_SOURCE_WORDLIST, 1ULL << 40, 3, 1, 5, 8, 12345, 7, 999, 3, ranges };
+    check(checkpoint_save(path, &cp) == 0, "save");
+    check(access(tmp, F_OK) != 0, "temporary file renamed");
+
+    CHECKPOINT got;
+    check(checkpoint_load(path, &got) == 0, "load");
+    check(got.source == CHECKPOINT_SOURCE_WORDLIST && got.size == (1ULL << 40) && got.iterations == 3 &&
+          got.shard_mode == 1 && got.shard_index == 5 && got.shard_count == 8 &&
+          got.phrases == 12345 && got.hits == 7 && got.output == 999, "fields");
+    check(got.nranges == 3 && memcmp(got.ranges, ranges, sizeof(ranges)) == 0, "ranges");
+    checkpoint_free(&got);
+
+    /* 覆盖写入，全部完成时没有区间 */
+    cp.nranges = 0;
+    cp.phrases = 20000;
+    check(checkpoint_save(path, &cp) == 0, "overwrite");
+    check(checkpoint_load(path, &got) == 0 && got.nranges == 0 && got.ranges == NULL && got.phrases == 20000,
+          "empty ranges");
+    checkpoint_free(&got);
+
+    /* 版本 1 没有 shard 行，视为不分片 */
+    check(write_file(path, "brainwallet-checkpoint 1\nsource 2\nsize 10\niterations 1\nphrases 4\nhits 0\n"
+                           "output 40\nranges 1\n4 10\n") == 0, "write v1");
+    check(checkpoint_load(path, &got) == 0 && got.shard_count == 1 && got.shard_index == 0 &&
+          got.nranges == 1 && got.ranges[0].begin == 4, "version 1");
+    checkpoint_free(&got);
+
+    /* 格式错误：魔数、版本、截断、分片越界、区间无序或为空 */
+    static const char *bad[] = {
+        "something-else 1\n",
+        "brainwallet-checkpoint 3\nsource 0\nsize 0\niterations 1\nshard 0 0 1\nphrases 0\nhits 0\noutput 0\nranges 0\n",
+        "brainwallet-checkpoint 2\nsource 0\nsize 0\niterations 1\n",
+        "brainwallet-checkpoint 2\nsource 0\nsize 0\niterations 1\nshard 0 4 4\nphrases 0\nhits 0\noutput 0\nranges 0\n",
+        "brainwallet-checkpoint 2\nsource 0\nsize 0\niterations 1\nshard 0 0 1\nphrases 0\nhits 0\noutput 0\nranges 2\n5 9\n",
+        "brainwallet-checkpoint 2\nsource 0\nsize 0\niterations 1\nshard 0 0 1\nphrases 0\nhits 0\noutput 0\nranges 2\n5 9\n8 12\n",
+        "brainwallet-checkpoint 2\nsource 0\nsize 0\niterations 1\nshard 0 0 1\nphrases 0\nhits 0\noutput 0\nranges 1\n5 5\n",
+        "brainwallet-checkpoint 2\nsource 9\nsize 0\niterations 1\nshard 0 0 1\nphrases 0\nhits 0\noutput 0\nranges 0\n",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        check(write_file(path, bad[i]) == 0, "write bad");
+        if (checkpoint_load(path, &got) != -2) {
+            printf("  FAIL malformed file %zu accepted\n", i);
+            failures++;
+        }
+    }
+
+    unlink(path);
+    check(checkpoint_load(path, &got) == -1, "missing file");
+    rmdir(dir);
+}
+
+int main(void) {
+    test_round_trip();
+    if (failures) {
+        printf("%d test(s) failed.\n", failures);
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
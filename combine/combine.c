@@ -0,0 +1,148 @@
+/*
+ * combine.c
+ *
+ * 多词组合生成器的实现。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "combine.h"
+
+/* 建立词表的行索引：先数行再填充，两遍都只扫描映射 */
+static int dict_index(COMBINE_DICT *dict) {
+    WORDLIST_CURSOR cur;
+    const char *line;
+    size_t len, n = 0;
+    wordlist_cursor_init(&cur, &dict->wl, 0, dict->wl.size);
+    while (wordlist_next(&cur, &line, &len))
+        n++;
+    if (n == 0)
+        return 0;
+    dict->words = (const char **)malloc(n * sizeof(const char *));
+    dict->lens = (size_t *)malloc(n * sizeof(size_t));
+    if (dict->words == NULL || dict->lens == NULL)
+        return -1;
+    wordlist_cursor_init(&cur, &dict->wl, 0, dict->wl.size);
+    while (dict->count < n && wordlist_next(&cur, &line, &len)) {
+        dict->words[dict->count] = line;
+        dict->lens[dict->count] = len;
+        dict->count++;
+    }
+    return 0;
+}
+
+int combinator_open(COMBINATOR *comb, const char *const *paths, size_t ndicts, const char *sep) {
+    memset(comb, 0, sizeof(*comb));
+    if (ndicts < 2 || ndicts > COMBINE_MAX_DICTS) {
+        fprintf(stderr, "Error: 组合需要 2 到 %d 个词表\n", COMBINE_MAX_DICTS);
+        return -1;
+    }
+    comb->sep = sep;
+    comb->sep_len = strlen(sep);
+    comb->total = 1;
+    for (size_t d = 0; d < ndicts; d++) {
+        COMBINE_DICT *dict = &comb->dicts[d];
+        if (wordlist_open(&dict->wl, paths[d]) != 0) {
+            if (errno == ESPIPE)
+                fprintf(stderr, "Error: 组合词表 %s 必须是普通文件\n", paths[d]);
+            else
+                fprintf(stderr, "Error: 无法打开组合词表 %s\n", paths[d]);
+            combinator_close(comb);
+            return -1;
+        }
+        comb->ndicts = d + 1;
+        if (dict_index(dict) != 0) {
+            fprintf(stderr, "Error: 内存分配失败\n");
+            combinator_close(comb);
+            return -1;
+        }
+        if (dict->count == 0) {
+            fprintf(stderr, "Error: 组合词表 %s 为空\n", paths[d]);
+            combinator_close(comb);
+            return -1;
+        }
+        if (comb->total > UINT64_MAX / dict->count) {
+            fprintf(stderr, "Error: 组合数超出 64 位范围\n");
+            combinator_close(comb);
+            return -1;
+        }
+        comb->total *= dict->count;
+    }
+    return 0;
+}
+
+void combinator_close(COMBINATOR *comb) {
+    for (size_t d = 0; d < comb->ndicts; d++) {
+        free(comb->dicts[d].words);
+        free(comb->dicts[d].lens);
+        wordlist_close(&comb->dicts[d].wl);
+    }
+    memset(comb, 0, sizeof(*comb));
+}
+
+/* 追加一段文本；超出缓冲区时只推进位置，该组合随后被跳过 */
+static inline size_t cursor_put(COMBINE_CURSOR *cur, size_t pos, const char *s, size_t n) {
+    if (pos + n <= COMBINE_MAX_LEN)
+        memcpy(cur->phrase + pos, s, n);
+    return pos + n;
+}
+
+/* 从第 from 个词起重建短语，之前的部分保持不变 */
+static void cursor_fill(COMBINE_CURSOR *cur, size_t from) {
+    const COMBINATOR *comb = cur->comb;
+    size_t pos = cur->starts[from];
+    for (size_t d = from; d < comb->ndicts; d++) {
+        const COMBINE_DICT *dict = &comb->dicts[d];
+        cur->starts[d] = pos;
+        if (d > 0)
+            pos = cursor_put(cur, pos, comb->sep, comb->sep_len);
+        pos = cursor_put(cur, pos, dict->words[cur->digits[d]], dict->lens[cur->digits[d]]);
+    }
+    cur->starts[comb->ndicts] = pos;
+}
+
+void combine_cursor_init(COMBINE_CURSOR *cur, const COMBINATOR *comb, uint64_t begin, uint64_t end) {
+    cur->comb = comb;
+    cur->index = begin;
+    cur->end = end < comb->total ? end : comb->total;
+    cur->advance = 0;
+    if (cur->index >= cur->end)
+        return;
+    /* 把序号分解为各词表的词序号，最后一个词表为最低位 */
+    uint64_t rest = begin;
+    for (size_t d = comb->ndicts; d-- > 0;) {
+        cur->digits[d] = (size_t)(rest % comb->dicts[d].count);
+        rest /= comb->dicts[d].count;
+    }
+    cur->starts[0] = 0;
+    cursor_fill(cur, 0);
+}
+
+int combine_next(COMBINE_CURSOR *cur, const char **phrase, size_t *len, uint64_t *index) {
+    const COMBINATOR *comb = cur->comb;
+    while (cur->index < cur->end) {
+        if (cur->advance) {
+            /* 末位加一并进位，从最高的变化位重建 */
+            size_t d = comb->ndicts - 1;
+            while (++cur->digits[d] == comb->dicts[d].count && d > 0) {
+                cur->digits[d] = 0;
+                d--;
+            }
+            cursor_fill(cur, d);
+        }
+        cur->advance = 1;
+        uint64_t i = cur->index++;
+        size_t n = cur->starts[comb->ndicts];
+        if (n > COMBINE_MAX_LEN)
+            continue;
+        *phrase = cur->phrase;
+        *len = n;
+        if (index != NULL)
+            *index = i;
+        return 1;
+    }
+    return 0;
+}
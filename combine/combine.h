@@ -0,0 +1,80 @@
+/*
+ * combine.h
+ *
+ * 多词组合生成器：从 2 到 COMBINE_MAX_DICTS 个词表各取一个词，以分隔符连接成短语，
+ * 枚举全部组合（笛卡尔积）而不把结果写成文本。
+ *
+ * 组合按混合进制编号：序号 i 的各位依次是各词表中的词序号，最后一个词表变化最快。
+ * 相邻序号的短语只有末尾的词不同，共享最长的前缀；按序号顺序成批推导时，
+ * sha256_cached 对前缀中完整的 64 字节块直接复用中间状态。
+ * 任意序号都可以直接定位，因此序号区间可以独立分给各线程。
+ */
+
+#ifndef COMBINE_H
+#define COMBINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../wordlist/wordlist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMBINE_MAX_DICTS 3     /* 最多组合的词表数 */
+#define COMBINE_MAX_LEN 256     /* 组合短语的最大长度，超出的组合被跳过 */
+
+typedef struct combine_dict {
+    WORDLIST wl;
+    const char **words;     /* 指向映射中的行，不以 '\0' 结尾 */
+    size_t *lens;
+    size_t count;
+} COMBINE_DICT;
+
+typedef struct combinator {
+    size_t ndicts;
+    COMBINE_DICT dicts[COMBINE_MAX_DICTS];
+    const char *sep;
+    size_t sep_len;
+    uint64_t total;         /* 组合总数，各词表词数之积 */
+} COMBINATOR;
+
+/**
+ * combinator_open - 映射词表并建立词索引
+ *
+ * @paths: ndicts 个词表路径（须为普通文件），空行被忽略，行尾 \r 被去掉
+ * @sep:   词之间的分隔符，调用者保证在 combinator_close 之前有效
+ *
+ * 成功返回 0；打开失败、词表为空或组合数超过 2^64 - 1 时输出错误信息并返回 -1。
+ */
+int combinator_open(COMBINATOR *comb, const char *const *paths, size_t ndicts, const char *sep);
+void combinator_close(COMBINATOR *comb);
+
+/*
+ * 在序号区间 [begin, end) 上顺序生成组合。短语保存在游标内部，递增时只重写
+ * 发生变化的词及其后部分。
+ */
+typedef struct combine_cursor {
+    const COMBINATOR *comb;
+    uint64_t index;
+    uint64_t end;
+    int advance;                            /* 取下一条前是否需要先递增 */
+    size_t digits[COMBINE_MAX_DICTS];       /* 当前组合在各词表中的词序号 */
+    size_t starts[COMBINE_MAX_DICTS + 1];   /* 各词（含前面的分隔符）在短语中的起点，最后一项为总长 */
+    char phrase[COMBINE_MAX_LEN];
+} COMBINE_CURSOR;
+
+void combine_cursor_init(COMBINE_CURSOR *cur, const COMBINATOR *comb, uint64_t begin, uint64_t end);
+
+/*
+ * 取下一条组合：*phrase 指向游标内部的缓冲区，在下次调用前有效；
+ * index 非 NULL 时写入组合序号。区间结束返回 0。
+ */
+int combine_next(COMBINE_CURSOR *cur, const char **phrase, size_t *len, uint64_t *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMBINE_H */
@@ -0,0 +1,144 @@
+// gcc -O2 -o test_combine test_combine.c combine.c ../wordlist/wordlist.c
+// ./test_combine
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "combine.h"
+
+static int failures = 0;
+
+static void check(int cond, const char *what) {
+    if (!cond) {
+        printf("  FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static int make_file(char *path, const char *data) {
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return -1;
+    size_t len = strlen(data);
+    int ok = write(fd, data, len) == (ssize_t)len;
+    close(fd);
+    return ok ? 0 : -1;
+}
+
+static const char *A[] = { "red", "green" };
+static const char *B[] = { "cat", "dog", "fox" };
+static const char *C[] = { "1", "22" };
+
+/* 按定义逐条拼出第 i 个组合 */
+static size_t expect_phrase(uint64_t i, const char *sep, char *out) {
+    size_t c = i % 2, b = (i / 2) % 3, a = i / 6;
+    return (size_t)sprintf(out, "%s%s%s%s%s", A[a], sep, B[b], sep, C[c]);
+}
+
+static void test_enumerate(void) {
+    printf("Testing combine_next...\n");
+    char pa[] = "/tmp/test_combine_a_XXXXXX";
+    char pb[] = "/tmp/test_combine_b_XXXXXX";
+    char pc[] = "/tmp/test_combine_c_XXXXXX";
+    check(make_file(pa, "red\r\n\ngreen\n") == 0, "write a");
+    check(make_file(pb, "cat\ndog\nfox") == 0, "write b");
+    check(make_file(pc, "1\n22\n") == 0, "write c");
+
+    const char *paths[] = { pa, pb, pc };
+    COMBINATOR comb;
+    check(combinator_open(&comb, paths, 3, " + ") == 0, "open");
+    check(comb.total == 12, "total");
+
+    /* 任意起点的区间与逐条拼接一致，区间拼起来覆盖全部序号 */
+    const char *phrase;
+    size_t len;
+    uint64_t index;
+    char want[64];
+    for (uint64_t begin = 0; begin <= comb.total; begin++) {
+        for (uint64_t end = begin; end <= comb.total + 1; end++) {
+            COMBINE_CURSOR cur;
+            combine_cursor_init(&cur, &comb, begin, end);
+            uint64_t next = begin;
+            while (combine_next(&cur, &phrase, &len, &index)) {
+                size_t n = expect_phrase(next, " + ", want);
+                if (index != next || len != n || memcmp(phrase, want, n) != 0) {
+                    check(0, "phrase at index");
+                    goto done;
+                }
+                next++;
+            }
+            uint64_t last = end < comb.total ? end : comb.total;
+            if (next != (begin > last ? begin : last)) {
+                check(0, "range end");
+                goto done;
+            }
+        }
+    }
+done:
+    combinator_close(&comb);
+
+    /* 两个词表、空分隔符 */
+    check(combinator_open(&comb, paths, 2, "") == 0, "open two");
+    COMBINE_CURSOR cur;
+    combine_cursor_init(&cur, &comb, 4, comb.total);
+    check(combine_next(&cur, &phrase, &len, NULL) && len == 8 && memcmp(phrase, "greendog", 8) == 0, "two dicts");
+    combinator_close(&comb);
+
+    /* 单个词表与空词表被拒绝 */
+    check(combinator_open(&comb, paths, 1, " ") != 0, "one dict rejected");
+    char pe[] = "/tmp/test_combine_e_XXXXXX";
+    check(make_file(pe, "\n\r\n") == 0, "write empty");
+    const char *empty[] = { pa, pe };
+    check(combinator_open(&comb, empty, 2, " ") != 0, "empty dict rejected");
+
+    unlink(pa);
+    unlink(pb);
+    unlink(pc);
+    unlink(pe);
+}
+
+/* 超过 COMBINE_MAX_LEN 的组合被跳过，其后的组合不受影响 */
+static void test_overlong(void) {
+    printf("Testing overlong combinations...\n");
+    char long_word[COMBINE_MAX_LEN + 2];
+    memset(long_word, 'w', COMBINE_MAX_LEN);
+    long_word[COMBINE_MAX_LEN] = '\n';
+    long_word[COMBINE_MAX_LEN + 1] = '\0';
+    char text[COMBINE_MAX_LEN + 16];
+    snprintf(text, sizeof(text), "a\n%sb\n", long_word);
+
+    char pa[] = "/tmp/test_combine_l_XXXXXX";
+    check(make_file(pa, text) == 0, "write long");
+    const char *paths[] = { pa, pa };
+    COMBINATOR comb;
+    check(combinator_open(&comb, paths, 2, " ") == 0, "open long");
+    check(comb.total == 9, "long total");
+
+    COMBINE_CURSOR cur;
+    const char *phrase;
+    size_t len;
+    uint64_t index, seen[9];
+    size_t n = 0;
+    combine_cursor_init(&cur, &comb, 0, comb.total);
+    while (n < 9 && combine_next(&cur, &phrase, &len, &index))
+        seen[n++] = index;
+    /* 只有两个短词的组合：0 (a a)、2 (a b)、6 (b a)、8 (b b) */
+    check(n == 4 && seen[0] == 0 && seen[1] == 2 && seen[2] == 6 && seen[3] == 8, "overlong skipped");
+    combine_cursor_init(&cur, &comb, 8, comb.total);
+    check(combine_next(&cur, &phrase, &len, NULL) && len == 3 && memcmp(phrase, "b b", 3) == 0, "after overlong");
+    combinator_close(&comb);
+    unlink(pa);
+}
+
+int main(void) {
+    test_enumerate();
+    test_overlong();
+    if (failures) {
+        printf("%d test(s) failed.\n", failures);
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
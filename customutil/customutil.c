@@ -41,47 +41,81 @@ void print_hex(const char *label, const uint8_t *data, size_t len) {
     printf("\n");
 }
 
+/*
+ * 坐标写为 32 字节大端整数，高位补零。
+ * 64 位 limb 时直接从 mpz 的 limb 数组按字节序翻转写出，省去 mpz_export 的通用路径。
+ */
+static void export_coordinate(const mpz_t v, uint8_t out[32]) {
+#if GMP_LIMB_BITS == 64 && GMP_NAIL_BITS == 0
+    size_t n = mpz_size(v);
+    for (size_t i = 0; i < 4; i++) {
+        uint64_t limb = i < n ? (uint64_t)mpz_getlimbn(v, i) : 0;
+        limb = __builtin_bswap64(limb);
+        memcpy(out + 24 - 8 * i, &limb, 8);
+    }
+#else
+    size_t n = (mpz_sizeinbase(v, 2) + 7) / 8;
+    memset(out, 0, 32);
+    if (n <= 32)
+        mpz_export(out + 32 - n, NULL, 1, 1, 1, 0, v);
+#endif
+}
+
 /*---------------------------
-  生成公钥的 16 进制字符串表示
-  对于压缩格式：如果 y 的最低位为 0，则前缀为 "02"，否则为 "03"；输出 x 坐标的 16 进制字符串；
-  对于非压缩格式：前缀 "04" 后跟 x 和 y 坐标的 16 进制字符串。
+  生成公钥的二进制序列化
+  压缩格式：前缀 0x02（y 为偶数）或 0x03，后跟 32 字节 x；
+  非压缩格式：前缀 0x04，后跟 32 字节 x 与 32 字节 y；
+  x-only：仅 32 字节 x。
 ---------------------------*/
-void generate_strpublickey(struct Point *publickey, bool compress, char *dst) {
-    memset(dst, 0, compress ? 67 : 131);
+void generate_binpublickey(const struct Point *publickey, bool compress, uint8_t *dst) {
+    export_coordinate(publickey->x, dst + 1);
     if (compress) {
-        if (mpz_tstbit(publickey->y, 0) == 0)
-            gmp_snprintf(dst, 67, "02%0.64Zx", publickey->x);
-        else
-            gmp_snprintf(dst, 67, "03%0.64Zx", publickey->x);
+        dst[0] = mpz_tstbit(publickey->y, 0) == 0 ? 0x02 : 0x03;
     } else {
-        gmp_snprintf(dst, 131, "04%0.64Zx%0.64Zx", publickey->x, publickey->y);
+        dst[0] = 0x04;
+        export_coordinate(publickey->y, dst + 33);
+    }
+}
+
+void generate_xonlypublickey(const struct Point *publickey, uint8_t *dst) {
+    export_coordinate(publickey->x, dst);
+}
+
+void generate_binpublickeys(const struct Point *publickeys, size_t count, bool compress, uint8_t *dst) {
+    size_t len = compress ? 33 : 65;
+    for (size_t i = 0; i < count; i++) {
+        generate_binpublickey(&publickeys[i], compress, dst + i * len);
+    }
+}
+
+void generate_xonlypublickeys(const struct Point *publickeys, size_t count, uint8_t *dst) {
+    for (size_t i = 0; i < count; i++) {
+        export_coordinate(publickeys[i].x, dst + i * 32);
     }
 }
 
+/*---------------------------
+  生成公钥的 16 进制字符串表示：二进制序列化后再做十六进制编码
+  对于压缩格式：如果 y 的最低位为 0，则前缀为 "02"，否则为 "03"；输出 x 坐标的 16 进制字符串；
+  对于非压缩格式：前缀 "04" 后跟 x 和 y 坐标的 16 进制字符串。
+---------------------------*/
+void generate_strpublickey(struct Point *publickey, bool compress, char *dst) {
+    uint8_t bin[65];
+    generate_binpublickey(publickey, compress, bin);
+    hex_encode(dst, bin, compress ? 33 : 65);
+}
+
 /*---------------------------
   将十六进制字符串转换为二进制数据
 ---------------------------*/
 int hexs2bin(const char *hex, unsigned char *out) {
-    int len;
-    char b1, b2;
-    int i;
-
     if (hex == NULL || *hex == '\0' || out == NULL)
         return 0;
 
-    len = strlen(hex);
-    if (len % 2 != 0)
+    size_t len = strlen(hex);
+    if (hex_decode(out, hex, len) != 0)
         return 0;
-    len /= 2;
-
-    memset(out, 0, len);
-    for (i = 0; i < len; i++) {
-        if (!hexchr2bin(hex[i*2], &b1) || !hexchr2bin(hex[i*2+1], &b2)) {
-            return 0;
-        }
-        out[i] = (b1 << 4) | b2;
-    }
-    return len;
+    return (int)(len / 2);
 }
 
 /*---------------------------
@@ -191,28 +225,14 @@ void freetokenizer(Tokenizer *t) {
 
 /* 将数据转换为十六进制字符串，返回新分配的缓冲区，调用者负责释放 */
 char *tohex(char *ptr, int length) {
-    char *buffer;
-    int offset = 0;
-    unsigned char c;
-    buffer = (char *) malloc((length * 2) + 1);
-    for (int i = 0; i < length; i++) {
-        c = ptr[i];
-        sprintf(buffer + offset, "%.2x", c);
-        offset += 2;
-    }
-    buffer[length * 2] = '\0';
+    char *buffer = (char *) malloc((length * 2) + 1);
+    if (buffer != NULL)
+        hex_encode(buffer, (const uint8_t *)ptr, length);
     return buffer;
 }
 
 void tohex_dst(char *ptr, int length, char *dst) {
-    int offset = 0;
-    unsigned char c;
-    for (int i = 0; i < length; i++) {
-        c = ptr[i];
-        sprintf(dst + offset, "%.2x", c);
-        offset += 2;
-    }
-    dst[length * 2] = '\0';
+    hex_encode(dst, (const uint8_t *)ptr, length);
 }
 
 /* List 函数实现 */
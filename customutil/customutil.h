@@ -36,7 +36,7 @@
 void print_hex(const char *label, const uint8_t *data, size_t len);
 
 /**
- * generate_strpublickey - 生成公钥的十六进制字符串表示
+ * generate_strpublickey - 生成公钥的十六进制字符串表示（generate_binpublickey 的结果再做十六进制编码）
  *
  * @publickey: 输入 ECC 公钥（使用 struct Point*）
  * @compress: 如果为 true，则生成压缩格式；否则生成非压缩格式
@@ -45,6 +45,22 @@ void print_hex(const char *label, const uint8_t *data, size_t len);
 void generate_strpublickey(struct Point *publickey, bool compress, char *dst);
 
 
+/**
+ * generate_binpublickey - 生成公钥的二进制序列化
+ *
+ * @publickey: 输入 ECC 公钥
+ * @compress: 为 true 时写 33 字节压缩格式，否则写 65 字节非压缩格式
+ * @dst: 输出缓冲区（33 或 65 字节）
+ */
+void generate_binpublickey(const struct Point *publickey, bool compress, uint8_t *dst);
+
+/* 写 32 字节 x-only 公钥（仅 x 坐标） */
+void generate_xonlypublickey(const struct Point *publickey, uint8_t *dst);
+
+/* 批量版本：第 i 个点写到 dst + i * (33、65 或 32) 处 */
+void generate_binpublickeys(const struct Point *publickeys, size_t count, bool compress, uint8_t *dst);
+void generate_xonlypublickeys(const struct Point *publickeys, size_t count, uint8_t *dst);
+
 /**
  * hexs2bin - 将十六进制字符串转换为二进制数据
  *
@@ -55,6 +71,26 @@ void generate_strpublickey(struct Point *publickey, bool compress, char *dst);
  */
 int hexs2bin(const char *hex, unsigned char *out);
 
+/**
+ * hex_encode - 将二进制数据编码为小写十六进制字符串（SSSE3/AVX2 加速）
+ *
+ * @dst: 输出缓冲区，至少 len * 2 + 1 字节，结果以 '\0' 结尾
+ * @src: 输入数据
+ * @len: 输入字节数
+ */
+void hex_encode(char *dst, const uint8_t *src, size_t len);
+
+/**
+ * hex_decode - 将十六进制字符串（大小写均可）解码为二进制数据（SSSE3/AVX2 加速）
+ *
+ * @dst: 输出缓冲区，至少 hex_len / 2 字节
+ * @hex: 输入字符串，无需以 '\0' 结尾
+ * @hex_len: 输入字符数，必须为偶数
+ *
+ * 成功返回 0；长度为奇数或含有非十六进制字符时返回 -1，此时 dst 内容未定义。
+ */
+int hex_decode(uint8_t *dst, const char *hex, size_t hex_len);
+
 /* 以下为字符串处理相关工具函数 */
 
 typedef struct str_tokenizer {
@@ -0,0 +1,179 @@
+/*
+ * customutil_simd.c
+ *
+ * 十六进制编码与解码。
+ *
+ * 编码：每个字节拆成高低两个半字节，半字节 n 映射为 n + '0'，n > 9 时再加
+ * 'a' - '0' - 10 = 39；两组字符按字节交错即为输出。
+ * 解码：每个字符分别按数字（c - '0' < 10）和字母（(c | 0x20) - 'a' < 6）
+ * 求值，两者都不成立即为非法字符；相邻两个字符组成 16 位字，
+ * 低字节为高半字节，合并后收窄为 8 位。
+ *
+ * 代码使用 GCC 向量扩展编写，通过 target 属性分别编译为 SSSE3（每次 16 字节输入
+ * 或 32 个字符）与 AVX2（每次 32 字节输入或 64 个字符）版本，运行时按 CPU
+ * 支持情况选择；不足一组的部分逐字节处理。
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "customutil.h"
+
+typedef uint8_t hex_v16u __attribute__((vector_size(16)));
+typedef uint8_t hex_v32u __attribute__((vector_size(32)));
+typedef uint16_t hex_v8w __attribute__((vector_size(16)));
+typedef uint16_t hex_v16w __attribute__((vector_size(32)));
+typedef uint8_t hex_v8u __attribute__((vector_size(8)));
+
+static const char HEX_DIGITS[16] = "0123456789abcdef";
+
+/* 半字节向量转小写十六进制字符 */
+#define HEX_NIBBLE_CHAR(VT, n) ((n) + '0' + ((VT)((n) > 9) & 39))
+
+/*
+ * 字符向量转半字节值，非法字符在 bad 中对应位置置 0xff
+ */
+#define HEX_CHAR_VALUE(VT, c, bad) __extension__ ({                          \
+    VT d_ = (c) - '0';                                                        \
+    VT l_ = ((c) | 0x20) - 'a';                                               \
+    VT is_d_ = (VT)(d_ < 10);                                                 \
+    VT is_l_ = (VT)(l_ < 6);                                                  \
+    (bad) |= ~(is_d_ | is_l_);                                                \
+    (d_ & is_d_) | ((l_ + 10) & is_l_);                                       \
+})
+
+static inline int hex_scalar_value(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static void hex_encode_scalar(char *dst, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[2 * i] = HEX_DIGITS[src[i] >> 4];
+        dst[2 * i + 1] = HEX_DIGITS[src[i] & 15];
+    }
+}
+
+static int hex_decode_scalar(uint8_t *dst, const char *hex, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        int hi = hex_scalar_value(hex[2 * i]);
+        int lo = hex_scalar_value(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0)
+            return -1;
+        dst[i] = (uint8_t)(hi << 4 | lo);
+    }
+    return 0;
+}
+
+__attribute__((target("ssse3")))
+static size_t hex_encode_ssse3(char *dst, const uint8_t *src, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        hex_v16u in, hi, lo;
+        memcpy(&in, src + i, 16);
+        hi = HEX_NIBBLE_CHAR(hex_v16u, in >> 4);
+        lo = HEX_NIBBLE_CHAR(hex_v16u, in & 15);
+        hex_v16u a = __builtin_shuffle(hi, lo, (hex_v16u){ 0, 16, 1, 17, 2, 18, 3, 19,
+                                                            4, 20, 5, 21, 6, 22, 7, 23 });
+        hex_v16u b = __builtin_shuffle(hi, lo, (hex_v16u){ 8, 24, 9, 25, 10, 26, 11, 27,
+                                                            12, 28, 13, 29, 14, 30, 15, 31 });
+        memcpy(dst + 2 * i, &a, 16);
+        memcpy(dst + 2 * i + 16, &b, 16);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t hex_encode_avx2(char *dst, const uint8_t *src, size_t len) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        hex_v32u in, hi, lo;
+        memcpy(&in, src + i, 32);
+        hi = HEX_NIBBLE_CHAR(hex_v32u, in >> 4);
+        lo = HEX_NIBBLE_CHAR(hex_v32u, in & 15);
+        hex_v32u a = __builtin_shuffle(hi, lo, (hex_v32u){ 0, 32, 1, 33, 2, 34, 3, 35,
+                                                            4, 36, 5, 37, 6, 38, 7, 39,
+                                                            8, 40, 9, 41, 10, 42, 11, 43,
+                                                            12, 44, 13, 45, 14, 46, 15, 47 });
+        hex_v32u b = __builtin_shuffle(hi, lo, (hex_v32u){ 16, 48, 17, 49, 18, 50, 19, 51,
+                                                            20, 52, 21, 53, 22, 54, 23, 55,
+                                                            24, 56, 25, 57, 26, 58, 27, 59,
+                                                            28, 60, 29, 61, 30, 62, 31, 63 });
+        memcpy(dst + 2 * i, &a, 32);
+        memcpy(dst + 2 * i + 32, &b, 32);
+    }
+    return i;
+}
+
+/* 每次 32 个字符：两个 16 字节向量各得 8 字节 */
+__attribute__((target("ssse3")))
+static size_t hex_decode_ssse3(uint8_t *dst, const char *hex, size_t len, int *bad_out) {
+    size_t i = 0;
+    hex_v16u bad = { 0 };
+    for (; i + 16 <= len; i += 16) {
+        for (int h = 0; h < 2; h++) {
+            hex_v16u c;
+            memcpy(&c, hex + 2 * i + 16 * h, 16);
+            hex_v16u v = HEX_CHAR_VALUE(hex_v16u, c, bad);
+            hex_v8w w = (hex_v8w)v;
+            w = (w & 0xff) << 4 | w >> 8;
+            hex_v8u out = __builtin_convertvector(w, hex_v8u);
+            memcpy(dst + i + 8 * h, &out, 8);
+        }
+    }
+    uint64_t any[2];
+    memcpy(any, &bad, 16);
+    *bad_out = (any[0] | any[1]) != 0;
+    return i;
+}
+
+/* 每次 64 个字符：两个 32 字节向量各得 16 字节 */
+__attribute__((target("avx2")))
+static size_t hex_decode_avx2(uint8_t *dst, const char *hex, size_t len, int *bad_out) {
+    size_t i = 0;
+    hex_v32u bad = { 0 };
+    for (; i + 32 <= len; i += 32) {
+        for (int h = 0; h < 2; h++) {
+            hex_v32u c;
+            memcpy(&c, hex + 2 * i + 32 * h, 32);
+            hex_v32u v = HEX_CHAR_VALUE(hex_v32u, c, bad);
+            hex_v16w w = (hex_v16w)v;
+            w = (w & 0xff) << 4 | w >> 8;
+            hex_v16u out = __builtin_convertvector(w, hex_v16u);
+            memcpy(dst + i + 16 * h, &out, 16);
+        }
+    }
+    uint64_t any[4];
+    memcpy(any, &bad, 32);
+    *bad_out = (any[0] | any[1] | any[2] | any[3]) != 0;
+    return i;
+}
+
+void hex_encode(char *dst, const uint8_t *src, size_t len) {
+    size_t i = 0;
+    if (__builtin_cpu_supports("avx2"))
+        i = hex_encode_avx2(dst, src, len);
+    else if (__builtin_cpu_supports("ssse3"))
+        i = hex_encode_ssse3(dst, src, len);
+    hex_encode_scalar(dst + 2 * i, src + i, len - i);
+    dst[2 * len] = '\0';
+}
+
+int hex_decode(uint8_t *dst, const char *hex, size_t hex_len) {
+    if (hex_len % 2 != 0)
+        return -1;
+    size_t len = hex_len / 2, i = 0;
+    int bad = 0;
+    if (__builtin_cpu_supports("avx2"))
+        i = hex_decode_avx2(dst, hex, len, &bad);
+    else if (__builtin_cpu_supports("ssse3"))
+        i = hex_decode_ssse3(dst, hex, len, &bad);
+    if (bad)
+        return -1;
+    return hex_decode_scalar(dst + i, hex + 2 * i, len - i);
+}
@@ -0,0 +1,158 @@
+// gcc -O2 -o test_customutil test_customutil.c customutil.c customutil_simd.c ../ecc/ecc.c -lgmp
+// ./test_customutil
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <gmp.h>
+
+#include "../ecc/ecc.h"
+#include "customutil.h"
+
+/* 与 sprintf("%02x") 逐字节结果比较，覆盖向量分组与逐字节剩余部分 */
+static int check_encode(void) {
+    static uint8_t data[300];
+    static char expect[sizeof(data) * 2 + 1], got[sizeof(data) * 2 + 1];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    for (size_t len = 0; len <= sizeof(data); len++) {
+        for (size_t i = 0; i < len; i++) {
+            sprintf(expect + 2 * i, "%02x", data[i]);
+        }
+        expect[2 * len] = '\0';
+        memset(got, 'x', sizeof(got));
+        hex_encode(got, data, len);
+        if (strcmp(got, expect) != 0) {
+            printf("  FAIL hex_encode len %zu\n", len);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_decode(void) {
+    static uint8_t data[300], got[300];
+    static char hex[sizeof(data) * 2 + 1];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 101 + 7);
+    }
+    for (size_t len = 0; len <= sizeof(data); len++) {
+        hex_encode(hex, data, len);
+        /* 大小写混合 */
+        for (size_t i = 0; i < 2 * len; i += 3) {
+            hex[i] = (char)toupper((unsigned char)hex[i]);
+        }
+        if (hex_decode(got, hex, 2 * len) != 0 || memcmp(got, data, len) != 0) {
+            printf("  FAIL hex_decode len %zu\n", len);
+            return 1;
+        }
+    }
+
+    /* 每个位置上的非法字符都要被发现 */
+    static const char bad_chars[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\0', (char)0x80, (char)0xb0 };
+    for (size_t len = 1; len <= 100; len += 9) {
+        hex_encode(hex, data, len);
+        for (size_t pos = 0; pos < 2 * len; pos++) {
+            for (size_t k = 0; k < sizeof(bad_chars); k++) {
+                char saved = hex[pos];
+                hex[pos] = bad_chars[k];
+                int ret = hex_decode(got, hex, 2 * len);
+                hex[pos] = saved;
+                if (ret != -1) {
+                    printf("  FAIL hex_decode accepted 0x%02x at %zu of %zu\n",
+                           (unsigned char)bad_chars[k], pos, 2 * len);
+                    return 1;
+                }
+            }
+        }
+    }
+    if (hex_decode(got, "abc", 3) != -1) {
+        printf("  FAIL hex_decode accepted an odd length\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* 二进制序列化与 gmp_snprintf 格式化的结果比较，覆盖各种长度的坐标 */
+static int check_points(void) {
+    enum { COUNT = 40 };
+    static Point points[COUNT];
+    static uint8_t comp[COUNT * 33], uncomp[COUNT * 65], xonly[COUNT * 32];
+    int failed = 0;
+    mpz_t seed;
+    mpz_init_set_str(seed, "fedcba9876543210fedcba9876543210fedcba9876543210fedcba9876543210", 16);
+    for (int i = 0; i < COUNT; i++) {
+        point_init(&points[i]);
+        mpz_tdiv_q_2exp(points[i].x, seed, i * 6);
+        mpz_tdiv_q_2exp(points[i].y, seed, (COUNT - 1 - i) * 6);
+        mpz_add_ui(points[i].y, points[i].y, i);
+    }
+    generate_binpublickeys(points, COUNT, true, comp);
+    generate_binpublickeys(points, COUNT, false, uncomp);
+    generate_xonlypublickeys(points, COUNT, xonly);
+
+    for (int i = 0; i < COUNT && !failed; i++) {
+        char ref_hex[131], hex[131];
+        uint8_t ref[65], one[65];
+
+        gmp_snprintf(ref_hex, sizeof(ref_hex), "%02x%0.64Zx", mpz_tstbit(points[i].y, 0) ? 3 : 2, points[i].x);
+        hex_decode(ref, ref_hex, 66);
+        generate_binpublickey(&points[i], true, one);
+        generate_strpublickey(&points[i], true, hex);
+        if (memcmp(ref, one, 33) != 0 || memcmp(ref, comp + i * 33, 33) != 0 ||
+            memcmp(ref + 1, xonly + i * 32, 32) != 0 || strcmp(hex, ref_hex) != 0) {
+            printf("  FAIL compressed point %d\n", i);
+            failed = 1;
+        }
+
+        gmp_snprintf(ref_hex, sizeof(ref_hex), "04%0.64Zx%0.64Zx", points[i].x, points[i].y);
+        hex_decode(ref, ref_hex, 130);
+        generate_binpublickey(&points[i], false, one);
+        generate_strpublickey(&points[i], false, hex);
+        if (memcmp(ref, one, 65) != 0 || memcmp(ref, uncomp + i * 65, 65) != 0 || strcmp(hex, ref_hex) != 0) {
+            printf("  FAIL uncompressed point %d\n", i);
+            failed = 1;
+        }
+    }
+    for (int i = 0; i < COUNT; i++) {
+        point_clear(&points[i]);
+    }
+    mpz_clear(seed);
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("Testing hex encoding...\n");
+    failed |= check_encode();
+
+    printf("Testing hex decoding and validation...\n");
+    failed |= check_decode();
+
+    printf("Testing point serialization...\n");
+    failed |= check_points();
+
+    printf("Testing hexs2bin and tohex_dst...\n");
+    unsigned char bin[4];
+    char text[9];
+    if (hexs2bin("DeadBeef", bin) != 4 || hexs2bin("DeadBeeg", bin) != 0) {
+        printf("  FAIL hexs2bin\n");
+        failed = 1;
+    }
+    hexs2bin("DeadBeef", bin);
+    tohex_dst((char *)bin, 4, text);
+    if (strcmp(text, "deadbeef") != 0) {
+        printf("  FAIL tohex_dst\n");
+        failed = 1;
+    }
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
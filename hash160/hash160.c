@@ -0,0 +1,34 @@
+/*
+ * hash160.c
+ *
+ * hash160 = RIPEMD160(SHA256(data)) 的单条与批量实现。
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash160.h"
+
+#include "../sha256/sha256.h"
+#include "../ripemd160/ripemd160.h"
+
+/* 批量流水线每一段处理的条数：中间摘要保存在栈上，留在 L1 缓存中 */
+#define HASH160_CHUNK 64
+
+void hash160(const uint8_t *data, size_t data_len, uint8_t out[20]) {
+    uint8_t sha[32];
+    sha256(data, data_len, sha);
+    ripemd160_32(sha, out);
+}
+
+void hash160_pubkeys(const uint8_t *pubkeys, size_t pubkey_len, size_t count, uint8_t *hashes) {
+    uint8_t sha[HASH160_CHUNK * 32];
+    while (count > 0) {
+        size_t n = count < HASH160_CHUNK ? count : HASH160_CHUNK;
+        sha256_batch(pubkeys, pubkey_len, pubkey_len, n, sha);
+        ripemd160_32_many(sha, n, hashes);
+        pubkeys += n * pubkey_len;
+        hashes += n * 20;
+        count -= n;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * hash160.h
+ *
+ * hash160 = RIPEMD160(SHA256(data))，比特币地址使用的公钥哈希。
+ * 批量接口将 SHA-256 与 RIPEMD-160 两级流水线化，并自动使用
+ * 可用的最快实现（AVX-512 / AVX2 多缓冲或标量）。
+ */
+
+#ifndef HASH160_H
+#define HASH160_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * hash160 - 计算单条数据的 hash160
+ *
+ * @data: 输入数据（例如序列化的公钥或赎回脚本）
+ * @data_len: 数据长度（字节）
+ * @out: 输出 20 字节哈希值
+ */
+void hash160(const uint8_t *data, size_t data_len, uint8_t out[20]);
+
+/**
+ * hash160_pubkeys - 批量计算序列化公钥的 hash160
+ *
+ * @pubkeys: count 个连续存放的公钥，每个 pubkey_len 字节
+ *           （33 字节压缩公钥为 1 个 SHA-256 块，65 字节非压缩公钥为 2 个块）；
+ *           也可以是其他等长数据，例如地址代码中 22 字节的 P2WPKH 赎回脚本
+ * @pubkey_len: 每个公钥的字节数
+ * @count: 公钥个数
+ * @hashes: 输出缓冲区，依次写入 count 个 20 字节哈希值
+ */
+void hash160_pubkeys(const uint8_t *pubkeys, size_t pubkey_len, size_t count, uint8_t *hashes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASH160_H */
@@ -0,0 +1,69 @@
+// gcc -O2 -o test_hash160 test_hash160.c hash160.c ../sha256/sha256.c ../sha256/sha256_simd.c ../ripemd160/ripemd160.c ../ripemd160/ripemd160_simd.c
+// ./test_hash160
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hash160.h"
+
+/* 私钥 1 对应的压缩公钥（生成元 G）及其 hash160 */
+static const uint8_t G_COMPRESSED[33] = {
+    0x02, 0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b,
+    0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17,
+    0x98
+};
+static const uint8_t G_HASH160[20] = {
+    0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x23,
+    0xf1, 0x43, 0x3b, 0xd6
+};
+
+/* 批量结果与逐条 hash160() 比较，覆盖多缓冲分组与标量剩余部分 */
+static int check_batch(size_t key_len) {
+    enum { COUNT = 150 };
+    static uint8_t keys[COUNT * 65], expect[COUNT * 20], got[COUNT * 20];
+    for (size_t i = 0; i < COUNT * key_len; i++) {
+        keys[i] = (uint8_t)(i * 29 + key_len);
+    }
+    for (size_t n = 0; n < COUNT; n++) {
+        hash160(keys + n * key_len, key_len, expect + n * 20);
+    }
+    for (size_t n = 0; n <= COUNT; n += 7) {
+        memset(got, 0, sizeof(got));
+        hash160_pubkeys(keys, key_len, n, got);
+        if (memcmp(expect, got, n * 20) != 0) {
+            printf("  FAIL hash160_pubkeys len %zu count %zu\n", key_len, n);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    uint8_t out[20];
+
+    printf("Testing hash160 of the generator point...\n");
+    hash160(G_COMPRESSED, 33, out);
+    if (memcmp(out, G_HASH160, 20) != 0) {
+        printf("  FAIL hash160\n");
+        failed = 1;
+    }
+    hash160_pubkeys(G_COMPRESSED, 33, 1, out);
+    if (memcmp(out, G_HASH160, 20) != 0) {
+        printf("  FAIL hash160_pubkeys\n");
+        failed = 1;
+    }
+
+    printf("Testing batch hash160 of 33- and 65-byte keys...\n");
+    failed |= check_batch(33);
+    failed |= check_batch(65);
+    failed |= check_batch(22);
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -2,251 +2,274 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <gmp.h>
 #include <string.h>
 #include <unistd.h>
 #include <time.h>
 
-#include "ecc/ecc.h"
-#include "sha256/sha256.h"
-#include "ripemd160/ripemd160.h"
-#include "base58/base58.h"
-#include "bech32/bech32.h"
+#include "brainwallet/brainwallet.h"
 #include "customutil/customutil.h"
-
-/* secp256k1 椭圆曲线参数 */
-const char *EC_constant_N = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141";
-const char *EC_constant_P = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
-const char *EC_constant_Gx = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
-const char *EC_constant_Gy = "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
-
-/* 辅助函数声明 */
-int hex2bin(const char *hex, uint8_t *bin, size_t bin_len);
-int wif_to_private_key(const char *wif, char *priv_hex, size_t hex_len, bool *compressed);
-int private_key_to_wif(const char *priv_hex, bool compressed, char *wif, size_t wif_len);
-void hash160(const uint8_t *data, size_t data_len, uint8_t *out);
-int base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len);
-
-/* 新增函数声明 */
-char *public_key_to_address(const char *public_key_hex, const char *address_type);
-
-
-/* 将 hex 字符串转换为二进制数据 */
-int hex2bin(const char *hex, uint8_t *bin, size_t bin_len) {
-    size_t hex_len = strlen(hex);
-    if (hex_len != bin_len * 2)
+#include "pipeline/pipeline.h"
+#include "targets/targets.h"
+#include "checkpoint/checkpoint.h"
+
+/* 解析不超过 64 个字符的 hex 私钥，不足时左侧补零 */
+static int parse_key_hex(const char *hex, uint8_t *key) {
+    size_t len = strlen(hex);
+    if (len == 0 || len > 64)
         return -1;
-    for (size_t i = 0; i < bin_len; i++) {
-        unsigned int byte;
-        if (sscanf(hex + 2 * i, "%02x", &byte) != 1)
-            return -1;
-        bin[i] = (uint8_t)byte;
-    }
-    return 0;
+    char padded[65];
+    memset(padded, '0', 64 - len);
+    memcpy(padded + 64 - len, hex, len + 1);
+    return bw_hex2bin(padded, key, BW_PRIVKEY_LEN);
 }
 
-/* 将 WIF 解码为私钥的 16 进制字符串，并判断是否为压缩格式 */
-int wif_to_private_key(const char *wif, char *priv_hex, size_t hex_len, bool *compressed) {
-    size_t decoded_len = 100;
-    uint8_t decoded[100] = {0};
-
-    if (!b58tobin(decoded, &decoded_len, wif, strlen(wif)))
-        return -1;
-
-    /* 解码后长度应为 37 字节（非压缩）或 38 字节（压缩） */
-    if (decoded_len == 37)
-        *compressed = false;
-    else if (decoded_len == 38)
-        *compressed = true;
-    else
-        return -1;
-
-    /* 检查版本字节：应为 0x80 */
-    if (decoded[0] != 0x80)
-        return -1;
-
-    /* 校验 checksum：对前 decoded_len-4 字节进行双 SHA256 */
-    uint8_t hash1[32], hash2[32];
-    sha256(decoded, decoded_len - 4, hash1);
-    sha256(hash1, 32, hash2);
-    if (memcmp(hash2, decoded + decoded_len - 4, 4) != 0)
-        return -1;
-
-    /* 私钥位于 decoded[1..32] */
-    if (hex_len < 65)
-        return -1;
-    for (int i = 0; i < 32; i++) {
-        sprintf(priv_hex + i * 2, "%02x", decoded[1 + i]);
+/* secp256k1 曲线阶 n，大端 */
+static const uint8_t curve_order[BW_PRIVKEY_LEN] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+    0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+};
+
+/* 区间 [start, end] 的私钥个数，end < start 或个数超出 uint64 时返回 -1 */
+static int range_count(const uint8_t *start, const uint8_t *end, uint64_t *count) {
+    uint8_t diff[BW_PRIVKEY_LEN];
+    int borrow = 0;
+    for (int i = BW_PRIVKEY_LEN - 1; i >= 0; i--) {
+        int d = end[i] - start[i] - borrow;
+        borrow = d < 0;
+        diff[i] = (uint8_t)(d + (borrow ? 256 : 0));
     }
-    priv_hex[64] = '\0';
-    return 0;
-}
-
-/* 将 32 字节私钥（Hex）转换为 WIF 格式 */
-int private_key_to_wif(const char *priv_hex, bool compressed, char *wif, size_t wif_len) {
-    uint8_t priv_bin[32];
-    if (hex2bin(priv_hex, priv_bin, 32) != 0)
+    if (borrow)
         return -1;
-    uint8_t payload[34];
-    payload[0] = 0x80;
-    memcpy(payload + 1, priv_bin, 32);
-    size_t payload_len = 33;
-    if (compressed) {
-        payload[33] = 0x01;
-        payload_len = 34;
+    uint64_t n = 0;
+    for (int i = 0; i < BW_PRIVKEY_LEN; i++) {
+        if (i < BW_PRIVKEY_LEN - 8 && diff[i] != 0)
+            return -1;
+        n = n << 8 | diff[i];
     }
-    uint8_t hash1[32], hash2[32];
-    sha256(payload, payload_len, hash1);
-    sha256(hash1, 32, hash2);
-    uint8_t full[38];
-    memcpy(full, payload, payload_len);
-    memcpy(full + payload_len, hash2, 4);
-    size_t full_len = payload_len + 4;
-    size_t encoded_len = wif_len;
-    if (!b58enc(wif, &encoded_len, full, full_len))
+    if (n == UINT64_MAX)
         return -1;
+    *count = n + 1;
     return 0;
 }
 
-/* 计算 hash160 (RIPEMD160(SHA256(data))) */
-void hash160(const uint8_t *data, size_t data_len, uint8_t *out) {
-    uint8_t sha[32];
-    sha256(data, data_len, sha);
-    RMD160Data(sha, 32, out);
+static void print_range_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s --range <Start Hex> <End Hex> [--threads N] [--unordered] [--shard i/N] [--targets <File>]\n", prog);
+    fprintf(stderr, "           [--outputs LIST | --format F] [--checkpoint <File> [--checkpoint-every S] [--resume]]\n");
+    fprintf(stderr, "  逐个推导 [Start, End] 内的私钥，每个一行：私钥 hex、两个 WIF、压缩与非压缩公钥的全部地址\n");
+    fprintf(stderr, "  --shard i/N        只处理把区间均分为 N 段后的第 i 段（0 <= i < N）\n");
+    fprintf(stderr, "  --threads N        工作线程数（默认为 CPU 核数）\n");
+    fprintf(stderr, "  --unordered        按完成顺序输出（默认按私钥顺序）\n");
+    fprintf(stderr, "  --targets File     只输出 hash160 命中目标集合（loadtargets 生成）的私钥\n");
+    fprintf(stderr, "  --outputs LIST     私钥 hex 之后只计算并输出指定的列，逗号分隔，可用的列与 Brain 相同\n");
+    fprintf(stderr, "  --format F         输出格式：text（默认）或 bin-nooffset（定长二进制记录，可用 keydump 还原）；\n");
+    fprintf(stderr, "                     记录本身含私钥，没有可指回的输入行，因此不支持 bin\n");
+    fprintf(stderr, "  --checkpoint File  定期把剩余区间原子地写入状态文件，--resume 从中继续\n");
 }
 
-/* 根据版本字节和 20 字节数据生成 Base58Check 地址 */
-int base58check_encode(uint8_t version, const uint8_t *hash20, char *address, size_t addr_len) {
-    uint8_t payload[21];
-    payload[0] = version;
-    memcpy(payload + 1, hash20, 20);
-    uint8_t hash1[32], hash2[32];
-    sha256(payload, 21, hash1);
-    sha256(hash1, 32, hash2);
-    uint8_t full[25];
-    memcpy(full, payload, 21);
-    memcpy(full + 21, hash2, 4);
-    size_t encoded_len = addr_len;
-    if (!b58enc(address, &encoded_len, full, 25))
-         return -1;
-    return 0;
-}
-
-
-/* 新增函数：根据公钥和地址类型生成地址 */
-char *public_key_to_address(const char *public_key_hex, const char *address_type) {
-    uint8_t pub_bin[100] = {0}; // 假设公钥最大长度为 100 bytes
-    size_t pub_bin_len = strlen(public_key_hex) / 2;
-    if (hex2bin(public_key_hex, pub_bin, pub_bin_len) != 0) {
-        fprintf(stderr, "Error: Invalid public key hex.\n");
-        return NULL;
+/* 区间模式：私钥区间作为流水线的输入，与 Brain 的批量模式共用线程池、目标匹配与检查点 */
+static int run_range(int argc, char **argv) {
+    if (argc < 4) {
+        print_range_usage(argv[0]);
+        return 1;
     }
-    
-    uint8_t hash_160[20] = {0};
-    hash160(pub_bin, pub_bin_len, hash_160);
-    
-    char *address = (char *)malloc(100 * sizeof(char));
-    if (address == NULL) {
-        fprintf(stderr, "Error: Memory allocation failed.\n");
-        return NULL;
+    PIPELINE_KEYSPACE ks;
+    uint8_t last[BW_PRIVKEY_LEN];
+    if (parse_key_hex(argv[2], ks.start) != 0 || parse_key_hex(argv[3], last) != 0) {
+        fprintf(stderr, "Error: 无效的私钥 hex\n");
+        return 1;
     }
-        
-    if (strcmp(address_type, "P2PKH") == 0) {
-      if (base58check_encode(0x00, hash_160, address, 100) != 0) {
-        free(address);
-        return NULL;
-      }
-    } else if (strcmp(address_type, "P2SH") == 0) {
-      if (base58check_encode(0x05, hash_160, address, 100) != 0) {
-        free(address);
-        return NULL;
-      }
-    } else if (strcmp(address_type, "BECH32") == 0) {
-        if(segwit_addr_encode(address, "bc", 0, hash_160, 20) != 1)
-        {
-          free(address);
-           return NULL;
+    /* 库按模 n 处理私钥，不小于 n 的私钥会与区间开头的私钥重复，直接拒绝 */
+    if (memcmp(last, curve_order, BW_PRIVKEY_LEN) >= 0) {
+        fprintf(stderr, "Error: 私钥必须小于曲线阶 n\n");
+        return 1;
+    }
+    if (range_count(ks.start, last, &ks.count) != 0) {
+        fprintf(stderr, "Error: 区间为空或超过 2^64 - 1 个私钥\n");
+        return 1;
+    }
+
+    int threads = 0;
+    bool ordered = true, resume = false;
+    unsigned shard_index = 0, shard_count = 1, checkpoint_interval = 60;
+    const char *targets_path = NULL, *checkpoint_path = NULL;
+    PIPELINE_FORMAT format = PIPELINE_FORMAT_TEXT;
+    PIPELINE_PLAN plan;
+    bool has_plan = false;
+    for (int argi = 4; argi < argc;) {
+        if (strcmp(argv[argi], "--unordered") == 0) {
+            ordered = false;
+            argi++;
+        } else if (strcmp(argv[argi], "--resume") == 0) {
+            resume = true;
+            argi++;
+        } else if (strcmp(argv[argi], "--threads") == 0 && argi + 1 < argc) {
+            char *end = NULL;
+            long n = strtol(argv[argi + 1], &end, 10);
+            if (*end != '\0' || n < 1 || n > 4096) {
+                fprintf(stderr, "Error: 无效的线程数 %s\n", argv[argi + 1]);
+                return 1;
+            }
+            threads = (int)n;
+            argi += 2;
+        } else if (strcmp(argv[argi], "--shard") == 0 && argi + 1 < argc) {
+            if (pipeline_shard_parse(argv[argi + 1], &shard_index, &shard_count) != 0) {
+                fprintf(stderr, "Error: 无效的分片 %s，应为 i/N 且 0 <= i < N\n", argv[argi + 1]);
+                return 1;
+            }
+            argi += 2;
+        } else if (strcmp(argv[argi], "--targets") == 0 && argi + 1 < argc) {
+            targets_path = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--outputs") == 0 && argi + 1 < argc) {
+            const char *bad = NULL;
+            if (pipeline_plan_parse(argv[argi + 1], &plan, &bad) != 0) {
+                fprintf(stderr, "Error: 无效的输出列 %.*s\n", (int)strcspn(bad, ","), bad);
+                return 1;
+            }
+            has_plan = true;
+            argi += 2;
+        } else if (strcmp(argv[argi], "--format") == 0 && argi + 1 < argc) {
+            const char *name = argv[argi + 1];
+            if (strcmp(name, "text") == 0) {
+                format = PIPELINE_FORMAT_TEXT;
+            } else if (strcmp(name, "bin-nooffset") == 0) {
+                format = PIPELINE_FORMAT_BIN;
+            } else if (strcmp(name, "bin") == 0) {
+                /* 偏移指回输入词表中的行，区间模式没有输入文件 */
+                fprintf(stderr, "Error: --range 不能与 --format bin 同时使用，请改用 bin-nooffset\n");
+                return 1;
+            } else {
+                fprintf(stderr, "Error: 未知的输出格式 %s\n", name);
+                return 1;
+            }
+            argi += 2;
+        } else if (strcmp(argv[argi], "--checkpoint") == 0 && argi + 1 < argc) {
+            checkpoint_path = argv[argi + 1];
+            argi += 2;
+        } else if (strcmp(argv[argi], "--checkpoint-every") == 0 && argi + 1 < argc) {
+            char *end = NULL;
+            unsigned long n = strtoul(argv[argi + 1], &end, 10);
+            if (*end != '\0' || n > 86400) {
+                fprintf(stderr, "Error: 无效的检查点间隔 %s\n", argv[argi + 1]);
+                return 1;
+            }
+            checkpoint_interval = (unsigned)n;
+            argi += 2;
+        } else {
+            print_range_usage(argv[0]);
+            return 1;
         }
     }
-     else if (strcmp(address_type, "BECH32M") == 0) {
-        if(segwit_addr_encode(address, "bc", 1, hash_160, 20) != 1)
-        {
-          free(address);
-          return NULL;
+    if (resume && checkpoint_path == NULL) {
+        fprintf(stderr, "Error: --resume 需要 --checkpoint\n");
+        return 1;
+    }
+    if (has_plan && format != PIPELINE_FORMAT_TEXT) {
+        print_range_usage(argv[0]);
+        return 1;
+    }
+
+    TARGET_SET target_set;
+    TARGET_INDEX target_index;
+    if (targets_path != NULL) {
+        if (targets_open(targets_path, &target_set) != 0)
+            return 1;
+        if (target_index_build(&target_index, &target_set) != 0) {
+            fprintf(stderr, "Error: 内存不足，无法建立目标索引\n");
+            targets_close(&target_set);
+            return 1;
         }
-     }
-    else if(strcmp(address_type, "P2SH-P2WPKH") == 0){
-        // P2SH wrapped P2WPKH: script is hash160(0014<20 byte key hash>), address is base58(script, 0x05 version)
-        uint8_t redeem_script[22] = {0x00, 0x14};
-        memcpy(redeem_script + 2, hash_160, 20);
-        uint8_t redeem_hash160[20] = {0};
-        hash160(redeem_script, 22, redeem_hash160);
-       if (base58check_encode(0x05, redeem_hash160, address, 100) != 0) {
-            free(address);
-            return NULL;
+        fprintf(stderr, "Targets: %llu hash160s\n", (unsigned long long)target_index.count);
+        if (target_set.count > target_index.count)
+            fprintf(stderr, "Warning: 忽略 %llu 条无法匹配的 32 字节程序（P2WSH、Taproot 等）\n",
+                    (unsigned long long)(target_set.count - target_index.count));
+    }
+
+    /* 短语列已是私钥 hex，默认计划去掉重复的私钥列 */
+    if (!has_plan) {
+        pipeline_plan_full(&plan);
+        memmove(plan.columns, plan.columns + 1, --plan.ncolumns);
+    }
+
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+
+    PIPELINE_STREAM_CONFIG cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.ctx = &ctx;
+    cfg.iterations = 1;
+    cfg.threads = threads;
+    cfg.ordered = ordered;
+    cfg.out = stdout;
+    cfg.targets = targets_path != NULL ? &target_index : NULL;
+    cfg.format = format;
+    cfg.bin_flags = 0;
+    cfg.plan = &plan;
+    cfg.keyspace = &ks;
+    cfg.checkpoint = checkpoint_path;
+    cfg.checkpoint_interval = checkpoint_interval;
+    cfg.shard_mode = PIPELINE_SHARD_RANGE;
+    cfg.shard_index = shard_index;
+    cfg.shard_count = shard_count;
+
+    PIPELINE_STREAM_STATS stats;
+    CHECKPOINT cp;
+    int ret = 0;
+    if (resume) {
+        ret = pipeline_stream_resume(&cfg, &cp);
+        if (ret == 0) {
+            fprintf(stderr, "Resuming: %llu keys, %llu hits done, %zu ranges left\n",
+                    (unsigned long long)cp.phrases, (unsigned long long)cp.hits, cp.nranges);
+            cfg.resume = &cp;
         }
     }
-    else if (strcmp(address_type, "P2WSH") == 0){
-          // P2WSH: script hash is hash256(script), address is bech32(witness_version = 0, script_hash)
-        uint8_t sha[32];
-        sha256(pub_bin, pub_bin_len, sha);
-      if(segwit_addr_encode(address, "bc", 0, sha, 32) != 1)
-       {
-          free(address);
-           return NULL;
-       }
+    if (ret == 0) {
+        /* 分片时只统计本分片的私钥 */
+        uint64_t keys = pipeline_split_point(ks.count, shard_index + 1, shard_count) -
+                        pipeline_split_point(ks.count, shard_index, shard_count);
+        fprintf(stderr, "Keys: %llu\n", (unsigned long long)keys);
+        ret = pipeline_run_stream(&cfg, &stats);
+        fflush(stdout);
+        if (ret != 0)
+            fprintf(stderr, "Error: 批量处理失败（读写错误或内存不足）\n");
+        fprintf(stderr, "Keys derived: %llu, batches: %llu, threads: %d, stolen batches: %llu\n",
+                (unsigned long long)stats.phrases, (unsigned long long)stats.batches,
+                stats.threads, (unsigned long long)stats.steals);
+        if (cfg.targets != NULL)
+            fprintf(stderr, "Target hits: %llu\n", (unsigned long long)stats.hits);
+        if (resume)
+            checkpoint_free(&cp);
     }
-    else if (strcmp(address_type, "P2WSH-P2WPKH") == 0) {
-        // P2WSH wrapped P2WPKH: redeem_script is 0014<20byte public key hash>, script_hash = sha256(script)
-         uint8_t redeem_script[22] = {0x00, 0x14};
-        memcpy(redeem_script + 2, hash_160, 20);
-         uint8_t sha[32];
-        sha256(redeem_script, 22, sha);
-       if(segwit_addr_encode(address, "bc", 0, sha, 32) != 1)
-       {
-           free(address);
-          return NULL;
-       }
-    } else {
-        free(address);
-        fprintf(stderr, "Error: Invalid address type.\n");
-        return NULL;
+
+    bw_ctx_free(&ctx);
+    if (targets_path != NULL) {
+        target_index_free(&target_index);
+        targets_close(&target_set);
     }
-   return address;
+    return ret != 0;
 }
 
 int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "--range") == 0)
+        return run_range(argc, argv);
     if (argc != 2) {
         fprintf(stderr, "Usage: %s <Private Key (Hex or WIF)>\n", argv[0]);
+        fprintf(stderr, "       %s --range <Start Hex> <End Hex> [...]\n", argv[0]);
         return 1;
     }
 
-    /* 初始化 secp256k1 参数 */
-    EllipticCurve EC;
-    Point G;
-    mpz_inits(EC.p, EC.a, EC.b, EC.n, NULL);
-    mpz_set_str(EC.p, EC_constant_P, 16);
-    mpz_set_ui(EC.a, 0);    // secp256k1: a = 0
-    mpz_set_ui(EC.b, 7);    // secp256k1: b = 7
-    mpz_set_str(EC.n, EC_constant_N, 16);
-
-    point_init(&G);
-    mpz_set_str(G.x, EC_constant_Gx, 16);
-    mpz_set_str(G.y, EC_constant_Gy, 16);
-    G.infinity = 0;
-
     char *input_key = argv[1];
-    bool is_wif = false, compressed_flag = false;
+    bool compressed_flag = false;
+    uint8_t priv_bin[BW_PRIVKEY_LEN];
     char priv_hex[65] = {0};
-    char wif[100] = {0};
 
     /* 判断输入格式：如果首字符为 '5'、'K' 或 'L' 则认为是 WIF 格式 */
     if (input_key[0] == '5' || input_key[0] == 'K' || input_key[0] == 'L') {
-        is_wif = true;
-        if (wif_to_private_key(input_key, priv_hex, sizeof(priv_hex), &compressed_flag) != 0) {
+        if (bw_wif_decode(input_key, priv_bin, &compressed_flag) != 0) {
             fprintf(stderr, "WIF 解码失败\n");
             return 1;
         }
+        hex_encode(priv_hex, priv_bin, BW_PRIVKEY_LEN);
         printf("WIF Private Key: %s\n", input_key);
         printf("Raw Private Key (Hex): %s\n", priv_hex);
     } else {
@@ -267,11 +290,12 @@ int main(int argc, char **argv) {
         char wif_compressed[100] = {0};
         char wif_uncompressed[100] = {0};
 
-        if (private_key_to_wif(priv_hex, true, wif_compressed, sizeof(wif_compressed)) != 0) {
+        if (bw_hex2bin(priv_hex, priv_bin, BW_PRIVKEY_LEN) != 0 ||
+            bw_wif_encode(priv_bin, true, wif_compressed, sizeof(wif_compressed)) != 0) {
             fprintf(stderr, "私钥转换为压缩 WIF 失败\n");
             return 1;
         }
-        if (private_key_to_wif(priv_hex, false, wif_uncompressed, sizeof(wif_uncompressed)) != 0) {
+        if (bw_wif_encode(priv_bin, false, wif_uncompressed, sizeof(wif_uncompressed)) != 0) {
             fprintf(stderr, "私钥转换为非压缩 WIF 失败\n");
             return 1;
         }
@@ -280,105 +304,42 @@ int main(int argc, char **argv) {
         printf("WIF Private Key (Uncompressed): %s\n", wif_uncompressed);
     }
 
-    
+    /* 初始化 secp256k1 参数 */
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+
     /* 由私钥计算公钥 */
-    mpz_t priv;
-    mpz_init_set_str(priv, priv_hex, 16);
-    Point pub;
-    point_init(&pub);
-    /* 调用标量乘法： pub = priv * G */
-    scalar_multiplication(&EC, &G, &pub, priv);
-    
+    uint8_t pub_comp_bin[BW_PUBKEY_COMPRESSED_LEN];
+    uint8_t pub_uncomp_bin[BW_PUBKEY_UNCOMPRESSED_LEN];
+    if (bw_privkeys_to_pubkeys(&ctx, priv_bin, 1, pub_comp_bin, pub_uncomp_bin) != 0) {
+        fprintf(stderr, "Error: 无效的私钥\n");
+        bw_ctx_free(&ctx);
+        return 1;
+    }
+    bw_ctx_free(&ctx);
+
     char pub_hex_comp[67] = {0};
     char pub_hex_uncomp[131] = {0};
-    /* 生成公钥字符串（由 customutil 模块提供） */
-    generate_strpublickey(&pub, true, pub_hex_comp);    // 生成压缩格式
-    generate_strpublickey(&pub, false, pub_hex_uncomp);   // 生成非压缩格式
+    hex_encode(pub_hex_comp, pub_comp_bin, sizeof(pub_comp_bin));
+    hex_encode(pub_hex_uncomp, pub_uncomp_bin, sizeof(pub_uncomp_bin));
     printf("\nCompressed Public Key: %s\n", pub_hex_comp);
     printf("Uncompressed Public Key: %s\n", pub_hex_uncomp);
 
 
-    printf("\n=== Addresses Generated from Compressed Public Key ===\n");
-    char *p2pkh_address_compressed = public_key_to_address(pub_hex_comp, "P2PKH");
-    if (p2pkh_address_compressed != NULL)
-      printf("P2PKH (Starts with 1) Address (Compressed): %s\n", p2pkh_address_compressed);
-      free(p2pkh_address_compressed);
-
-    char *p2sh_address_compressed = public_key_to_address(pub_hex_comp, "P2SH");
-    if (p2sh_address_compressed != NULL)
-      printf("P2SH (Starts with 3) Address (Compressed): %s (P2SH => P2PKH)\n", p2sh_address_compressed);
-    free(p2sh_address_compressed);
-    
-    char *p2sh_p2wpkh_address_compressed = public_key_to_address(pub_hex_comp, "P2SH-P2WPKH");
-        if (p2sh_p2wpkh_address_compressed != NULL)
-         printf("P2SH (Starts with 3) Address (Compressed): %s (P2SH => P2WPKH)\n", p2sh_p2wpkh_address_compressed);
-    free(p2sh_p2wpkh_address_compressed);
-
-    char *bech32_address_compressed = public_key_to_address(pub_hex_comp, "BECH32");
-        if (bech32_address_compressed != NULL)
-      printf("Bech32 (Starts with bc1) Address (Compressed): %s\n", bech32_address_compressed);
-    free(bech32_address_compressed);
-
-    char *bech32m_address_compressed = public_key_to_address(pub_hex_comp, "BECH32M");
-        if (bech32m_address_compressed != NULL)
-      printf("Bech32m (Starts with bc1p) Address (Compressed): %s\n", bech32m_address_compressed);
-    free(bech32m_address_compressed);
+    /* 压缩与非压缩公钥各计算一次全部地址 */
+    ADDRESS_SET addr_comp, addr_uncomp;
+    if (bw_pubkeys_to_addresses(pub_comp_bin, sizeof(pub_comp_bin), NULL, 1, ADDRESS_ALL, &addr_comp) != 0 ||
+        bw_pubkeys_to_addresses(pub_uncomp_bin, sizeof(pub_uncomp_bin), NULL, 1, ADDRESS_ALL, &addr_uncomp) != 0) {
+        fprintf(stderr, "Error: 地址生成失败\n");
+        return 1;
+    }
 
-    char *p2wsh_address_compressed = public_key_to_address(pub_hex_comp, "P2WSH");
-    if (p2wsh_address_compressed != NULL)
-        printf("P2WSH (Starts with bc1) Address (Compressed): %s (P2WSH => P2PKH)\n", p2wsh_address_compressed);
-     free(p2wsh_address_compressed);
-     
-    char *p2wsh_p2wpkh_address_compressed = public_key_to_address(pub_hex_comp, "P2WSH-P2WPKH");
-    if (p2wsh_p2wpkh_address_compressed != NULL)
-        printf("P2WSH (Starts with bc1) Address (Compressed): %s (P2WSH => P2WPKH)\n", p2wsh_p2wpkh_address_compressed);
-    free(p2wsh_p2wpkh_address_compressed);
+    printf("\n=== Addresses Generated from Compressed Public Key ===\n");
+    address_print(&addr_comp, "Compressed");
 
 
     printf("\n=== Addresses Generated from Uncompressed Public Key ===\n");
-    char *p2pkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2PKH");
-    if (p2pkh_address_uncompressed != NULL)
-      printf("P2PKH (Starts with 1) Address (Uncompressed): %s\n", p2pkh_address_uncompressed);
-    free(p2pkh_address_uncompressed);
-
-    char *p2sh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2SH");
-    if (p2sh_address_uncompressed != NULL)
-       printf("P2SH (Starts with 3) Address (Uncompressed): %s (P2SH => P2PKH)\n", p2sh_address_uncompressed);
-    free(p2sh_address_uncompressed);
-
-   char *p2sh_p2wpkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2SH-P2WPKH");
-       if (p2sh_p2wpkh_address_uncompressed != NULL)
-        printf("P2SH (Starts with 3) Address (Uncompressed): %s (P2SH => P2WPKH)\n", p2sh_p2wpkh_address_uncompressed);
-    free(p2sh_p2wpkh_address_uncompressed);
-    
-    char *bech32_address_uncompressed = public_key_to_address(pub_hex_uncomp, "BECH32");
-    if (bech32_address_uncompressed != NULL)
-      printf("Bech32 (Starts with bc1) Address (Uncompressed): %s\n", bech32_address_uncompressed);
-    free(bech32_address_uncompressed);
-
-    char *bech32m_address_uncompressed = public_key_to_address(pub_hex_uncomp, "BECH32M");
-      if (bech32m_address_uncompressed != NULL)
-      printf("Bech32m (Starts with bc1p) Address (Uncompressed): %s\n", bech32m_address_uncompressed);
-    free(bech32m_address_uncompressed);
-    
-    char *p2wsh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2WSH");
-        if (p2wsh_address_uncompressed != NULL)
-      printf("P2WSH (Starts with bc1) Address (Uncompressed): %s (P2WSH => P2PKH)\n", p2wsh_address_uncompressed);
-    free(p2wsh_address_uncompressed);
-    
-    char *p2wsh_p2wpkh_address_uncompressed = public_key_to_address(pub_hex_uncomp, "P2WSH-P2WPKH");
-        if (p2wsh_p2wpkh_address_uncompressed != NULL)
-      printf("P2WSH (Starts with bc1) Address (Uncompressed): %s (P2WSH => P2WPKH)\n", p2wsh_p2wpkh_address_uncompressed);
-   free(p2wsh_p2wpkh_address_uncompressed);
+    address_print(&addr_uncomp, "Uncompressed");
 
-    /* 释放 GMP 与 ECC 资源 */
-    mpz_clear(priv);
-    point_clear(&pub);
-    point_clear(&G);
-    mpz_clear(EC.p);
-    mpz_clear(EC.a);
-    mpz_clear(EC.b);
-    mpz_clear(EC.n);
-    
     return 0;
 }
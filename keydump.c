@@ -0,0 +1,135 @@
+/*
+ * keydump.c
+ *
+ * 将 Brain --format bin 写出的定长二进制记录（见 pipeline/pipeline.h）还原为文本。
+ * 输出与 Brain 文本批量模式相同的制表符分隔记录：公钥由私钥重新计算，hash160 直接
+ * 取自记录。给出 --input 原词表且记录带偏移时第一列为原短语，否则为偏移量
+ * （不带偏移时为 "-"）。
+ *
+ * 用法: keydump [--input <wordlist>] [records.bin]   （省略文件时读标准输入）
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "brainwallet/brainwallet.h"
+#include "pipeline/pipeline.h"
+#include "wordlist/wordlist.h"
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [--input <wordlist>] [records.bin]\n", prog);
+    fprintf(stderr, "  --input File   生成记录时使用的词表，用记录中的偏移还原短语\n");
+}
+
+/* 还原一批记录的短语列：原短语、十进制偏移或 "-" */
+static void fill_phrases(PIPELINE_BATCH *batch, const WORDLIST *wl, unsigned flags,
+                         char names[][24]) {
+    for (size_t i = 0; i < batch->count; i++) {
+        if (!(flags & PIPELINE_BIN_OFFSETS)) {
+            batch->phrases[i] = "-";
+            batch->lens[i] = 1;
+        } else if (wl == NULL || !wordlist_line_at(wl, batch->offsets[i], &batch->phrases[i], &batch->lens[i])) {
+            batch->lens[i] = (size_t)snprintf(names[i], sizeof(names[i]), "%llu",
+                                              (unsigned long long)batch->offsets[i]);
+            batch->phrases[i] = names[i];
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *input = NULL;
+    int argi = 1;
+    if (argi + 1 < argc && strcmp(argv[argi], "--input") == 0) {
+        input = argv[argi + 1];
+        argi += 2;
+    }
+    if (argc - argi > 1 || (argi < argc && strncmp(argv[argi], "--", 2) == 0)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE *in = stdin;
+    if (argi < argc && strcmp(argv[argi], "-") != 0) {
+        in = fopen(argv[argi], "rb");
+        if (in == NULL) {
+            fprintf(stderr, "Error: 无法打开 %s\n", argv[argi]);
+            return 1;
+        }
+    }
+    PIPELINE_BIN_HEADER header;
+    uint8_t header_buf[PIPELINE_BIN_HEADER_SIZE];
+    size_t record_size;
+    if (fread(header_buf, sizeof(header_buf), 1, in) != 1 ||
+        (record_size = pipeline_bin_header_check(header_buf, &header)) == 0) {
+        fprintf(stderr, "Error: 不是 Brain 二进制记录文件\n");
+        return 1;
+    }
+    WORDLIST wl;
+    if (input != NULL && wordlist_open(&wl, input) != 0) {
+        fprintf(stderr, "Error: 无法打开输入文件 %s\n", input);
+        return 1;
+    }
+
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+    PIPELINE_BATCH *batch = (PIPELINE_BATCH *)calloc(1, sizeof(PIPELINE_BATCH));
+    uint8_t *records = (uint8_t *)malloc(PIPELINE_BATCH_SIZE * record_size);
+    char (*names)[24] = malloc(PIPELINE_BATCH_SIZE * sizeof(*names));
+    PIPELINE_OUTPUT out = {0};
+    if (batch == NULL || records == NULL || names == NULL) {
+        fprintf(stderr, "Error: 内存分配失败\n");
+        return 1;
+    }
+
+    int ret = 0;
+    uint64_t total = 0;
+    size_t n;
+    while ((n = fread(records, record_size, PIPELINE_BATCH_SIZE, in)) > 0) {
+        batch->count = n;
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t *rec = records + i * record_size;
+            memcpy(batch->privkeys + i * BW_PRIVKEY_LEN, rec, BW_PRIVKEY_LEN);
+            memcpy(batch->hash_comp + i * BW_HASH160_LEN, rec + BW_PRIVKEY_LEN, BW_HASH160_LEN);
+            memcpy(batch->hash_uncomp + i * BW_HASH160_LEN, rec + BW_PRIVKEY_LEN + BW_HASH160_LEN, BW_HASH160_LEN);
+            uint64_t off = 0;
+            if (header.flags & PIPELINE_BIN_OFFSETS) {
+                for (int b = 7; b >= 0; b--)
+                    off = (off << 8) | rec[PIPELINE_BIN_RECORD_BASE + b];
+            }
+            batch->offsets[i] = off;
+            batch->valid[i] = 1;
+        }
+        /* 记录中不会有为 0 的私钥；万一出现，该条公钥为零，跳过 */
+        if (bw_privkeys_to_pubkeys(&ctx, batch->privkeys, n, batch->pub_comp, batch->pub_uncomp) != 0) {
+            for (size_t i = 0; i < n; i++)
+                batch->valid[i] = batch->pub_uncomp[i * BW_PUBKEY_UNCOMPRESSED_LEN] == 0x04;
+        }
+        fill_phrases(batch, input != NULL ? &wl : NULL, header.flags, names);
+        pipeline_derive_addresses(batch, NULL);
+        if (pipeline_format(batch, &out) != 0 || pipeline_output_flush(&out, stdout) != 0) {
+            fprintf(stderr, "Error: 输出失败\n");
+            ret = 1;
+            break;
+        }
+        total += n;
+    }
+    if (ret == 0 && ferror(in)) {
+        fprintf(stderr, "Error: 读取记录失败\n");
+        ret = 1;
+    }
+    fflush(stdout);
+    fprintf(stderr, "Records: %llu\n", (unsigned long long)total);
+
+    pipeline_output_free(&out);
+    free(names);
+    free(records);
+    free(batch);
+    bw_ctx_free(&ctx);
+    if (input != NULL)
+        wordlist_close(&wl);
+    if (in != stdin)
+        fclose(in);
+    return ret;
+}
@@ -0,0 +1,322 @@
+/*
+ * loadtargets.c
+ *
+ * 将一行一个地址的文本文件转换为排序、去重的二进制目标集合（见 targets/targets.h）。
+ * 输入通过 mmap 读取并按换行切分给多个线程并行解析、排序，最后由主线程多路归并去重。
+ *
+ * 用法: loadtargets [-t 线程数] <addresses.txt> <targets.bin>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "targets/targets.h"
+#include "bech32/bech32.h"
+
+/* 每个线程最多向 stderr 报告的错误行数 */
+#define MAX_REPORTED_ERRORS 10
+
+/* bc1 地址按批解码的批大小 */
+#define SEGWIT_BATCH 256
+
+typedef struct {
+    const char *data;       /* 整个输入文件 */
+    size_t begin, end;      /* 本线程负责的字节范围，起点位于行首 */
+    TARGET_RECORD *records;
+    size_t count, capacity;
+    uint64_t lines, malformed;
+    unsigned reported;
+    int failed;
+} LOAD_CHUNK;
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-t threads] <addresses.txt> <targets.bin>\n", prog);
+}
+
+static int is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* 排序后原地去重，返回剩余条数 */
+static size_t dedup_records(TARGET_RECORD *records, size_t count) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (n == 0 || target_record_compare(&records[n - 1], &records[i]) != 0)
+            records[n++] = records[i];
+    }
+    return n;
+}
+
+/* 为下一条记录预留空间，失败返回 NULL */
+static TARGET_RECORD *chunk_slot(LOAD_CHUNK *chunk) {
+    if (chunk->count == chunk->capacity) {
+        size_t cap = chunk->capacity ? chunk->capacity * 2 : 4096;
+        TARGET_RECORD *p = (TARGET_RECORD *)realloc(chunk->records, cap * sizeof(TARGET_RECORD));
+        if (p == NULL) {
+            chunk->failed = 1;
+            return NULL;
+        }
+        chunk->records = p;
+        chunk->capacity = cap;
+    }
+    return &chunk->records[chunk->count];
+}
+
+static void report_malformed(LOAD_CHUNK *chunk, size_t offset, const char *addr, size_t len) {
+    chunk->malformed++;
+    if (chunk->reported++ < MAX_REPORTED_ERRORS)
+        fprintf(stderr, "Warning: 无效地址（字节偏移 %zu）: %.*s\n", offset, (int)len, addr);
+}
+
+/* 一批待解码的 bc1 地址，交给 segwit_addr_decode_many 一次处理 */
+typedef struct {
+    const char *addrs[SEGWIT_BATCH];
+    size_t lens[SEGWIT_BATCH];
+    size_t offsets[SEGWIT_BATCH];
+    SEGWIT_RECORD records[SEGWIT_BATCH];
+    size_t count;
+} SEGWIT_BATCH_BUF;
+
+static int flush_segwit(LOAD_CHUNK *chunk, SEGWIT_BATCH_BUF *batch) {
+    segwit_addr_decode_many("bc", batch->addrs, batch->lens, batch->count, batch->records);
+    for (size_t i = 0; i < batch->count; i++) {
+        const SEGWIT_RECORD *seg = &batch->records[i];
+        TARGET_RECORD *rec = chunk_slot(chunk);
+        if (rec == NULL)
+            return -1;
+        if (seg->encoding != BECH32_ENCODING_NONE &&
+            target_from_witness(seg->witver, seg->witprog, seg->witprog_len, rec))
+            chunk->count++;
+        else
+            report_malformed(chunk, batch->offsets[i], batch->addrs[i], batch->lens[i]);
+    }
+    batch->count = 0;
+    return 0;
+}
+
+static void *load_chunk(void *arg) {
+    LOAD_CHUNK *chunk = (LOAD_CHUNK *)arg;
+    size_t pos = chunk->begin;
+    SEGWIT_BATCH_BUF *batch = (SEGWIT_BATCH_BUF *)malloc(sizeof(SEGWIT_BATCH_BUF));
+    if (batch == NULL) {
+        chunk->failed = 1;
+        return NULL;
+    }
+    batch->count = 0;
+
+    while (pos < chunk->end) {
+        const char *line = chunk->data + pos;
+        const char *nl = memchr(line, '\n', chunk->end - pos);
+        size_t line_len = nl ? (size_t)(nl - line) : chunk->end - pos;
+        size_t line_off = pos;
+        pos += line_len + 1;
+
+        /* 去掉首尾空白，跳过空行与 # 注释 */
+        size_t s = 0, e = line_len;
+        while (s < e && is_space(line[s])) s++;
+        while (e > s && is_space(line[e - 1])) e--;
+        if (s == e || line[s] == '#')
+            continue;
+        chunk->lines++;
+
+        if (target_is_segwit(line + s, e - s)) {
+            batch->addrs[batch->count] = line + s;
+            batch->lens[batch->count] = e - s;
+            batch->offsets[batch->count] = line_off + s;
+            if (++batch->count == SEGWIT_BATCH && flush_segwit(chunk, batch) != 0)
+                break;
+            continue;
+        }
+        TARGET_RECORD *rec = chunk_slot(chunk);
+        if (rec == NULL)
+            break;
+        if (target_parse_address(line + s, e - s, rec))
+            chunk->count++;
+        else
+            report_malformed(chunk, line_off + s, line + s, e - s);
+    }
+    if (!chunk->failed && batch->count > 0)
+        flush_segwit(chunk, batch);
+    free(batch);
+    if (chunk->failed)
+        return NULL;
+
+    qsort(chunk->records, chunk->count, sizeof(TARGET_RECORD), target_record_compare);
+    chunk->count = dedup_records(chunk->records, chunk->count);
+    return NULL;
+}
+
+/* 最小堆：按各块当前记录排序 */
+typedef struct {
+    const TARGET_RECORD *cur, *end;
+} MERGE_HEAD;
+
+static void heap_sift_down(MERGE_HEAD *heap, size_t n, size_t i) {
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, m = i;
+        if (l < n && target_record_compare(heap[l].cur, heap[m].cur) < 0) m = l;
+        if (r < n && target_record_compare(heap[r].cur, heap[m].cur) < 0) m = r;
+        if (m == i)
+            return;
+        MERGE_HEAD t = heap[i]; heap[i] = heap[m]; heap[m] = t;
+        i = m;
+    }
+}
+
+/* 多路归并各块的有序记录并去重，返回合并后的条数 */
+static size_t merge_chunks(LOAD_CHUNK *chunks, int nchunks, TARGET_RECORD *out) {
+    MERGE_HEAD *heap = (MERGE_HEAD *)malloc((size_t)nchunks * sizeof(MERGE_HEAD));
+    if (heap == NULL)
+        return (size_t)-1;
+    size_t n = 0, count = 0;
+    for (int i = 0; i < nchunks; i++) {
+        if (chunks[i].count > 0) {
+            heap[n].cur = chunks[i].records;
+            heap[n].end = chunks[i].records + chunks[i].count;
+            n++;
+        }
+    }
+    for (size_t i = n; i-- > 0;)
+        heap_sift_down(heap, n, i);
+
+    while (n > 0) {
+        const TARGET_RECORD *r = heap[0].cur;
+        if (count == 0 || target_record_compare(&out[count - 1], r) != 0)
+            out[count++] = *r;
+        if (++heap[0].cur == heap[0].end)
+            heap[0] = heap[--n];
+        heap_sift_down(heap, n, 0);
+    }
+    free(heap);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int argi = 1;
+    if (argi + 1 < argc && strcmp(argv[argi], "-t") == 0) {
+        char *end;
+        threads = strtol(argv[argi + 1], &end, 10);
+        if (*end != '\0' || threads < 1 || threads > 1024) {
+            fprintf(stderr, "Error: 无效的线程数 %s\n", argv[argi + 1]);
+            return 1;
+        }
+        argi += 2;
+    }
+    if (argc - argi != 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+    const char *in_path = argv[argi];
+    const char *out_path = argv[argi + 1];
+
+    int fd = open(in_path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: 无法打开 %s\n", in_path);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: 无法读取 %s\n", in_path);
+        close(fd);
+        return 1;
+    }
+    size_t size = (size_t)st.st_size;
+    const char *data = NULL;
+    if (size > 0) {
+        void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "Error: 无法映射 %s\n", in_path);
+            close(fd);
+            return 1;
+        }
+        madvise(map, size, MADV_SEQUENTIAL);
+        data = (const char *)map;
+    }
+    close(fd);
+
+    /* 小文件不值得多线程 */
+    if ((size_t)threads > size / 4096 + 1)
+        threads = (long)(size / 4096 + 1);
+
+    LOAD_CHUNK *chunks = (LOAD_CHUNK *)calloc((size_t)threads, sizeof(LOAD_CHUNK));
+    pthread_t *tids = (pthread_t *)malloc((size_t)threads * sizeof(pthread_t));
+    if (chunks == NULL || tids == NULL) {
+        fprintf(stderr, "Error: 内存分配失败\n");
+        return 1;
+    }
+
+    /* 按大小均分，再把每个分界点推到下一行行首 */
+    size_t prev = 0;
+    for (long i = 0; i < threads; i++) {
+        size_t end = (i == threads - 1) ? size : size / (size_t)threads * (size_t)(i + 1);
+        if (end < prev)
+            end = prev;
+        while (end < size && end > 0 && data[end - 1] != '\n')
+            end++;
+        chunks[i].data = data;
+        chunks[i].begin = prev;
+        chunks[i].end = end;
+        prev = end;
+    }
+
+    for (long i = 1; i < threads; i++) {
+        if (pthread_create(&tids[i], NULL, load_chunk, &chunks[i]) != 0) {
+            fprintf(stderr, "Error: 无法创建线程\n");
+            return 1;
+        }
+    }
+    load_chunk(&chunks[0]);
+    for (long i = 1; i < threads; i++)
+        pthread_join(tids[i], NULL);
+
+    uint64_t lines = 0, malformed = 0;
+    size_t total = 0;
+    for (long i = 0; i < threads; i++) {
+        if (chunks[i].failed) {
+            fprintf(stderr, "Error: 内存分配失败\n");
+            return 1;
+        }
+        lines += chunks[i].lines;
+        malformed += chunks[i].malformed;
+        total += chunks[i].count;
+    }
+
+    TARGET_RECORD *merged = (TARGET_RECORD *)malloc((total ? total : 1) * sizeof(TARGET_RECORD));
+    size_t unique = merged ? merge_chunks(chunks, (int)threads, merged) : (size_t)-1;
+    if (unique == (size_t)-1) {
+        fprintf(stderr, "Error: 内存分配失败\n");
+        return 1;
+    }
+    for (long i = 0; i < threads; i++)
+        free(chunks[i].records);
+    free(chunks);
+    free(tids);
+    if (data != NULL)
+        munmap((void *)data, size);
+
+    if (targets_write(out_path, merged, unique) != 0) {
+        free(merged);
+        return 1;
+    }
+    size_t wide = 0;
+    for (size_t i = 0; i < unique; i++)
+        wide += merged[i].len != 20;
+    free(merged);
+
+    fprintf(stderr, "Lines: %llu, malformed: %llu, unique targets: %zu (%ld threads)\n",
+            (unsigned long long)lines, (unsigned long long)malformed, unique, threads);
+    if (wide > 0)
+        fprintf(stderr, "Warning: 其中 %zu 条为 32 字节程序（P2WSH、Taproot 等），Brain 只匹配 20 字节的 hash160，"
+                        "这些目标不会命中\n", wide);
+    return 0;
+}
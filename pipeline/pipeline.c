@@ -0,0 +1,474 @@
+/*
+ * pipeline.c
+ *
+ * Brain 批量模式的推导流水线与记录格式化。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "pipeline.h"
+
+#include "../customutil/customutil.h"
+#include "../targets/targets.h"
+
+/* P2SH-P2WPKH 赎回脚本长度：OP_0 PUSH20 <hash160> */
+#define PIPELINE_REDEEM_SCRIPT_LEN (2 + BW_HASH160_LEN)
+
+/* 各列需要的推导阶段 */
+static unsigned column_stages(unsigned col) {
+    switch (col) {
+    case PIPELINE_COL_PRIV:
+    case PIPELINE_COL_WIF_COMP:
+    case PIPELINE_COL_WIF_UNCOMP:
+        return 0;
+    case PIPELINE_COL_PUB_COMP:
+        return PIPELINE_STAGE_PUB_COMP;
+    case PIPELINE_COL_PUB_UNCOMP:
+        return PIPELINE_STAGE_PUB_UNCOMP;
+    case PIPELINE_COL_HASH160_COMP:
+        return PIPELINE_STAGE_HASH_COMP;
+    case PIPELINE_COL_HASH160_UNCOMP:
+        return PIPELINE_STAGE_HASH_UNCOMP;
+    }
+    int comp = col < PIPELINE_COL_ADDR_UNCOMP;
+    unsigned type = 1u << (col - (comp ? PIPELINE_COL_ADDR_COMP : PIPELINE_COL_ADDR_UNCOMP));
+    if (type & ADDRESS_NEEDS_HASH160)
+        return comp ? PIPELINE_STAGE_HASH_COMP : PIPELINE_STAGE_HASH_UNCOMP;
+    return comp ? PIPELINE_STAGE_PUB_COMP : PIPELINE_STAGE_PUB_UNCOMP;
+}
+
+static int plan_add(PIPELINE_PLAN *plan, unsigned col) {
+    if (plan->ncolumns == PIPELINE_MAX_COLUMNS)
+        return -1;
+    plan->columns[plan->ncolumns++] = (uint8_t)col;
+    plan->stages |= column_stages(col);
+    if (col >= PIPELINE_COL_ADDR_UNCOMP)
+        plan->types_uncomp |= 1u << (col - PIPELINE_COL_ADDR_UNCOMP);
+    else if (col >= PIPELINE_COL_ADDR_COMP)
+        plan->types_comp |= 1u << (col - PIPELINE_COL_ADDR_COMP);
+    return 0;
+}
+
+void pipeline_plan_full(PIPELINE_PLAN *plan) {
+    memset(plan, 0, sizeof(*plan));
+    plan_add(plan, PIPELINE_COL_PRIV);
+    plan_add(plan, PIPELINE_COL_WIF_COMP);
+    plan_add(plan, PIPELINE_COL_WIF_UNCOMP);
+    for (unsigned t = 0; t < ADDRESS_TYPE_COUNT; t++)
+        plan_add(plan, PIPELINE_COL_ADDR_COMP + t);
+    for (unsigned t = 0; t < ADDRESS_TYPE_COUNT; t++)
+        plan_add(plan, PIPELINE_COL_ADDR_UNCOMP + t);
+}
+
+/* 解析一个列名，*comp_col 为压缩（或唯一）列，*uncomp_col 为非压缩列，没有时为 -1 */
+static int parse_column(const char *name, int *comp_col, int *uncomp_col) {
+    char base[32];
+    size_t len = strlen(name);
+    int want_comp = 1, want_uncomp = 1;
+    *comp_col = *uncomp_col = -1;
+    if (strcasecmp(name, "priv") == 0) {
+        *comp_col = PIPELINE_COL_PRIV;
+        return 0;
+    }
+    if (len > 2 && name[len - 2] == '-' && (name[len - 1] == 'c' || name[len - 1] == 'C')) {
+        want_uncomp = 0;
+        len -= 2;
+    } else if (len > 2 && name[len - 2] == '-' && (name[len - 1] == 'u' || name[len - 1] == 'U')) {
+        want_comp = 0;
+        len -= 2;
+    }
+    if (len == 0 || len >= sizeof(base))
+        return -1;
+    memcpy(base, name, len);
+    base[len] = '\0';
+
+    int col_comp, col_uncomp;
+    if (strcasecmp(base, "wif") == 0) {
+        col_comp = PIPELINE_COL_WIF_COMP;
+        col_uncomp = PIPELINE_COL_WIF_UNCOMP;
+    } else if (strcasecmp(base, "pub") == 0) {
+        col_comp = PIPELINE_COL_PUB_COMP;
+        col_uncomp = PIPELINE_COL_PUB_UNCOMP;
+    } else if (strcasecmp(base, "hash160") == 0) {
+        col_comp = PIPELINE_COL_HASH160_COMP;
+        col_uncomp = PIPELINE_COL_HASH160_UNCOMP;
+    } else {
+        ADDRESS_TYPE type = strcasecmp(base, "p2wpkh") == 0 ? ADDRESS_BECH32 : address_type_from_name(base);
+        if (type == 0)
+            return -1;
+        col_comp = PIPELINE_COL_ADDR_COMP + __builtin_ctz(type);
+        col_uncomp = PIPELINE_COL_ADDR_UNCOMP + __builtin_ctz(type);
+    }
+    if (want_comp)
+        *comp_col = col_comp;
+    if (want_uncomp)
+        *uncomp_col = col_uncomp;
+    return 0;
+}
+
+int pipeline_plan_parse(const char *spec, PIPELINE_PLAN *plan, const char **bad) {
+    char name[64];
+    memset(plan, 0, sizeof(*plan));
+    const char *p = spec;
+    while (*p != '\0') {
+        const char *end = strchr(p, ',');
+        size_t len = end != NULL ? (size_t)(end - p) : strlen(p);
+        while (len > 0 && (*p == ' ' || *p == '\t')) {
+            p++;
+            len--;
+        }
+        while (len > 0 && (p[len - 1] == ' ' || p[len - 1] == '\t'))
+            len--;
+        if (bad != NULL)
+            *bad = p;
+        if (len >= sizeof(name))
+            return -1;
+        memcpy(name, p, len);
+        name[len] = '\0';
+
+        int comp_col, uncomp_col;
+        if (strcasecmp(name, "all") == 0) {
+            PIPELINE_PLAN full;
+            pipeline_plan_full(&full);
+            for (size_t i = 0; i < full.ncolumns; i++) {
+                if (plan_add(plan, full.columns[i]) != 0)
+                    return -1;
+            }
+        } else if (parse_column(name, &comp_col, &uncomp_col) != 0 ||
+                   (comp_col >= 0 && plan_add(plan, (unsigned)comp_col) != 0) ||
+                   (uncomp_col >= 0 && plan_add(plan, (unsigned)uncomp_col) != 0)) {
+            return -1;
+        }
+        if (end == NULL)
+            break;
+        p = end + 1;
+    }
+    if (plan->ncolumns == 0) {
+        if (bad != NULL)
+            *bad = spec;
+        return -1;
+    }
+    return 0;
+}
+
+void pipeline_derive_keys(const BW_CTX *ctx, PIPELINE_BATCH *batch, uint64_t iterations, unsigned stages) {
+    size_t n = batch->count;
+    if ((stages & PIPELINE_STAGE_PRESET) == 0)
+        bw_phrases_to_privkeys(batch->phrases, batch->lens, n, iterations, batch->privkeys);
+    if ((stages & (PIPELINE_STAGE_PUB_COMP | PIPELINE_STAGE_PUB_UNCOMP)) == 0) {
+        /* 不需要公钥：只排除为 0 的私钥 */
+        static const uint8_t zero[BW_PRIVKEY_LEN];
+        for (size_t i = 0; i < n; i++)
+            batch->valid[i] = memcmp(batch->privkeys + i * BW_PRIVKEY_LEN, zero, BW_PRIVKEY_LEN) != 0;
+        return;
+    }
+    uint8_t *comp = (stages & PIPELINE_STAGE_PUB_COMP) ? batch->pub_comp : NULL;
+    uint8_t *uncomp = (stages & PIPELINE_STAGE_PUB_UNCOMP) ? batch->pub_uncomp : NULL;
+    if (bw_privkeys_to_pubkeys(ctx, batch->privkeys, n, comp, uncomp) != 0) {
+        /* 私钥为 0 的条目公钥被置零：逐条检查前缀字节 */
+        for (size_t i = 0; i < n; i++)
+            batch->valid[i] = comp != NULL ? comp[i * BW_PUBKEY_COMPRESSED_LEN] != 0
+                                           : uncomp[i * BW_PUBKEY_UNCOMPRESSED_LEN] != 0;
+    } else {
+        for (size_t i = 0; i < n; i++)
+            batch->valid[i] = 1;
+    }
+    if ((stages & PIPELINE_STAGE_HASH_COMP) == PIPELINE_STAGE_HASH_COMP)
+        bw_pubkeys_to_hash160s(batch->pub_comp, BW_PUBKEY_COMPRESSED_LEN, n, batch->hash_comp);
+    if ((stages & PIPELINE_STAGE_HASH_UNCOMP) == PIPELINE_STAGE_HASH_UNCOMP)
+        bw_pubkeys_to_hash160s(batch->pub_uncomp, BW_PUBKEY_UNCOMPRESSED_LEN, n, batch->hash_uncomp);
+}
+
+/* 为一种公钥编码 types 中的地址，hashes 为 NULL 表示未计算 hash160（只有 P2WSH） */
+static void encode_addresses(PIPELINE_BATCH *batch, const uint8_t *pubkeys, size_t pubkey_len,
+                             const uint8_t *hashes, unsigned types, ADDRESS_SET *sets) {
+    size_t n = batch->count, valid = 0;
+    if (types == 0)
+        return;
+    for (size_t i = 0; i < n; i++)
+        valid += batch->valid[i] != 0;
+    if (valid == n) {
+        bw_pubkeys_to_addresses(pubkeys, pubkey_len, hashes, n, types, sets);
+        return;
+    }
+    /* 只有部分条目需要输出（目标匹配或私钥为 0）：逐条编码 */
+    for (size_t i = 0; i < n; i++) {
+        if (batch->valid[i])
+            bw_pubkeys_to_addresses(pubkeys + i * pubkey_len, pubkey_len,
+                                    hashes != NULL ? hashes + i * BW_HASH160_LEN : NULL, 1, types, &sets[i]);
+    }
+}
+
+void pipeline_derive_addresses(PIPELINE_BATCH *batch, const PIPELINE_PLAN *plan) {
+    unsigned types_comp = plan != NULL ? plan->types_comp : ADDRESS_ALL;
+    unsigned types_uncomp = plan != NULL ? plan->types_uncomp : ADDRESS_ALL;
+    encode_addresses(batch, batch->pub_comp, BW_PUBKEY_COMPRESSED_LEN,
+                     (types_comp & ADDRESS_NEEDS_HASH160) ? batch->hash_comp : NULL,
+                     types_comp, batch->addr_comp);
+    encode_addresses(batch, batch->pub_uncomp, BW_PUBKEY_UNCOMPRESSED_LEN,
+                     (types_uncomp & ADDRESS_NEEDS_HASH160) ? batch->hash_uncomp : NULL,
+                     types_uncomp, batch->addr_uncomp);
+}
+
+void pipeline_derive(const BW_CTX *ctx, PIPELINE_BATCH *batch, uint64_t iterations) {
+    pipeline_derive_keys(ctx, batch, iterations, PIPELINE_STAGE_KEYS);
+    pipeline_derive_addresses(batch, NULL);
+}
+
+/* P2SH-P2WPKH 赎回脚本 0x00 0x14 <hash160> 的 hash160，整批一起计算 */
+static void redeem_script_hashes(const uint8_t *hashes, size_t n, uint8_t *out) {
+    uint8_t scripts[PIPELINE_BATCH_SIZE * PIPELINE_REDEEM_SCRIPT_LEN];
+    for (size_t i = 0; i < n; i++) {
+        uint8_t *s = scripts + i * PIPELINE_REDEEM_SCRIPT_LEN;
+        s[0] = 0x00;
+        s[1] = BW_HASH160_LEN;
+        memcpy(s + 2, hashes + i * BW_HASH160_LEN, BW_HASH160_LEN);
+    }
+    bw_pubkeys_to_hash160s(scripts, PIPELINE_REDEEM_SCRIPT_LEN, n, out);
+}
+
+size_t pipeline_match(PIPELINE_BATCH *batch, const TARGET_INDEX *targets) {
+    size_t n = batch->count, hits = 0;
+    uint8_t script_comp[PIPELINE_BATCH_SIZE * BW_HASH160_LEN];
+    uint8_t script_uncomp[PIPELINE_BATCH_SIZE * BW_HASH160_LEN];
+    redeem_script_hashes(batch->hash_comp, n, script_comp);
+    redeem_script_hashes(batch->hash_uncomp, n, script_uncomp);
+
+    /* 先对整批预取过滤器块，让各次缓存未命中重叠 */
+    const uint8_t *keys[4] = { batch->hash_comp, batch->hash_uncomp, script_comp, script_uncomp };
+    for (int k = 0; k < 4; k++) {
+        for (size_t i = 0; i < n; i++)
+            target_index_prefetch(targets, keys[k] + i * BW_HASH160_LEN);
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!batch->valid[i])
+            continue;
+        int hit = 0;
+        for (int k = 0; k < 4 && !hit; k++)
+            hit = target_index_contains(targets, keys[k] + i * BW_HASH160_LEN);
+        batch->valid[i] = hit;
+        hits += hit;
+    }
+    return hits;
+}
+
+static int output_reserve(PIPELINE_OUTPUT *out, size_t extra) {
+    if (out->len + extra <= out->cap)
+        return 0;
+    size_t cap = out->cap ? out->cap : 1 << 20;
+    while (cap < out->len + extra)
+        cap *= 2;
+    char *grown = (char *)realloc(out->data, cap);
+    if (grown == NULL)
+        return -1;
+    out->data = grown;
+    out->cap = cap;
+    return 0;
+}
+
+/* 追加一个字段及其后的分隔符 */
+static inline char *put_field(char *p, const char *s, char sep) {
+    size_t len = strlen(s);
+    memcpy(p, s, len);
+    p[len] = sep;
+    return p + len + 1;
+}
+
+/* 各列的长度上限 */
+static size_t column_max_len(unsigned col) {
+    switch (col) {
+    case PIPELINE_COL_PRIV:
+        return 2 * BW_PRIVKEY_LEN;
+    case PIPELINE_COL_WIF_COMP:
+    case PIPELINE_COL_WIF_UNCOMP:
+        return BW_WIF_MAX_LEN;
+    case PIPELINE_COL_PUB_COMP:
+        return 2 * BW_PUBKEY_COMPRESSED_LEN;
+    case PIPELINE_COL_PUB_UNCOMP:
+        return 2 * BW_PUBKEY_UNCOMPRESSED_LEN;
+    case PIPELINE_COL_HASH160_COMP:
+    case PIPELINE_COL_HASH160_UNCOMP:
+        return 2 * BW_HASH160_LEN;
+    }
+    return ADDRESS_MAX_LEN;
+}
+
+/* 写出第 i 条的一列，返回写入后的位置（不含分隔符） */
+static char *put_column(char *p, const PIPELINE_BATCH *batch, size_t i, unsigned col) {
+    const uint8_t *priv = batch->privkeys + i * BW_PRIVKEY_LEN;
+    char wif[BW_WIF_MAX_LEN + 1];
+    switch (col) {
+    case PIPELINE_COL_PRIV:
+        hex_encode(p, priv, BW_PRIVKEY_LEN);
+        return p + 2 * BW_PRIVKEY_LEN;
+    case PIPELINE_COL_WIF_COMP:
+    case PIPELINE_COL_WIF_UNCOMP:
+        bw_wif_encode(priv, col == PIPELINE_COL_WIF_COMP, wif, sizeof(wif));
+        return put_field(p, wif, '\t') - 1;
+    case PIPELINE_COL_PUB_COMP:
+        hex_encode(p, batch->pub_comp + i * BW_PUBKEY_COMPRESSED_LEN, BW_PUBKEY_COMPRESSED_LEN);
+        return p + 2 * BW_PUBKEY_COMPRESSED_LEN;
+    case PIPELINE_COL_PUB_UNCOMP:
+        hex_encode(p, batch->pub_uncomp + i * BW_PUBKEY_UNCOMPRESSED_LEN, BW_PUBKEY_UNCOMPRESSED_LEN);
+        return p + 2 * BW_PUBKEY_UNCOMPRESSED_LEN;
+    case PIPELINE_COL_HASH160_COMP:
+        hex_encode(p, batch->hash_comp + i * BW_HASH160_LEN, BW_HASH160_LEN);
+        return p + 2 * BW_HASH160_LEN;
+    case PIPELINE_COL_HASH160_UNCOMP:
+        hex_encode(p, batch->hash_uncomp + i * BW_HASH160_LEN, BW_HASH160_LEN);
+        return p + 2 * BW_HASH160_LEN;
+    }
+    if (col >= PIPELINE_COL_ADDR_UNCOMP)
+        return put_field(p, batch->addr_uncomp[i].addr[col - PIPELINE_COL_ADDR_UNCOMP], '\t') - 1;
+    return put_field(p, batch->addr_comp[i].addr[col - PIPELINE_COL_ADDR_COMP], '\t') - 1;
+}
+
+int pipeline_format_plan(const PIPELINE_BATCH *batch, const PIPELINE_PLAN *plan, PIPELINE_OUTPUT *out) {
+    size_t record_max = 1;
+    for (size_t c = 0; c < plan->ncolumns; c++)
+        record_max += column_max_len(plan->columns[c]) + 1;
+    for (size_t i = 0; i < batch->count; i++) {
+        if (!batch->valid[i])
+            continue;
+        if (output_reserve(out, batch->lens[i] + record_max) != 0)
+            return -1;
+        char *p = out->data + out->len;
+        memcpy(p, batch->phrases[i], batch->lens[i]);
+        p += batch->lens[i];
+        for (size_t c = 0; c < plan->ncolumns; c++) {
+            *p++ = '\t';
+            p = put_column(p, batch, i, plan->columns[c]);
+        }
+        *p++ = '\n';
+        out->len = p - out->data;
+    }
+    return 0;
+}
+
+int pipeline_format(const PIPELINE_BATCH *batch, PIPELINE_OUTPUT *out) {
+    PIPELINE_PLAN full;
+    pipeline_plan_full(&full);
+    return pipeline_format_plan(batch, &full, out);
+}
+
+size_t pipeline_bin_record_size(unsigned flags) {
+    return (flags & PIPELINE_BIN_OFFSETS) ? PIPELINE_BIN_RECORD_MAX : PIPELINE_BIN_RECORD_BASE;
+}
+
+void pipeline_bin_header_init(PIPELINE_BIN_HEADER *header, unsigned flags, uint64_t iterations) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, PIPELINE_BIN_MAGIC, sizeof(header->magic));
+    header->version = PIPELINE_BIN_VERSION;
+    header->record_size = (uint32_t)pipeline_bin_record_size(flags);
+    header->flags = flags & PIPELINE_BIN_OFFSETS;
+    header->iterations = iterations;
+}
+
+/* 小端整数读写，文件头与记录偏移共用 */
+static void store_le(uint8_t *p, uint64_t v, int bytes) {
+    for (int b = 0; b < bytes; b++)
+        p[b] = (uint8_t)(v >> (8 * b));
+}
+
+static uint64_t load_le(const uint8_t *p, int bytes) {
+    uint64_t v = 0;
+    for (int b = bytes - 1; b >= 0; b--)
+        v = v << 8 | p[b];
+    return v;
+}
+
+void pipeline_bin_header_encode(const PIPELINE_BIN_HEADER *header, uint8_t *buf) {
+    memcpy(buf, header->magic, 8);
+    store_le(buf + 8, header->version, 4);
+    store_le(buf + 12, header->record_size, 4);
+    store_le(buf + 16, header->flags, 4);
+    store_le(buf + 20, header->reserved, 4);
+    store_le(buf + 24, header->iterations, 8);
+}
+
+size_t pipeline_bin_header_check(const uint8_t *buf, PIPELINE_BIN_HEADER *header) {
+    memcpy(header->magic, buf, 8);
+    header->version = (uint32_t)load_le(buf + 8, 4);
+    header->record_size = (uint32_t)load_le(buf + 12, 4);
+    header->flags = (uint32_t)load_le(buf + 16, 4);
+    header->reserved = (uint32_t)load_le(buf + 20, 4);
+    header->iterations = load_le(buf + 24, 8);
+    if (memcmp(header->magic, PIPELINE_BIN_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PIPELINE_BIN_VERSION ||
+        (header->flags & ~(uint32_t)PIPELINE_BIN_OFFSETS) != 0 ||
+        header->record_size != pipeline_bin_record_size(header->flags))
+        return 0;
+    return header->record_size;
+}
+
+int pipeline_format_bin(const PIPELINE_BATCH *batch, unsigned flags, PIPELINE_OUTPUT *out) {
+    size_t record_size = pipeline_bin_record_size(flags);
+    if (output_reserve(out, batch->count * record_size) != 0)
+        return -1;
+    uint8_t *p = (uint8_t *)out->data + out->len;
+    for (size_t i = 0; i < batch->count; i++) {
+        if (!batch->valid[i])
+            continue;
+        memcpy(p, batch->privkeys + i * BW_PRIVKEY_LEN, BW_PRIVKEY_LEN);
+        memcpy(p + BW_PRIVKEY_LEN, batch->hash_comp + i * BW_HASH160_LEN, BW_HASH160_LEN);
+        memcpy(p + BW_PRIVKEY_LEN + BW_HASH160_LEN, batch->hash_uncomp + i * BW_HASH160_LEN, BW_HASH160_LEN);
+        if (flags & PIPELINE_BIN_OFFSETS)
+            store_le(p + PIPELINE_BIN_RECORD_BASE, batch->offsets[i], 8);
+        p += record_size;
+    }
+    out->len = (char *)p - out->data;
+    return 0;
+}
+
+void pipeline_keyspace_key(const PIPELINE_KEYSPACE *ks, uint64_t index, uint8_t *key) {
+    unsigned carry = 0;
+    for (int i = BW_PRIVKEY_LEN - 1; i >= 0; i--) {
+        unsigned sum = ks->start[i] + (unsigned)(index & 0xff) + carry;
+        key[i] = (uint8_t)sum;
+        carry = sum >> 8;
+        index >>= 8;
+    }
+}
+
+int pipeline_shard_parse(const char *spec, unsigned *index, unsigned *count) {
+    char *end = NULL;
+    unsigned long i = strtoul(spec, &end, 10);
+    if (end == spec || *end != '/')
+        return -1;
+    const char *rest = end + 1;
+    unsigned long n = strtoul(rest, &end, 10);
+    if (end == rest || *end != '\0' || n == 0 || n > 65536 || i >= n)
+        return -1;
+    *index = (unsigned)i;
+    *count = (unsigned)n;
+    return 0;
+}
+
+unsigned pipeline_shard_of(const char *phrase, size_t len, unsigned count) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)phrase[i];
+        h *= 0x100000001b3ULL;
+    }
+    return (unsigned)(h % count);
+}
+
+uint64_t pipeline_split_point(uint64_t total, uint64_t k, uint64_t parts) {
+    /* total * k / parts，拆成商与余数两部分避免溢出（parts 不超过 2^32） */
+    return total / parts * k + total % parts * k / parts;
+}
+
+int pipeline_output_flush(PIPELINE_OUTPUT *out, FILE *fp) {
+    if (out->len > 0 && fwrite(out->data, 1, out->len, fp) != out->len)
+        return -1;
+    out->len = 0;
+    return 0;
+}
+
+void pipeline_output_free(PIPELINE_OUTPUT *out) {
+    free(out->data);
+    out->data = NULL;
+    out->len = out->cap = 0;
+}
@@ -0,0 +1,287 @@
+/*
+ * pipeline.h
+ *
+ * Brain 批量模式的推导流水线：一批短语依次经过
+ *     短语 -> 私钥 -> 公钥 -> hash160 -> 地址
+ * 每个阶段对整批调用 libbrainwallet 的批量接口，结果以每行一条记录的
+ * 制表符分隔文本追加到输出缓冲区。
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../brainwallet/brainwallet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIPELINE_BATCH_SIZE 256   /* 每批短语数 */
+
+/*
+ * 一批短语及其推导结果。phrases 只是视图（指针 + 长度），
+ * 短语内容由调用者保证在 pipeline_derive/pipeline_format 期间有效，无需以 '\0' 结尾。
+ */
+typedef struct pipeline_batch {
+    size_t count;
+    const char *phrases[PIPELINE_BATCH_SIZE];
+    size_t lens[PIPELINE_BATCH_SIZE];
+    uint8_t privkeys[PIPELINE_BATCH_SIZE * BW_PRIVKEY_LEN];
+    uint8_t pub_comp[PIPELINE_BATCH_SIZE * BW_PUBKEY_COMPRESSED_LEN];
+    uint8_t pub_uncomp[PIPELINE_BATCH_SIZE * BW_PUBKEY_UNCOMPRESSED_LEN];
+    uint8_t hash_comp[PIPELINE_BATCH_SIZE * BW_HASH160_LEN];
+    uint8_t hash_uncomp[PIPELINE_BATCH_SIZE * BW_HASH160_LEN];
+    uint64_t offsets[PIPELINE_BATCH_SIZE];        /* 短语在输入中的字节偏移，二进制输出使用 */
+    int valid[PIPELINE_BATCH_SIZE];               /* 私钥为 0 时为 0，该条不输出 */
+    ADDRESS_SET addr_comp[PIPELINE_BATCH_SIZE];
+    ADDRESS_SET addr_uncomp[PIPELINE_BATCH_SIZE];
+} PIPELINE_BATCH;
+
+/* 可增长的输出缓冲区 */
+typedef struct pipeline_output {
+    char *data;
+    size_t len;
+    size_t cap;
+} PIPELINE_OUTPUT;
+
+struct target_index;
+
+/* 推导阶段（私钥总会计算），后一阶段依赖前一阶段：hash160 需要对应的公钥 */
+#define PIPELINE_STAGE_PUB_COMP     0x1
+#define PIPELINE_STAGE_PUB_UNCOMP   0x2
+#define PIPELINE_STAGE_HASH_COMP    (0x4 | PIPELINE_STAGE_PUB_COMP)
+#define PIPELINE_STAGE_HASH_UNCOMP  (0x8 | PIPELINE_STAGE_PUB_UNCOMP)
+#define PIPELINE_STAGE_KEYS         (PIPELINE_STAGE_HASH_COMP | PIPELINE_STAGE_HASH_UNCOMP)
+#define PIPELINE_STAGE_PRESET       0x10    /* 私钥已由调用者写入 privkeys，跳过短语哈希 */
+
+/* 短语之后可输出的列 */
+typedef enum {
+    PIPELINE_COL_PRIV = 0,
+    PIPELINE_COL_WIF_COMP,
+    PIPELINE_COL_WIF_UNCOMP,
+    PIPELINE_COL_PUB_COMP,
+    PIPELINE_COL_PUB_UNCOMP,
+    PIPELINE_COL_HASH160_COMP,
+    PIPELINE_COL_HASH160_UNCOMP,
+    PIPELINE_COL_ADDR_COMP,                                     /* + 地址类型位序号 */
+    PIPELINE_COL_ADDR_UNCOMP = PIPELINE_COL_ADDR_COMP + ADDRESS_TYPE_COUNT,
+    PIPELINE_COL_COUNT = PIPELINE_COL_ADDR_UNCOMP + ADDRESS_TYPE_COUNT
+} PIPELINE_COLUMN;
+
+#define PIPELINE_MAX_COLUMNS 32
+
+/*
+ * 输出计划：要输出的列，以及由列推出的推导阶段与两种公钥各自需要的地址类型。
+ * 只有计划中的阶段会执行，例如只输出 WIF 时不做标量乘法。
+ */
+typedef struct pipeline_plan {
+    size_t ncolumns;
+    uint8_t columns[PIPELINE_MAX_COLUMNS];   /* PIPELINE_COLUMN，按输出顺序 */
+    unsigned stages;                         /* PIPELINE_STAGE_* */
+    unsigned types_comp;                     /* ADDRESS_TYPE 按位或 */
+    unsigned types_uncomp;
+} PIPELINE_PLAN;
+
+/* 默认计划：私钥、两个 WIF、两种公钥的全部 7 种地址（pipeline_format 的记录） */
+void pipeline_plan_full(PIPELINE_PLAN *plan);
+
+/**
+ * pipeline_plan_parse - 解析 --outputs 列表
+ *
+ * @spec: 逗号分隔的列名（不区分大小写）：priv、wif-c、wif-u、pub-c、pub-u、
+ *        hash160-c、hash160-u、<地址类型>-c、<地址类型>-u，地址类型为 address_type_name
+ *        的名称或 p2wpkh（BECH32 的别名）。不带 -c/-u 后缀时表示两者，
+ *        all 表示默认计划的全部列。
+ *
+ * 成功返回 0；未知列名或列数超过 PIPELINE_MAX_COLUMNS 返回 -1，*bad 指向 spec 中
+ * 出错的列名，到下一个逗号为止（bad 可为 NULL）。
+ */
+int pipeline_plan_parse(const char *spec, PIPELINE_PLAN *plan, const char **bad);
+
+/* 对 batch 中的 count 条短语完成全部推导，iterations 为 SHA-256 应用次数 */
+void pipeline_derive(const BW_CTX *ctx, PIPELINE_BATCH *batch, uint64_t iterations);
+
+/*
+ * pipeline_derive 的两个阶段：keys 推导私钥及 stages 中的公钥、hash160 并设置 valid，
+ * addresses 只为 valid 非 0 的条目编码 plan 需要的地址（plan 为 NULL 时为默认计划）。
+ */
+void pipeline_derive_keys(const BW_CTX *ctx, PIPELINE_BATCH *batch, uint64_t iterations, unsigned stages);
+void pipeline_derive_addresses(PIPELINE_BATCH *batch, const PIPELINE_PLAN *plan);
+
+/**
+ * pipeline_match - 用目标索引筛选批次
+ *
+ * 在 pipeline_derive_keys（stages 含 PIPELINE_STAGE_KEYS）之后调用。检查每条的压缩、非压缩公钥 hash160 及
+ * 对应 P2SH-P2WPKH 赎回脚本的 hash160，未命中的条目 valid 置 0，返回命中条数。
+ */
+size_t pipeline_match(PIPELINE_BATCH *batch, const struct target_index *targets);
+
+/**
+ * pipeline_format - 将推导结果按行追加到 out
+ *
+ * 每条记录一行，字段以制表符分隔，依次为：
+ *     短语、私钥 hex、压缩 WIF、非压缩 WIF、
+ *     压缩公钥的 7 种地址、非压缩公钥的 7 种地址
+ * 地址按 ADDRESS_TYPE 位序排列（P2PKH、P2SH、P2SH-P2WPKH、BECH32、BECH32M、
+ * P2WSH、P2WSH-P2WPKH）。
+ *
+ * 成功返回 0，内存不足返回 -1。
+ */
+int pipeline_format(const PIPELINE_BATCH *batch, PIPELINE_OUTPUT *out);
+
+/* 按计划的列输出：短语之后依次为 plan->columns，公钥与 hash160 为 hex */
+int pipeline_format_plan(const PIPELINE_BATCH *batch, const PIPELINE_PLAN *plan, PIPELINE_OUTPUT *out);
+
+/*
+ * 二进制输出：PIPELINE_BIN_HEADER_SIZE 字节的文件头之后紧跟定长记录，每条依次为
+ *     私钥（32 字节）、压缩公钥 hash160（20 字节）、非压缩公钥 hash160（20 字节）、
+ *     [短语在输入中的字节偏移，8 字节小端，仅 flags 含 PIPELINE_BIN_OFFSETS 时]
+ * 记录顺序与文本输出相同，私钥为 0 的短语同样跳过。keydump 可将记录还原为文本。
+ */
+#define PIPELINE_BIN_MAGIC   "BWKEYREC"
+#define PIPELINE_BIN_VERSION 1
+#define PIPELINE_BIN_OFFSETS 0x1
+
+#define PIPELINE_BIN_RECORD_BASE (BW_PRIVKEY_LEN + 2 * BW_HASH160_LEN)
+#define PIPELINE_BIN_RECORD_MAX  (PIPELINE_BIN_RECORD_BASE + 8)
+
+/* 文件头在磁盘上按字段顺序排列，整数均为小端，与平台无关 */
+#define PIPELINE_BIN_HEADER_SIZE 32
+
+typedef struct pipeline_bin_header {
+    char magic[8];          /* PIPELINE_BIN_MAGIC */
+    uint32_t version;       /* PIPELINE_BIN_VERSION */
+    uint32_t record_size;   /* 每条记录的字节数 */
+    uint32_t flags;         /* PIPELINE_BIN_OFFSETS */
+    uint32_t reserved;
+    uint64_t iterations;    /* 生成记录时的 SHA-256 应用次数 */
+} PIPELINE_BIN_HEADER;
+
+_Static_assert(sizeof(PIPELINE_BIN_HEADER) == PIPELINE_BIN_HEADER_SIZE, "PIPELINE_BIN_HEADER 应为 32 字节");
+
+/* 输出格式 */
+typedef enum {
+    PIPELINE_FORMAT_TEXT = 0,
+    PIPELINE_FORMAT_BIN
+} PIPELINE_FORMAT;
+
+/* 由 flags 得到每条二进制记录的字节数 */
+size_t pipeline_bin_record_size(unsigned flags);
+
+void pipeline_bin_header_init(PIPELINE_BIN_HEADER *header, unsigned flags, uint64_t iterations);
+
+/* 将文件头写成 PIPELINE_BIN_HEADER_SIZE 字节的磁盘格式 */
+void pipeline_bin_header_encode(const PIPELINE_BIN_HEADER *header, uint8_t *buf);
+
+/* 解析并校验 PIPELINE_BIN_HEADER_SIZE 字节的文件头，合法时填入 header 并返回记录大小，否则返回 0 */
+size_t pipeline_bin_header_check(const uint8_t *buf, PIPELINE_BIN_HEADER *header);
+
+/**
+ * pipeline_format_bin - 将推导结果按定长二进制记录追加到 out
+ *
+ * 只需要 pipeline_derive_keys 的结果。成功返回 0，内存不足返回 -1。
+ */
+int pipeline_format_bin(const PIPELINE_BATCH *batch, unsigned flags, PIPELINE_OUTPUT *out);
+
+/*
+ * 私钥区间：序号 i 对应私钥 start + i（256 位大端加法），key 的区间模式使用。
+ * 为 0 的私钥与短语得到的无效私钥一样被跳过；区间不应超出曲线阶，由调用者检查。
+ */
+typedef struct pipeline_keyspace {
+    uint8_t start[BW_PRIVKEY_LEN];
+    uint64_t count;
+} PIPELINE_KEYSPACE;
+
+/* 写出序号 index 对应的私钥，start + index 超过 2^256 时回绕 */
+void pipeline_keyspace_key(const PIPELINE_KEYSPACE *ks, uint64_t index, uint8_t *key);
+
+/*
+ * 多节点分片：count 个节点各运行一次、index 取 0 到 count - 1 时，各节点处理的输入互不重叠且
+ * 合起来覆盖全部输入，结果与线程数无关。
+ *   RANGE：映射词表按字节均分（边界对齐到行首），组合与私钥区间按序号均分，各取连续一段；
+ *   HASH：按短语（规则变换前）的 64 位 FNV-1a 哈希对 count 取模，可用于逐行读取的流。
+ */
+typedef enum {
+    PIPELINE_SHARD_RANGE = 0,
+    PIPELINE_SHARD_HASH
+} PIPELINE_SHARD_MODE;
+
+/* 解析 "i/N"（0 <= i < N <= 65536），成功返回 0 */
+int pipeline_shard_parse(const char *spec, unsigned *index, unsigned *count);
+
+/* 短语属于哪个分片（HASH 方式），与平台和线程数无关 */
+unsigned pipeline_shard_of(const char *phrase, size_t len, unsigned count);
+
+/* 将 [0, total) 均分为 parts 份时第 k 份的起点，k == parts 时为 total，不会溢出 */
+uint64_t pipeline_split_point(uint64_t total, uint64_t k, uint64_t parts);
+
+/* 将缓冲区内容写到 fp 并清空，写入失败返回 -1 */
+int pipeline_output_flush(PIPELINE_OUTPUT *out, FILE *fp);
+
+void pipeline_output_free(PIPELINE_OUTPUT *out);
+
+/*
+ * 流式运行（stream.c）：读取线程把输入切成批次，线程池中的工作线程各自用
+ * 线程私有的 PIPELINE_BATCH 完成推导与格式化，输出按输入顺序或完成顺序写出。
+ * 输入为内存映射词表时不复制短语，批次直接引用映射中的行。
+ */
+struct wordlist;
+struct rule_set;
+struct combinator;
+struct checkpoint;
+
+typedef struct pipeline_stream_config {
+    const BW_CTX *ctx;       /* 只读，各线程共享 */
+    uint64_t iterations;
+    int threads;             /* 工作线程数，<= 0 时使用全部 CPU 核 */
+    int ordered;             /* 非 0 时按输入顺序输出 */
+    FILE *in;
+    FILE *out;
+    const struct wordlist *wordlist;  /* 非 NULL 时从映射词表读取，忽略 in */
+    const struct target_index *targets;  /* 非 NULL 时只输出命中目标的记录 */
+    PIPELINE_FORMAT format;
+    unsigned bin_flags;      /* 二进制输出的 PIPELINE_BIN_* 标志 */
+    const PIPELINE_PLAN *plan;  /* 文本输出的列，NULL 时为默认计划 */
+    const struct rule_set *rules;  /* 非 NULL 时每个输入词经每条规则变换后作为候选 */
+    const struct combinator *combinator;  /* 非 NULL 时枚举多词组合作为输入，忽略 in 与 wordlist */
+    const PIPELINE_KEYSPACE *keyspace;  /* 非 NULL 时枚举私钥区间，短语列为私钥 hex，忽略 in、wordlist 与 rules */
+    const char *checkpoint;  /* 非 NULL 时定期把剩余区间与累计计数原子地写入该状态文件，结束时再写一次 */
+    unsigned checkpoint_interval;  /* 两次检查点之间的秒数 */
+    const struct checkpoint *resume;  /* 非 NULL 时只处理其中的剩余区间，不再写二进制文件头 */
+    PIPELINE_SHARD_MODE shard_mode;
+    unsigned shard_index;    /* 本节点的分片，shard_count <= 1 时不分片 */
+    unsigned shard_count;
+} PIPELINE_STREAM_CONFIG;
+
+typedef struct pipeline_stream_stats {
+    uint64_t phrases;        /* 本次推导的短语数（设置规则时为变换后的候选数） */
+    uint64_t batches;
+    uint64_t steals;         /* 被其他线程窃取执行的批次数 */
+    uint64_t hits;           /* 设置 targets 时本次命中的短语数 */
+    int threads;
+} PIPELINE_STREAM_STATS;
+
+/*
+ * 逐行读取 cfg->in（或 cfg->wordlist，或枚举 cfg->combinator、cfg->keyspace）直到结束。二进制格式先写出文件头。
+ * 成功返回 0，读写或内存错误返回 -1。
+ */
+int pipeline_run_stream(const PIPELINE_STREAM_CONFIG *cfg, PIPELINE_STREAM_STATS *stats);
+
+/**
+ * pipeline_stream_resume - 读取 cfg->checkpoint 准备恢复
+ *
+ * 核对检查点的输入、迭代次数与分片和 cfg 一致；cfg->out 为普通文件时截断到检查点记录的
+ * 长度（之后写出的记录恢复后会重新生成）并移到末尾，短于该长度时失败（中间的记录已丢失）。
+ * 成功返回 0 并填写 cp（由 checkpoint_free 释放），失败时输出错误信息并返回 -1。
+ */
+int pipeline_stream_resume(const PIPELINE_STREAM_CONFIG *cfg, struct checkpoint *cp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PIPELINE_H */
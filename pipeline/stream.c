@@ -0,0 +1,789 @@
+/*
+ * stream.c
+ *
+ * 多线程流式运行。
+ *
+ * 读取线程（调用者线程）从固定数量的批次对象中取一个空闲批次，把若干行短语
+ * 复制进批次自带的文本缓冲区，编上序号后提交给线程池。工作线程用线程私有的
+ * PIPELINE_BATCH 完成推导并把记录格式化到批次自带的输出缓冲区，然后：
+ *   - 无序模式：立即在输出锁下写出；
+ *   - 有序模式：放入按序号取模的重排槽，由恰好补齐下一个序号的线程连续写出。
+ * 批次写出后才归还空闲链表，所以正在处理或等待写出的批次不超过总数，
+ * 序号一定落在 [next_write, next_write + 总数) 内，重排槽不会冲突；
+ * 读取线程在没有空闲批次时阻塞，内存占用有界。
+ *
+ * 映射词表输入时批次改为映射中的一段字节范围（按行边界切分，约 STREAM_SEGMENT_SIZE
+ * 字节且与逐行读取一样不超过 chunk_lines 行，短词词表的一段不会产生过多输出），
+ * 工作线程自己扫描换行并把行视图直接交给推导，读取线程只负责切分。
+ * 无序模式下词表先按线程数切成连续区间，每个区间的段依次提交到对应线程自己的
+ * 队列，线程顺序处理自己的区间，空闲线程再从别的队列窃取；有序模式按文件顺序
+ * 轮流提交。
+ *
+ * 设置了规则时，工作线程把批次对象中的每个词依次经每条规则变换，结果写入线程私有的
+ * 候选缓冲区（每个批次位置一个 RULES_MAX_LEN 字节的槽），满一批即推导，不分配内存；
+ * 每个批次对象的输入按规则数缩小，使其输出量与不用规则时相当。
+ *
+ * 组合输入时批次对象是一段组合序号区间，工作线程用组合游标顺序生成短语，
+ * 复制到同样的候选槽后推导。区间的切分与映射词表相同：无序模式每个线程一段连续序号，
+ * 有序模式按序号顺序轮流提交。
+ *
+ * 私钥区间（key 的区间模式）与组合相同地按序号切分，工作线程直接写入私钥，
+ * 短语列为私钥的 hex，推导时跳过短语哈希。
+ *
+ * 分片时，RANGE 方式先把输入均分为 shard_count 份、只取本节点的一段，再按上面的方式切分；
+ * HASH 方式输入不变，工作线程只保留哈希落在本分片的词。两种方式都与线程数无关。
+ *
+ * 每个批次对象覆盖输入中的一段 [begin, end)（字节偏移或组合序号），同一区间的批次对象
+ * 首尾相接。写出时在输出锁内推进所属区间的水位：水位之前的输入都已写出，水位之后
+ * 乱序写出的批次对象单独记下。设置了检查点文件时定期把“剩余区间”原子地写入，
+ * 恢复时只处理这些区间。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "pipeline.h"
+#include "../threadpool/threadpool.h"
+#include "../wordlist/wordlist.h"
+#include "../rules/rules.h"
+#include "../combine/combine.h"
+#include "../checkpoint/checkpoint.h"
+#include "../customutil/customutil.h"
+
+#define STREAM_CHUNKS_PER_THREAD 4
+#define STREAM_TEXT_SIZE (64 * 1024)
+#define STREAM_SEGMENT_SIZE (16 * 1024)
+
+typedef struct stream_chunk {
+    uint64_t seq;
+    size_t count;
+    size_t offs[PIPELINE_BATCH_SIZE];
+    size_t lens[PIPELINE_BATCH_SIZE];
+    uint64_t pos[PIPELINE_BATCH_SIZE];  /* 各行在输入中的字节偏移 */
+    char *text;
+    size_t text_len;
+    size_t text_cap;
+    uint64_t begin;                 /* 覆盖的输入范围：字节偏移或组合序号 */
+    uint64_t end;
+    size_t range;                   /* 所属区间及区间内序号 */
+    uint64_t range_seq;
+    uint64_t phrases;               /* 工作线程的计数，写出时累计 */
+    uint64_t batches;
+    uint64_t hits;
+    PIPELINE_OUTPUT out;
+    struct stream_chunk *next_free;
+} STREAM_CHUNK;
+
+/* 一个输入区间：读取线程的提交位置，以及输出锁保护的写出水位 */
+typedef struct stream_range {
+    uint64_t pos;                   /* 读取线程：下一个批次对象的起点 */
+    uint64_t end;
+    uint64_t submitted;             /* 读取线程：已提交的批次对象数 */
+    uint64_t mark;                  /* 输出锁内：水位 */
+    uint64_t next_seq;              /* 输出锁内：下一个应推进水位的区间内序号 */
+} STREAM_RANGE;
+
+/* 水位之后已经写出的批次对象 */
+typedef struct stream_done {
+    size_t range;
+    uint64_t seq;
+    uint64_t begin;
+    uint64_t end;
+} STREAM_DONE;
+
+/* 组合或私钥区间输入的序号总数 */
+static uint64_t index_total(const PIPELINE_STREAM_CONFIG *cfg) {
+    return cfg->combinator != NULL ? cfg->combinator->total : cfg->keyspace->count;
+}
+
+typedef struct stream_state {
+    const PIPELINE_STREAM_CONFIG *cfg;
+    PIPELINE_PLAN plan;             /* cfg->plan 或默认计划 */
+    PIPELINE_BATCH **scratch;       /* 每个工作线程一个 */
+    char **candidates;              /* 每个工作线程一个，PIPELINE_BATCH_SIZE 个规则变换或组合结果 */
+    size_t chunk_lines;             /* 逐行读取时每个批次对象的行数 */
+    size_t segment_size;            /* 映射词表每段的字节数 */
+    STREAM_RANGE *ranges;
+    size_t nranges;
+
+    pthread_mutex_t free_lock;
+    pthread_cond_t free_cv;
+    STREAM_CHUNK *free_list;
+
+    pthread_mutex_t out_lock;
+    STREAM_CHUNK **slots;           /* 有序模式的重排槽 */
+    size_t nslots;
+    uint64_t next_write;
+    int failed;                     /* 原子访问 */
+    uint64_t phrases;               /* 以下在输出锁内累计 */
+    uint64_t batches;
+    uint64_t hits;
+    uint64_t output;                /* 写出的字节数 */
+    STREAM_DONE *done;
+    size_t ndone;
+    size_t done_cap;
+    time_t checkpoint_at;           /* 下一次写检查点的时刻（单调时钟，秒） */
+    int out_regular;                /* 输出为普通文件：检查点前 fsync */
+} STREAM_STATE;
+
+static time_t monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+static void chunk_release(STREAM_STATE *st, STREAM_CHUNK *chunk) {
+    chunk->count = 0;
+    chunk->text_len = 0;
+    chunk->begin = chunk->end = 0;
+    chunk->phrases = chunk->batches = chunk->hits = 0;
+    chunk->out.len = 0;
+    pthread_mutex_lock(&st->free_lock);
+    chunk->next_free = st->free_list;
+    st->free_list = chunk;
+    pthread_cond_signal(&st->free_cv);
+    pthread_mutex_unlock(&st->free_lock);
+}
+
+static STREAM_CHUNK *chunk_acquire(STREAM_STATE *st) {
+    pthread_mutex_lock(&st->free_lock);
+    while (st->free_list == NULL)
+        pthread_cond_wait(&st->free_cv, &st->free_lock);
+    STREAM_CHUNK *chunk = st->free_list;
+    st->free_list = chunk->next_free;
+    pthread_mutex_unlock(&st->free_lock);
+    return chunk;
+}
+
+/* 在输出锁内调用：推进批次对象所属区间的水位，不连续时先记下 */
+static void progress_advance(STREAM_STATE *st, const STREAM_CHUNK *chunk) {
+    STREAM_RANGE *range = &st->ranges[chunk->range];
+    if (chunk->range_seq != range->next_seq) {
+        if (st->ndone == st->done_cap) {
+            size_t cap = st->done_cap ? st->done_cap * 2 : 64;
+            STREAM_DONE *grown = (STREAM_DONE *)realloc(st->done, cap * sizeof(STREAM_DONE));
+            if (grown == NULL) {
+                __atomic_store_n(&st->failed, 1, __ATOMIC_RELEASE);
+                return;
+            }
+            st->done = grown;
+            st->done_cap = cap;
+        }
+        STREAM_DONE d = { chunk->range, chunk->range_seq, chunk->begin, chunk->end };
+        st->done[st->ndone++] = d;
+        return;
+    }
+    range->mark = chunk->end;
+    range->next_seq++;
+    /* 接上之前乱序写出的后继 */
+    for (size_t i = 0; i < st->ndone;) {
+        if (st->done[i].range == chunk->range && st->done[i].seq == range->next_seq) {
+            range->mark = st->done[i].end;
+            range->next_seq++;
+            st->done[i] = st->done[--st->ndone];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+}
+
+static int done_compare(const void *a, const void *b) {
+    const STREAM_DONE *x = (const STREAM_DONE *)a, *y = (const STREAM_DONE *)b;
+    if (x->range != y->range)
+        return x->range < y->range ? -1 : 1;
+    return x->seq < y->seq ? -1 : x->seq > y->seq;
+}
+
+/* 检查点中标识输入与参数的字段：来源、大小、迭代次数与分片 */
+static void stream_identity(const PIPELINE_STREAM_CONFIG *cfg, CHECKPOINT *cp) {
+    if (cfg->combinator != NULL || cfg->keyspace != NULL) {
+        cp->source = CHECKPOINT_SOURCE_INDEX;
+        cp->size = index_total(cfg);
+    } else if (cfg->wordlist != NULL) {
+        cp->source = CHECKPOINT_SOURCE_WORDLIST;
+        cp->size = cfg->wordlist->size;
+    } else {
+        cp->source = CHECKPOINT_SOURCE_LINES;
+        cp->size = 0;
+    }
+    cp->iterations = cfg->iterations;
+    cp->shard_count = cfg->shard_count > 1 ? cfg->shard_count : 1;
+    cp->shard_index = cp->shard_count > 1 ? cfg->shard_index : 0;
+    cp->shard_mode = cp->shard_count > 1 ? (uint32_t)cfg->shard_mode : 0;
+}
+
+/*
+ * 在输出锁内（或全部线程结束后）调用：先把已写出的记录刷到输出，输出为普通文件时
+ * fsync 落盘，再保存剩余区间，因此检查点记录的输出长度在崩溃后一定已在磁盘上。
+ * 每个区间从水位开始，挖去水位之后已写出的批次对象。写失败只给出警告，扫描继续。
+ */
+static void stream_checkpoint(STREAM_STATE *st) {
+    const PIPELINE_STREAM_CONFIG *cfg = st->cfg;
+    /* 写出错后 stdio 可能已丢弃缓冲区，此时 fflush 仍返回 0，须同时检查错误标志 */
+    if (fflush(cfg->out) != 0 || ferror(cfg->out)) {
+        __atomic_store_n(&st->failed, 1, __ATOMIC_RELEASE);
+        return;
+    }
+    if (st->out_regular && fsync(fileno(cfg->out)) != 0) {
+        fprintf(stderr, "Warning: 输出无法落盘，跳过检查点: %s\n", strerror(errno));
+        return;
+    }
+    CHECKPOINT_RANGE *left = (CHECKPOINT_RANGE *)malloc((st->nranges + st->ndone + 1) * sizeof(CHECKPOINT_RANGE));
+    if (left == NULL) {
+        fprintf(stderr, "Warning: 内存不足，跳过检查点\n");
+        return;
+    }
+    qsort(st->done, st->ndone, sizeof(STREAM_DONE), done_compare);
+    size_t n = 0, d = 0;
+    for (size_t r = 0; r < st->nranges; r++) {
+        uint64_t start = st->ranges[r].mark;
+        for (; d < st->ndone && st->done[d].range == r; d++) {
+            if (st->done[d].begin > start) {
+                left[n].begin = start;
+                left[n].end = st->done[d].begin;
+                n++;
+            }
+            start = st->done[d].end;
+        }
+        if (start < st->ranges[r].end) {
+            left[n].begin = start;
+            left[n].end = st->ranges[r].end;
+            n++;
+        }
+    }
+
+    CHECKPOINT cp;
+    memset(&cp, 0, sizeof(cp));
+    stream_identity(cfg, &cp);
+    cp.phrases = st->phrases;
+    cp.hits = st->hits;
+    cp.output = st->output;
+    if (cfg->resume != NULL) {
+        cp.phrases += cfg->resume->phrases;
+        cp.hits += cfg->resume->hits;
+        cp.output += cfg->resume->output;
+    }
+    cp.nranges = n;
+    cp.ranges = left;
+    if (checkpoint_save(cfg->checkpoint, &cp) != 0)
+        fprintf(stderr, "Warning: 无法写入检查点 %s: %s\n", cfg->checkpoint, strerror(errno));
+    free(left);
+}
+
+/* 在输出锁内调用：写出批次对象，累计计数并推进水位，到时写检查点 */
+static void chunk_write(STREAM_STATE *st, STREAM_CHUNK *chunk) {
+    size_t len = chunk->out.len;
+    if (pipeline_output_flush(&chunk->out, st->cfg->out) != 0) {
+        __atomic_store_n(&st->failed, 1, __ATOMIC_RELEASE);
+        return;
+    }
+    st->output += len;
+    st->phrases += chunk->phrases;
+    st->batches += chunk->batches;
+    st->hits += chunk->hits;
+    progress_advance(st, chunk);
+    if (st->cfg->checkpoint != NULL && monotonic_seconds() >= st->checkpoint_at) {
+        stream_checkpoint(st);
+        st->checkpoint_at = monotonic_seconds() + st->cfg->checkpoint_interval;
+    }
+}
+
+/*
+ * 只执行输出需要的阶段：文本输出按计划推导公钥、hash160 与地址；二进制记录只需要
+ * 私钥与 hash160；设置了目标集合时先算出两种 hash160 做匹配，只为命中的条目编码地址。
+ */
+static void batch_run(STREAM_STATE *st, PIPELINE_BATCH *batch, STREAM_CHUNK *chunk) {
+    const PIPELINE_STREAM_CONFIG *cfg = st->cfg;
+    unsigned stages = cfg->format == PIPELINE_FORMAT_TEXT ? st->plan.stages : PIPELINE_STAGE_KEYS;
+    if (cfg->targets != NULL)
+        stages |= PIPELINE_STAGE_KEYS;
+    if (cfg->keyspace != NULL)
+        stages |= PIPELINE_STAGE_PRESET;
+    pipeline_derive_keys(cfg->ctx, batch, cfg->iterations, stages);
+    if (cfg->targets != NULL) {
+        size_t hits = pipeline_match(batch, cfg->targets);
+        if (hits == 0)
+            return;
+        chunk->hits += hits;
+    }
+    int ret;
+    if (cfg->format == PIPELINE_FORMAT_TEXT) {
+        pipeline_derive_addresses(batch, &st->plan);
+        ret = pipeline_format_plan(batch, &st->plan, &chunk->out);
+    } else {
+        ret = pipeline_format_bin(batch, cfg->bin_flags, &chunk->out);
+    }
+    if (ret != 0)
+        __atomic_store_n(&st->failed, 1, __ATOMIC_RELEASE);
+}
+
+static void batch_flush(STREAM_STATE *st, PIPELINE_BATCH *batch, STREAM_CHUNK *chunk) {
+    if (batch->count == 0)
+        return;
+    chunk->phrases += batch->count;
+    chunk->batches++;
+    batch_run(st, batch, chunk);
+    batch->count = 0;
+}
+
+static inline void batch_push(STREAM_STATE *st, PIPELINE_BATCH *batch, STREAM_CHUNK *chunk,
+                              const char *phrase, size_t len, uint64_t offset) {
+    batch->phrases[batch->count] = phrase;
+    batch->lens[batch->count] = len;
+    batch->offsets[batch->count] = offset;
+    if (++batch->count == PIPELINE_BATCH_SIZE)
+        batch_flush(st, batch, chunk);
+}
+
+/*
+ * 把一个输入词加入批次。HASH 分片时先丢弃不属于本分片的词。设置了规则时依次应用
+ * 每条规则，变换结果写入工作线程的候选缓冲区中与批次位置对应的槽，批次满时推导，
+ * 槽随即可以复用。
+ */
+static void emit_word(STREAM_STATE *st, int worker, STREAM_CHUNK *chunk,
+                      const char *word, size_t len, uint64_t offset) {
+    PIPELINE_BATCH *batch = st->scratch[worker];
+    const RULE_SET *rules = st->cfg->rules;
+    if (st->cfg->shard_count > 1 && st->cfg->shard_mode == PIPELINE_SHARD_HASH &&
+        pipeline_shard_of(word, len, st->cfg->shard_count) != st->cfg->shard_index)
+        return;
+    if (rules == NULL) {
+        batch_push(st, batch, chunk, word, len, offset);
+        return;
+    }
+    char *slots = st->candidates[worker];
+    for (size_t r = 0; r < rules->count; r++) {
+        char *dst = slots + batch->count * RULES_MAX_LEN;
+        int n = rule_apply(&rules->rules[r], word, len, dst);
+        if (n > 0)
+            batch_push(st, batch, chunk, dst, (size_t)n, offset);
+    }
+}
+
+static void stream_task(void *task, int worker, void *arg) {
+    STREAM_STATE *st = (STREAM_STATE *)arg;
+    STREAM_CHUNK *chunk = (STREAM_CHUNK *)task;
+    const char *line;
+    size_t len;
+
+    st->scratch[worker]->count = 0;
+    if (st->cfg->wordlist != NULL) {
+        /* 扫描映射词表中的一段，行视图直接进入批次 */
+        WORDLIST_CURSOR cur;
+        wordlist_cursor_init(&cur, st->cfg->wordlist, (size_t)chunk->begin, (size_t)chunk->end);
+        while (wordlist_next(&cur, &line, &len))
+            emit_word(st, worker, chunk, line, len, (uint64_t)(line - st->cfg->wordlist->data));
+    } else if (st->cfg->combinator != NULL) {
+        /* 游标的缓冲区在下一条时被改写：不经规则时先复制到批次位置对应的候选槽 */
+        COMBINE_CURSOR cur;
+        uint64_t index;
+        combine_cursor_init(&cur, st->cfg->combinator, chunk->begin, chunk->end);
+        while (combine_next(&cur, &line, &len, &index)) {
+            if (st->cfg->rules == NULL) {
+                char *dst = st->candidates[worker] + st->scratch[worker]->count * RULES_MAX_LEN;
+                memcpy(dst, line, len);
+                line = dst;
+            }
+            emit_word(st, worker, chunk, line, len, index);
+        }
+    } else if (st->cfg->keyspace != NULL) {
+        /* 私钥直接写入批次，候选槽保存其 hex 作为短语列 */
+        PIPELINE_BATCH *batch = st->scratch[worker];
+        for (uint64_t i = chunk->begin; i < chunk->end; i++) {
+            uint8_t *key = batch->privkeys + batch->count * BW_PRIVKEY_LEN;
+            char *dst = st->candidates[worker] + batch->count * RULES_MAX_LEN;
+            pipeline_keyspace_key(st->cfg->keyspace, i, key);
+            hex_encode(dst, key, BW_PRIVKEY_LEN);
+            batch_push(st, batch, chunk, dst, 2 * BW_PRIVKEY_LEN, i);
+        }
+    } else {
+        for (size_t i = 0; i < chunk->count; i++)
+            emit_word(st, worker, chunk, chunk->text + chunk->offs[i], chunk->lens[i], chunk->pos[i]);
+    }
+    batch_flush(st, st->scratch[worker], chunk);
+
+    pthread_mutex_lock(&st->out_lock);
+    if (!st->cfg->ordered) {
+        chunk_write(st, chunk);
+        pthread_mutex_unlock(&st->out_lock);
+        chunk_release(st, chunk);
+        return;
+    }
+    st->slots[chunk->seq % st->nslots] = chunk;
+    STREAM_CHUNK *ready;
+    while ((ready = st->slots[st->next_write % st->nslots]) != NULL &&
+           ready->seq == st->next_write) {
+        st->slots[st->next_write % st->nslots] = NULL;
+        st->next_write++;
+        chunk_write(st, ready);
+        chunk_release(st, ready);
+    }
+    pthread_mutex_unlock(&st->out_lock);
+}
+
+/* 编号并提交属于区间 r 的批次对象，worker < 0 时提交到共享队列 */
+static void chunk_submit(STREAM_STATE *st, THREADPOOL *pool, STREAM_CHUNK *chunk, size_t r,
+                         uint64_t *seq, int worker) {
+    chunk->seq = (*seq)++;
+    chunk->range = r;
+    chunk->range_seq = st->ranges[r].submitted++;
+    if (worker < 0)
+        threadpool_submit(pool, chunk);
+    else
+        threadpool_submit_to(pool, worker, chunk);
+}
+
+/* 把一行追加到批次，文本缓冲区不足时扩大（批次尚未提交，偏移量仍然有效） */
+static int chunk_append(STREAM_CHUNK *chunk, const char *line, size_t len, uint64_t pos) {
+    if (chunk->text_len + len > chunk->text_cap) {
+        size_t cap = chunk->text_cap;
+        while (cap < chunk->text_len + len)
+            cap *= 2;
+        char *grown = (char *)realloc(chunk->text, cap);
+        if (grown == NULL)
+            return -1;
+        chunk->text = grown;
+        chunk->text_cap = cap;
+    }
+    memcpy(chunk->text + chunk->text_len, line, len);
+    chunk->offs[chunk->count] = chunk->text_len;
+    chunk->lens[chunk->count] = len;
+    chunk->pos[chunk->count] = pos;
+    chunk->text_len += len;
+    chunk->count++;
+    return 0;
+}
+
+/*
+ * 逐行读取 cfg->in，每 chunk_lines 行复制进一个批次对象提交。
+ * 只处理落在区间内的行；批次对象不跨区间，首尾相接地覆盖区间。
+ * 读到文件末尾时返回末尾的字节偏移，否则返回 UINT64_MAX。
+ */
+static uint64_t submit_lines(STREAM_STATE *st, THREADPOOL *pool) {
+    char *line = NULL;
+    size_t line_cap = 0;
+    ssize_t len;
+    uint64_t seq = 0, pos = 0;
+    size_t r = 0;
+    uint64_t begin = st->nranges > 0 ? st->ranges[0].pos : 0;
+    STREAM_CHUNK *chunk = NULL;
+    while (r < st->nranges && (len = getline(&line, &line_cap, st->cfg->in)) != -1) {
+        uint64_t line_pos = pos;
+        pos += (uint64_t)len;
+        /* 越过当前区间：提交其最后一个批次对象，转到下一个区间 */
+        while (r < st->nranges && line_pos >= st->ranges[r].end) {
+            if (chunk != NULL) {
+                chunk->begin = begin;
+                chunk->end = st->ranges[r].end;
+                chunk_submit(st, pool, chunk, r, &seq, -1);
+                chunk = NULL;
+            }
+            if (++r < st->nranges)
+                begin = st->ranges[r].pos;
+        }
+        if (r == st->nranges || __atomic_load_n(&st->failed, __ATOMIC_ACQUIRE))
+            break;
+        if (line_pos < st->ranges[r].pos)
+            continue;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            len--;
+        if (len == 0)
+            continue;
+        if (chunk != NULL && chunk->count == st->chunk_lines) {
+            chunk->begin = begin;
+            chunk->end = begin = line_pos;
+            chunk_submit(st, pool, chunk, r, &seq, -1);
+            chunk = NULL;
+            if (__atomic_load_n(&st->failed, __ATOMIC_ACQUIRE))
+                break;
+        }
+        if (chunk == NULL)
+            chunk = chunk_acquire(st);
+        if (chunk_append(chunk, line, len, line_pos) != 0) {
+            __atomic_store_n(&st->failed, 1, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    int eof = feof(st->cfg->in) && !ferror(st->cfg->in);
+    if (chunk != NULL && !__atomic_load_n(&st->failed, __ATOMIC_ACQUIRE)) {
+        chunk->begin = begin;
+        chunk->end = pos;
+        chunk_submit(st, pool, chunk, r, &seq, -1);
+    } else if (chunk != NULL) {
+        chunk_release(st, chunk);
+    }
+    free(line);
+    return eof ? pos : UINT64_MAX;
+}
+
+/*
+ * 映射词表、组合与私钥区间输入：从区间 r 切出下一段提交。
+ * 词表按行边界切出约 segment_size 字节、至多 chunk_lines 行，组合与私钥每段 chunk_lines 个序号。
+ */
+static void submit_next(STREAM_STATE *st, THREADPOOL *pool, size_t r, uint64_t *seq, int worker) {
+    STREAM_RANGE *range = &st->ranges[r];
+    uint64_t cut;
+    if (st->cfg->wordlist != NULL) {
+        cut = wordlist_segment_end(st->cfg->wordlist, (size_t)range->pos, (size_t)range->end,
+                                   st->segment_size, st->chunk_lines);
+    } else {
+        cut = range->end - range->pos > st->chunk_lines ? range->pos + st->chunk_lines : range->end;
+    }
+    if (cut > range->end)
+        cut = range->end;
+    STREAM_CHUNK *chunk = chunk_acquire(st);
+    chunk->begin = range->pos;
+    chunk->end = cut;
+    range->pos = cut;
+    chunk_submit(st, pool, chunk, r, seq, worker);
+}
+
+/*
+ * 无序模式轮流从各区间取下一段，提交到区间所属线程的队列；
+ * 有序模式按区间顺序依次提交到共享队列。
+ */
+static void submit_ranges(STREAM_STATE *st, THREADPOOL *pool, int threads) {
+    uint64_t seq = 0;
+    if (st->cfg->ordered) {
+        for (size_t r = 0; r < st->nranges; r++) {
+            while (st->ranges[r].pos < st->ranges[r].end && !__atomic_load_n(&st->failed, __ATOMIC_ACQUIRE))
+                submit_next(st, pool, r, &seq, -1);
+        }
+        return;
+    }
+    int pending = 1;
+    while (pending && !__atomic_load_n(&st->failed, __ATOMIC_ACQUIRE)) {
+        pending = 0;
+        for (size_t r = 0; r < st->nranges; r++) {
+            if (st->ranges[r].pos >= st->ranges[r].end)
+                continue;
+            submit_next(st, pool, r, &seq, (int)(r % (size_t)threads));
+            pending |= st->ranges[r].pos < st->ranges[r].end;
+        }
+    }
+}
+
+/* 把 [begin, end) 均分为 n 个区间，映射词表的切点对齐到行首 */
+static void ranges_split(STREAM_STATE *st, uint64_t begin, uint64_t end, size_t n) {
+    uint64_t prev = begin;
+    for (size_t r = 0; r < n; r++) {
+        uint64_t cut = begin + pipeline_split_point(end - begin, r, n);
+        if (st->cfg->wordlist != NULL)
+            cut = wordlist_line_start(st->cfg->wordlist, (size_t)cut);
+        if (cut < prev)
+            cut = prev;
+        if (cut > end)
+            cut = end;
+        st->ranges[r].pos = prev = cut;
+        if (r > 0)
+            st->ranges[r - 1].end = cut;
+    }
+    st->ranges[n - 1].end = end;
+}
+
+/*
+ * 建立输入区间：恢复时为检查点中的剩余区间；否则映射词表、组合与私钥区间先取 RANGE 分片的
+ * 一段，无序模式下再按线程数切分，有序模式与逐行输入为一个区间。
+ */
+static int ranges_init(STREAM_STATE *st, int threads) {
+    const PIPELINE_STREAM_CONFIG *cfg = st->cfg;
+    int indexed = cfg->wordlist != NULL || cfg->combinator != NULL || cfg->keyspace != NULL;
+    size_t n = 1;
+    if (cfg->resume != NULL)
+        n = cfg->resume->nranges;
+    else if (!cfg->ordered && indexed)
+        n = (size_t)threads;
+    st->ranges = (STREAM_RANGE *)calloc(n > 0 ? n : 1, sizeof(STREAM_RANGE));
+    if (st->ranges == NULL)
+        return -1;
+    st->nranges = n;
+
+    if (cfg->resume != NULL) {
+        for (size_t r = 0; r < n; r++) {
+            st->ranges[r].pos = cfg->resume->ranges[r].begin;
+            st->ranges[r].end = cfg->resume->ranges[r].end;
+        }
+    } else if (indexed) {
+        uint64_t total = cfg->wordlist != NULL ? cfg->wordlist->size : index_total(cfg);
+        uint64_t begin = 0, end = total;
+        if (cfg->shard_count > 1 && cfg->shard_mode == PIPELINE_SHARD_RANGE) {
+            begin = pipeline_split_point(total, cfg->shard_index, cfg->shard_count);
+            end = pipeline_split_point(total, cfg->shard_index + 1, cfg->shard_count);
+            if (cfg->wordlist != NULL) {
+                begin = wordlist_line_start(cfg->wordlist, (size_t)begin);
+                end = wordlist_line_start(cfg->wordlist, (size_t)end);
+            }
+        }
+        ranges_split(st, begin, end, n);
+    } else {
+        st->ranges[0].pos = 0;
+        st->ranges[0].end = UINT64_MAX;
+    }
+    for (size_t r = 0; r < n; r++)
+        st->ranges[r].mark = st->ranges[r].pos;
+    return 0;
+}
+
+int pipeline_run_stream(const PIPELINE_STREAM_CONFIG *cfg, PIPELINE_STREAM_STATS *stats) {
+    int threads = cfg->threads > 0 ? cfg->threads : threadpool_cpu_count();
+    size_t nchunks = (size_t)threads * STREAM_CHUNKS_PER_THREAD;
+    STREAM_STATE st;
+    memset(&st, 0, sizeof(st));
+    memset(stats, 0, sizeof(*stats));
+    st.cfg = cfg;
+    if (cfg->plan != NULL)
+        st.plan = *cfg->plan;
+    else
+        pipeline_plan_full(&st.plan);
+    st.nslots = nchunks;
+    /* 规则把每个词展开为多个候选，按规则数缩小每个批次对象的输入量，输出缓冲区保持有界 */
+    size_t expand = cfg->rules != NULL && cfg->rules->count > 0 ? cfg->rules->count : 1;
+    st.chunk_lines = PIPELINE_BATCH_SIZE / expand > 0 ? PIPELINE_BATCH_SIZE / expand : 1;
+    st.segment_size = STREAM_SEGMENT_SIZE / expand > 256 ? STREAM_SEGMENT_SIZE / expand : 256;
+    st.checkpoint_at = monotonic_seconds() + cfg->checkpoint_interval;
+    if (cfg->checkpoint != NULL) {
+        struct stat sb;
+        st.out_regular = fstat(fileno(cfg->out), &sb) == 0 && S_ISREG(sb.st_mode);
+    }
+    pthread_mutex_init(&st.free_lock, NULL);
+    pthread_cond_init(&st.free_cv, NULL);
+    pthread_mutex_init(&st.out_lock, NULL);
+
+    int ret = ranges_init(&st, threads);
+    STREAM_CHUNK *chunks = (STREAM_CHUNK *)calloc(nchunks, sizeof(STREAM_CHUNK));
+    st.slots = (STREAM_CHUNK **)calloc(nchunks, sizeof(STREAM_CHUNK *));
+    st.scratch = (PIPELINE_BATCH **)calloc(threads, sizeof(PIPELINE_BATCH *));
+    st.candidates = (char **)calloc(threads, sizeof(char *));
+    if (chunks == NULL || st.slots == NULL || st.scratch == NULL || st.candidates == NULL)
+        ret = -1;
+    for (int i = 0; ret == 0 && i < threads; i++) {
+        st.scratch[i] = (PIPELINE_BATCH *)calloc(1, sizeof(PIPELINE_BATCH));
+        if (st.scratch[i] == NULL)
+            ret = -1;
+        if (cfg->rules != NULL || cfg->combinator != NULL || cfg->keyspace != NULL) {
+            st.candidates[i] = (char *)malloc(PIPELINE_BATCH_SIZE * RULES_MAX_LEN);
+            if (st.candidates[i] == NULL)
+                ret = -1;
+        }
+    }
+    for (size_t i = 0; ret == 0 && i < nchunks; i++) {
+        /* 映射词表、组合与私钥区间输入不复制短语，不需要文本缓冲区 */
+        if (cfg->wordlist == NULL && cfg->combinator == NULL && cfg->keyspace == NULL) {
+            chunks[i].text_cap = STREAM_TEXT_SIZE;
+            chunks[i].text = (char *)malloc(STREAM_TEXT_SIZE);
+            if (chunks[i].text == NULL)
+                ret = -1;
+        }
+        chunks[i].next_free = st.free_list;
+        st.free_list = &chunks[i];
+    }
+    THREADPOOL *pool = ret == 0 ? threadpool_create(threads, stream_task, &st) : NULL;
+    if (pool == NULL)
+        ret = -1;
+
+    /* 恢复时文件头已在之前的输出中 */
+    if (ret == 0 && cfg->format == PIPELINE_FORMAT_BIN && cfg->resume == NULL) {
+        PIPELINE_BIN_HEADER header;
+        uint8_t buf[PIPELINE_BIN_HEADER_SIZE];
+        pipeline_bin_header_init(&header, cfg->bin_flags, cfg->iterations);
+        pipeline_bin_header_encode(&header, buf);
+        if (fwrite(buf, sizeof(buf), 1, cfg->out) != 1)
+            ret = -1;
+        st.output += sizeof(buf);
+    }
+    /* 先写一次初始状态，任何时刻中断都有检查点可以恢复 */
+    if (ret == 0 && cfg->checkpoint != NULL)
+        stream_checkpoint(&st);
+    if (ret == 0) {
+        stats->threads = threadpool_threads(pool);
+        if (cfg->wordlist != NULL || cfg->combinator != NULL || cfg->keyspace != NULL) {
+            submit_ranges(&st, pool, threads);
+            threadpool_wait(pool);
+        } else {
+            uint64_t eof = submit_lines(&st, pool);
+            threadpool_wait(pool);
+            /* 输入已读完：区间不再延伸到文件末尾之后 */
+            for (size_t r = 0; r < st.nranges; r++) {
+                if (st.ranges[r].end > eof)
+                    st.ranges[r].end = eof;
+            }
+        }
+        if (cfg->checkpoint != NULL)
+            stream_checkpoint(&st);
+        stats->phrases = st.phrases;
+        stats->batches = st.batches;
+        stats->steals = threadpool_steals(pool);
+        stats->hits = st.hits;
+        if ((cfg->in != NULL && ferror(cfg->in)) || __atomic_load_n(&st.failed, __ATOMIC_ACQUIRE))
+            ret = -1;
+    }
+
+    threadpool_destroy(pool);
+    for (size_t i = 0; chunks != NULL && i < nchunks; i++) {
+        free(chunks[i].text);
+        pipeline_output_free(&chunks[i].out);
+    }
+    for (int i = 0; st.scratch != NULL && i < threads; i++)
+        free(st.scratch[i]);
+    for (int i = 0; st.candidates != NULL && i < threads; i++)
+        free(st.candidates[i]);
+    free(st.scratch);
+    free(st.candidates);
+    free(st.slots);
+    free(st.ranges);
+    free(st.done);
+    free(chunks);
+    pthread_mutex_destroy(&st.free_lock);
+    pthread_cond_destroy(&st.free_cv);
+    pthread_mutex_destroy(&st.out_lock);
+    return ret;
+}
+
+int pipeline_stream_resume(const PIPELINE_STREAM_CONFIG *cfg, CHECKPOINT *cp) {
+    int ret = checkpoint_load(cfg->checkpoint, cp);
+    if (ret != 0) {
+        if (ret == -1)
+            fprintf(stderr, "Error: 无法打开检查点文件 %s\n", cfg->checkpoint);
+        else
+            fprintf(stderr, "Error: 检查点文件 %s 格式错误\n", cfg->checkpoint);
+        return -1;
+    }
+    CHECKPOINT want;
+    stream_identity(cfg, &want);
+    if (cp->source != want.source || cp->size != want.size || cp->iterations != want.iterations) {
+        fprintf(stderr, "Error: 检查点与当前输入或参数不一致\n");
+        checkpoint_free(cp);
+        return -1;
+    }
+    if (cp->shard_mode != want.shard_mode || cp->shard_index != want.shard_index ||
+        cp->shard_count != want.shard_count) {
+        fprintf(stderr, "Error: 检查点属于分片 %u/%u，与当前 --shard 不一致\n", cp->shard_index, cp->shard_count);
+        checkpoint_free(cp);
+        return -1;
+    }
+
+    struct stat sb;
+    int fd = fileno(cfg->out);
+    if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode)) {
+        if ((uint64_t)sb.st_size > cp->output && ftruncate(fd, (off_t)cp->output) != 0) {
+            fprintf(stderr, "Error: 无法截断输出文件\n");
+            checkpoint_free(cp);
+            return -1;
+        }
+        if ((uint64_t)sb.st_size < cp->output) {
+            fprintf(stderr, "Error: 输出文件只有 %llu 字节，短于检查点记录的 %llu 字节，"
+                            "继续会在结果中留下缺口（输出是否追加到了原文件？）\n",
+                    (unsigned long long)sb.st_size, (unsigned long long)cp->output);
+            checkpoint_free(cp);
+            return -1;
+        }
+        lseek(fd, 0, SEEK_END);
+    }
+    return 0;
+}
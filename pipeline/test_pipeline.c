@@ -0,0 +1,226 @@
+// make lib && gcc -O2 -o test_pipeline pipeline/test_pipeline.c pipeline/pipeline.c targets/targets.c targets/index.c bloom/bloom.c libbrainwallet.a -lgmp
+// ./test_pipeline
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "pipeline.h"
+
+/* 与 Brain "you are so sexy" 的报告一致 */
+static const char *EXPECT_RECORD =
+    "you are so sexy\t"
+    "a299e70c5dcec3357eb6beffe71206f63580f7217adab656fffc217df95fa484\t"
+    "L2fnZUEo3pjdzGNZdRwBV7m3tR3LLrXGh9xvkh8U9JEHkZcn9vTj\t"
+    "5K3u1ZTEc5ULFnd9kbeeiiQaHBRzrMjezakV3CMiwtwDQU7epGh\t"
+    "1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfr\t"
+    "3GWjK1umitr3xqTc3jVPAoZfK4gN6xZv3r\t"
+    "3E9EA5mfkzccKceR7TbawBtaoeKfGB4oni\t"
+    "bc1q52tac99q3wkq9u9qdug4gw30648evrj2vefgv2\t"
+    "bc1p52tac99q3wkq9u9qdug4gw30648evrj2887rpp\t"
+    "bc1qvyhwjp25wsmkcnxynh9cjmgwjq96hayc0mapev24dlf78mpyd2vq90zhk0\t"
+    "bc1qxh0383g9qa7zk6lpf4qc5d636svryhtcxm35ze3y59crut638vvqukrca3\t"
+    "1M7XqqkVuLJLrcYQnWRM3hLvc6nejCaBnp\t"
+    "3MoYmPEwTEciwnEquc5wUKhrkd5NHYoBPb\t"
+    "3NiRVs2i3yxYzEcTtHgQfTtS7CdPufeE5J\t"
+    "bc1qmj0vr5nq5pqqtr2s6lgde73gm7w2nvpqrvncxd\t"
+    "bc1pmj0vr5nq5pqqtr2s6lgde73gm7w2nvpqgjyntx\t"
+    "bc1qplhqcuzeg0m5wy62l9dxpz8hffm90jkpjrke0w83gdwwnyzpg7qswr3fxy\t"
+    "bc1q5yxe627fp04wjwqccxck5qh3sz2gnq8v6hww0vz5ffuvg4cyafrswxxtku\n";
+
+int main(void) {
+    int failed = 0;
+    BW_CTX ctx;
+    bw_ctx_init(&ctx);
+    PIPELINE_BATCH *batch = (PIPELINE_BATCH *)calloc(1, sizeof(PIPELINE_BATCH));
+    PIPELINE_OUTPUT out = { 0 };
+
+    printf("Testing a batch record against the single-phrase report...\n");
+    /* 短语视图无需以 '\0' 结尾 */
+    static const char text[] = "you are so sexyyou are so sexy!";
+    batch->phrases[0] = text;
+    batch->lens[0] = 15;
+    batch->phrases[1] = text + 15;
+    batch->lens[1] = 15;
+    batch->count = 2;
+    pipeline_derive(&ctx, batch, 1);
+    if (pipeline_format(batch, &out) != 0) {
+        printf("  FAIL pipeline_format\n");
+        failed = 1;
+    } else {
+        size_t n = strlen(EXPECT_RECORD);
+        if (out.len != 2 * n || memcmp(out.data, EXPECT_RECORD, n) != 0 ||
+            memcmp(out.data + n, EXPECT_RECORD, n) != 0) {
+            printf("  FAIL record text\n");
+            failed = 1;
+        }
+    }
+
+    printf("Testing binary records...\n");
+    static const uint8_t expect_priv[4] = { 0xa2, 0x99, 0xe7, 0x0c };
+    static const uint8_t expect_hash_comp[4] = { 0xa2, 0x97, 0xdc, 0x14 };
+    PIPELINE_BIN_HEADER header, parsed;
+    uint8_t header_buf[PIPELINE_BIN_HEADER_SIZE];
+    pipeline_bin_header_init(&header, PIPELINE_BIN_OFFSETS, 0x0102030405060708ULL);
+    pipeline_bin_header_encode(&header, header_buf);
+    batch->offsets[0] = 0;
+    batch->offsets[1] = 0x0102030405060708ULL;
+    out.len = 0;
+    /* 文件头的整数按小端写出，与平台无关 */
+    if (memcmp(header_buf, PIPELINE_BIN_MAGIC, 8) != 0 ||
+        header_buf[8] != PIPELINE_BIN_VERSION || header_buf[11] != 0 ||
+        header_buf[12] != PIPELINE_BIN_RECORD_MAX || header_buf[16] != PIPELINE_BIN_OFFSETS ||
+        header_buf[24] != 0x08 || header_buf[31] != 0x01 ||
+        pipeline_bin_header_check(header_buf, &parsed) != PIPELINE_BIN_RECORD_MAX ||
+        parsed.flags != PIPELINE_BIN_OFFSETS || parsed.iterations != 0x0102030405060708ULL) {
+        printf("  FAIL header encoding\n");
+        failed = 1;
+    }
+    if (pipeline_format_bin(batch, PIPELINE_BIN_OFFSETS, &out) != 0 ||
+        out.len != 2 * PIPELINE_BIN_RECORD_MAX) {
+        printf("  FAIL record size\n");
+        failed = 1;
+    } else {
+        const uint8_t *rec = (const uint8_t *)out.data + PIPELINE_BIN_RECORD_MAX;
+        if (memcmp(rec, expect_priv, 4) != 0 ||
+            memcmp(rec + BW_PRIVKEY_LEN, expect_hash_comp, 4) != 0 ||
+            memcmp(rec + BW_PRIVKEY_LEN + BW_HASH160_LEN, batch->hash_uncomp + BW_HASH160_LEN, BW_HASH160_LEN) != 0 ||
+            rec[PIPELINE_BIN_RECORD_BASE] != 0x08 || rec[PIPELINE_BIN_RECORD_BASE + 7] != 0x01) {
+            printf("  FAIL record content\n");
+            failed = 1;
+        }
+    }
+    out.len = 0;
+    if (pipeline_format_bin(batch, 0, &out) != 0 || out.len != 2 * PIPELINE_BIN_RECORD_BASE) {
+        printf("  FAIL record size without offsets\n");
+        failed = 1;
+    }
+
+    printf("Testing output plans...\n");
+    PIPELINE_PLAN plan;
+    const char *bad = NULL;
+    if (pipeline_plan_parse("wif-c", &plan, NULL) != 0 || plan.stages != 0 ||
+        pipeline_plan_parse("P2WSH-c", &plan, NULL) != 0 || plan.stages != PIPELINE_STAGE_PUB_COMP ||
+        plan.types_comp != ADDRESS_P2WSH || plan.types_uncomp != 0 ||
+        pipeline_plan_parse("p2wpkh-c,hash160-u", &plan, NULL) != 0 ||
+        plan.stages != (PIPELINE_STAGE_HASH_COMP | PIPELINE_STAGE_HASH_UNCOMP) ||
+        plan.types_comp != ADDRESS_BECH32 || plan.ncolumns != 2 ||
+        pipeline_plan_parse("wif,p2pkh", &plan, NULL) != 0 || plan.ncolumns != 4 ||
+        pipeline_plan_parse("wif,nope-c,priv", &plan, &bad) == 0 || strncmp(bad, "nope-c,", 7) != 0 ||
+        pipeline_plan_parse("", &plan, NULL) == 0) {
+        printf("  FAIL pipeline_plan_parse\n");
+        failed = 1;
+    }
+    /* 只要 WIF 与压缩 P2PKH：与完整记录的对应列一致 */
+    pipeline_plan_parse("wif-c,p2pkh-c", &plan, NULL);
+    memset(batch, 0, sizeof(*batch));
+    batch->phrases[0] = text;
+    batch->lens[0] = 15;
+    batch->count = 1;
+    pipeline_derive_keys(&ctx, batch, 1, plan.stages);
+    pipeline_derive_addresses(batch, &plan);
+    out.len = 0;
+    static const char *expect_plan =
+        "you are so sexy\tL2fnZUEo3pjdzGNZdRwBV7m3tR3LLrXGh9xvkh8U9JEHkZcn9vTj\t1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfr\n";
+    if (pipeline_format_plan(batch, &plan, &out) != 0 || out.len != strlen(expect_plan) ||
+        memcmp(out.data, expect_plan, out.len) != 0) {
+        printf("  FAIL plan record\n");
+        failed = 1;
+    }
+
+    printf("Testing a full batch...\n");
+    static char phrases[PIPELINE_BATCH_SIZE][16];
+    out.len = 0;
+    for (size_t i = 0; i < PIPELINE_BATCH_SIZE; i++) {
+        batch->lens[i] = (size_t)snprintf(phrases[i], sizeof(phrases[i]), "p%zu", i);
+        batch->phrases[i] = phrases[i];
+    }
+    batch->count = PIPELINE_BATCH_SIZE;
+    pipeline_derive(&ctx, batch, 2);
+    pipeline_format(batch, &out);
+    size_t lines = 0;
+    for (size_t i = 0; i < out.len; i++)
+        lines += out.data[i] == '\n';
+    if (lines != PIPELINE_BATCH_SIZE) {
+        printf("  FAIL expected %d records, got %zu\n", PIPELINE_BATCH_SIZE, lines);
+        failed = 1;
+    }
+
+    printf("Testing shards...\n");
+    unsigned si, sn;
+    if (pipeline_shard_parse("2/5", &si, &sn) != 0 || si != 2 || sn != 5 ||
+        pipeline_shard_parse("5/5", &si, &sn) == 0 || pipeline_shard_parse("1/0", &si, &sn) == 0 ||
+        pipeline_shard_parse("1/", &si, &sn) == 0 || pipeline_shard_parse("-1/3", &si, &sn) == 0 ||
+        pipeline_shard_parse("0/65537", &si, &sn) == 0) {
+        printf("  FAIL shard parse\n");
+        failed = 1;
+    }
+    /* 哈希分片确定且大致均匀 */
+    size_t per_shard[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < PIPELINE_BATCH_SIZE; i++) {
+        unsigned s = pipeline_shard_of(phrases[i], batch->lens[i], 3);
+        if (s >= 3 || s != pipeline_shard_of(phrases[i], batch->lens[i], 3)) {
+            printf("  FAIL shard of %s\n", phrases[i]);
+            failed = 1;
+            break;
+        }
+        per_shard[s]++;
+    }
+    for (int k = 0; k < 3; k++) {
+        if (per_shard[k] < PIPELINE_BATCH_SIZE / 6) {
+            printf("  FAIL shard %d got %zu of %d phrases\n", k, per_shard[k], PIPELINE_BATCH_SIZE);
+            failed = 1;
+        }
+    }
+    /* 切点首尾相接、单调，接近均分，大数不溢出 */
+    static const uint64_t totals[] = { 0, 1, 7, 1000, UINT64_MAX };
+    for (size_t t = 0; t < sizeof(totals) / sizeof(totals[0]); t++) {
+        uint64_t total = totals[t], prev = 0;
+        if (pipeline_split_point(total, 0, 3) != 0 || pipeline_split_point(total, 3, 3) != total) {
+            printf("  FAIL split ends for %llu\n", (unsigned long long)total);
+            failed = 1;
+        }
+        for (uint64_t k = 1; k <= 3; k++) {
+            uint64_t cut = pipeline_split_point(total, k, 3);
+            if (cut < prev || cut - prev > total / 3 + 1) {
+                printf("  FAIL split %llu of %llu\n", (unsigned long long)k, (unsigned long long)total);
+                failed = 1;
+            }
+            prev = cut;
+        }
+    }
+
+    printf("Testing key ranges...\n");
+    PIPELINE_KEYSPACE ks;
+    uint8_t key[BW_PRIVKEY_LEN], want[BW_PRIVKEY_LEN];
+    memset(ks.start, 0, sizeof(ks.start));
+    memset(ks.start + 16, 0xff, 16);
+    ks.start[15] = 0x01;
+    ks.count = 3;
+    pipeline_keyspace_key(&ks, 2, key);
+    /* ...01ffff...ff + 2 = ...020000...01，进位跨过低 16 字节 */
+    memset(want, 0, sizeof(want));
+    want[15] = 0x02;
+    want[31] = 0x01;
+    if (memcmp(key, want, sizeof(want)) != 0) {
+        printf("  FAIL keyspace carry\n");
+        failed = 1;
+    }
+    memset(ks.start, 0, sizeof(ks.start));
+    pipeline_keyspace_key(&ks, 0x0102030405060708ULL, key);
+    if (key[23] != 0 || key[24] != 0x01 || key[31] != 0x08) {
+        printf("  FAIL keyspace index\n");
+        failed = 1;
+    }
+
+    pipeline_output_free(&out);
+    free(batch);
+    bw_ctx_free(&ctx);
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
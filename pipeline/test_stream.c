@@ -0,0 +1,285 @@
+// make lib && gcc -O2 -pthread -o test_stream pipeline/test_stream.c pipeline/stream.c pipeline/pipeline.c threadpool/threadpool.c wordlist/wordlist.c rules/rules.c combine/combine.c checkpoint/checkpoint.c targets/targets.c targets/index.c bloom/bloom.c libbrainwallet.a -lgmp
+// ./test_stream
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pipeline.h"
+#include "../wordlist/wordlist.h"
+#include "../checkpoint/checkpoint.h"
+
+#define WORDS 6000
+
+static int failures = 0;
+
+static void check(int cond, const char *what) {
+    if (!cond) {
+        printf("  FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/*
+ * 捕获输出的内存流。写入超过 limit 字节后返回错误，模拟节点在扫描中途崩溃：
+ * 之前刷出的记录与检查点保留下来，之后的都丢失。
+ */
+typedef struct capture {
+    char *data;
+    size_t len;
+    size_t cap;
+    size_t limit;
+} CAPTURE;
+
+static ssize_t capture_write(void *cookie, const char *buf, size_t size) {
+    CAPTURE *c = (CAPTURE *)cookie;
+    if (c->len >= c->limit)
+        return -1;
+    size_t n = size < c->limit - c->len ? size : c->limit - c->len;
+    if (c->len + n > c->cap) {
+        size_t cap = c->cap ? c->cap * 2 : 65536;
+        while (cap < c->len + n)
+            cap *= 2;
+        char *grown = (char *)realloc(c->data, cap);
+        if (grown == NULL)
+            return -1;
+        c->data = grown;
+        c->cap = cap;
+    }
+    memcpy(c->data + c->len, buf, n);
+    c->len += n;
+    return (ssize_t)n;
+}
+
+static const cookie_io_functions_t CAPTURE_IO = { NULL, capture_write, NULL, NULL };
+
+static char dir[] = "/tmp/test_stream_XXXXXX";
+static char words_path[64], state_path[64];
+static BW_CTX ctx;
+static WORDLIST wl;
+static PIPELINE_PLAN plan;
+static char *expected[WORDS];   /* 每个词的完整记录行（含换行） */
+
+/* 运行一次流水线，输出写入 out（在已有内容之后追加）；stdin_mode 时逐行读取词表文件 */
+static int run(int ordered, int threads, int stdin_mode, const CHECKPOINT *resume, size_t limit, CAPTURE *out) {
+    out->limit = limit;
+    FILE *fp = fopencookie(out, "w", CAPTURE_IO);
+    FILE *in = stdin_mode ? fopen(words_path, "r") : NULL;
+    if (fp == NULL || (stdin_mode && in == NULL))
+        return -2;
+    PIPELINE_STREAM_CONFIG cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.ctx = &ctx;
+    cfg.iterations = 1;
+    cfg.threads = threads;
+    cfg.ordered = ordered;
+    cfg.in = in;
+    cfg.out = fp;
+    cfg.wordlist = stdin_mode ? NULL : &wl;
+    cfg.plan = &plan;
+    cfg.checkpoint = state_path;
+    cfg.checkpoint_interval = 0;    /* 每写出一个批次对象都保存检查点 */
+    cfg.resume = resume;
+    cfg.shard_count = 1;
+    PIPELINE_STREAM_STATS stats;
+    int ret = pipeline_run_stream(&cfg, &stats);
+    fclose(fp);
+    if (in != NULL)
+        fclose(in);
+    return ret;
+}
+
+/* 输出中每个词恰好出现一次，且记录与完整运行一致 */
+static int check_complete(const char *data, size_t len) {
+    static unsigned char seen[WORDS];
+    memset(seen, 0, sizeof(seen));
+    size_t lines = 0;
+    const char *p = data, *end = data + len;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        if (nl == NULL)
+            return 0;
+        int w;
+        if (sscanf(p, "w%d\t", &w) != 1 || w < 0 || w >= WORDS || seen[w] ||
+            strlen(expected[w]) != (size_t)(nl + 1 - p) || memcmp(expected[w], p, (size_t)(nl + 1 - p)) != 0)
+            return 0;
+        seen[w] = 1;
+        lines++;
+        p = nl + 1;
+    }
+    return lines == WORDS;
+}
+
+/*
+ * 在输出第 limit 字节处“崩溃”，按检查点截断已有输出后恢复；
+ * again 非 0 时恢复后再写出 limit / 8 字节处崩溃一次。最终输出在 out 中，cp_ranges 记录首个检查点的区间数。
+ */
+static int crash_and_resume(int ordered, int threads, int stdin_mode, size_t limit, int again,
+                            CAPTURE *out, size_t *cp_ranges) {
+    memset(out, 0, sizeof(*out));
+    unlink(state_path);
+    if (run(ordered, threads, stdin_mode, NULL, limit, out) == 0)
+        return -1;   /* 应当写失败 */
+    CHECKPOINT cp;
+    if (checkpoint_load(state_path, &cp) != 0 || cp.output > out->len)
+        return -1;
+    *cp_ranges = cp.nranges;
+    out->len = (size_t)cp.output;   /* 与 pipeline_stream_resume 截断输出文件相同 */
+    if (again) {
+        if (run(ordered, threads, stdin_mode, &cp, out->len + limit / 8, out) == 0) {
+            checkpoint_free(&cp);
+            return -1;
+        }
+        checkpoint_free(&cp);
+        if (checkpoint_load(state_path, &cp) != 0 || cp.output > out->len)
+            return -1;
+        out->len = (size_t)cp.output;
+    }
+    int ret = run(ordered, threads, stdin_mode, &cp, SIZE_MAX, out);
+    checkpoint_free(&cp);
+    return ret;
+}
+
+static void test_resume(void) {
+    printf("Testing crash and resume from checkpoints...\n");
+    CAPTURE full;
+    memset(&full, 0, sizeof(full));
+    check(run(1, 4, 0, NULL, SIZE_MAX, &full) == 0, "full run");
+    const char *p = full.data;
+    for (int w = 0; w < WORDS; w++) {
+        const char *nl = memchr(p, '\n', full.len - (size_t)(p - full.data));
+        if (nl == NULL) {
+            check(0, "full run record count");
+            return;
+        }
+        expected[w] = strndup(p, (size_t)(nl + 1 - p));
+        p = nl + 1;
+    }
+    check(check_complete(full.data, full.len), "full run records");
+
+    static const struct {
+        int ordered, threads, stdin_mode, again;
+        const char *name;
+    } modes[] = {
+        { 0, 4, 0, 0, "unordered wordlist" },
+        { 0, 4, 0, 1, "unordered wordlist, crash during resume" },
+        { 1, 3, 0, 0, "ordered wordlist" },
+        { 1, 3, 1, 0, "ordered stdin" },
+        { 0, 3, 1, 1, "unordered stdin, crash during resume" },
+    };
+    size_t max_ranges = 0;
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (int k = 1; k <= 4; k++) {
+            CAPTURE out;
+            size_t ranges = 0;
+            int ret = crash_and_resume(modes[m].ordered, modes[m].threads, modes[m].stdin_mode,
+                                       full.len * (size_t)k / 5, modes[m].again, &out, &ranges);
+            int ok = ret == 0 && check_complete(out.data, out.len) &&
+                     (!modes[m].ordered || (out.len == full.len && memcmp(out.data, full.data, full.len) == 0));
+            if (!ok) {
+                printf("  FAIL %s, crash at %d/5\n", modes[m].name, k);
+                failures++;
+            }
+            if (!modes[m].stdin_mode && ranges > max_ranges)
+                max_ranges = ranges;
+            free(out.data);
+        }
+    }
+    /* 无序模式按线程切成多个区间，检查点中应出现多个剩余区间 */
+    check(max_ranges > 1, "checkpoint with several ranges");
+    free(full.data);
+}
+
+/* 手工构造的多区间检查点：恢复时恰好输出这些区间内的词 */
+static void test_ranges(void) {
+    printf("Testing resume from explicit ranges...\n");
+    static const int spans[][2] = { { 10, 20 }, { 21, 22 }, { 100, 357 }, { 5000, WORDS } };
+    enum { NSPANS = sizeof(spans) / sizeof(spans[0]) };
+    CHECKPOINT_RANGE ranges[NSPANS];
+    for (int i = 0; i < NSPANS; i++) {
+        ranges[i].begin = 0;
+        ranges[i].end = 0;
+    }
+    /* 词 i 所在行的字节偏移 */
+    size_t off = 0;
+    for (int w = 0; w <= WORDS; w++) {
+        for (int i = 0; i < NSPANS; i++) {
+            if (w == spans[i][0])
+                ranges[i].begin = off;
+            if (w == spans[i][1])
+                ranges[i].end = off;
+        }
+        if (w < WORDS)
+            off += (size_t)snprintf(NULL, 0, "w%d\n", w);
+    }
+    CHECKPOINT cp = { CHECKPOINT_SOURCE_WORDLIST, wl.size, 1, 0, 0, 1, 0, 0, 0, NSPANS, ranges };
+    for (int ordered = 0; ordered <= 1; ordered++) {
+        CAPTURE out;
+        memset(&out, 0, sizeof(out));
+        check(run(ordered, 3, 0, &cp, SIZE_MAX, &out) == 0, "resume run");
+        static unsigned char seen[WORDS];
+        memset(seen, 0, sizeof(seen));
+        size_t lines = 0, pos = 0;
+        int in_order = 1, prev = -1, ok = 1;
+        while (pos < out.len) {
+            int w;
+            const char *nl = memchr(out.data + pos, '\n', out.len - pos);
+            if (nl == NULL || sscanf(out.data + pos, "w%d\t", &w) != 1 || w < 0 || w >= WORDS || seen[w]) {
+                ok = 0;
+                break;
+            }
+            seen[w] = 1;
+            in_order &= w > prev;
+            prev = w;
+            lines++;
+            pos = (size_t)(nl + 1 - out.data);
+        }
+        size_t want = 0;
+        for (int i = 0; i < NSPANS; i++) {
+            want += (size_t)(spans[i][1] - spans[i][0]);
+            for (int w = spans[i][0]; w < spans[i][1]; w++)
+                ok &= seen[w];
+        }
+        check(ok && lines == want, ordered ? "ordered ranges" : "unordered ranges");
+        check(!ordered || in_order, "ordered ranges in input order");
+        free(out.data);
+    }
+}
+
+int main(void) {
+    if (mkdtemp(dir) == NULL) {
+        printf("  FAIL mkdtemp\n");
+        return 1;
+    }
+    snprintf(words_path, sizeof(words_path), "%s/words", dir);
+    snprintf(state_path, sizeof(state_path), "%s/state", dir);
+    FILE *fp = fopen(words_path, "w");
+    for (int w = 0; fp != NULL && w < WORDS; w++)
+        fprintf(fp, "w%d\n", w);
+    if (fp == NULL || fclose(fp) != 0 || wordlist_open(&wl, words_path) != 0) {
+        printf("  FAIL write words\n");
+        return 1;
+    }
+    bw_ctx_init(&ctx);
+    pipeline_plan_parse("priv", &plan, NULL);
+
+    test_resume();
+    test_ranges();
+
+    for (int w = 0; w < WORDS; w++)
+        free(expected[w]);
+    bw_ctx_free(&ctx);
+    wordlist_close(&wl);
+    unlink(words_path);
+    unlink(state_path);
+    rmdir(dir);
+    if (failures) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -425,3 +425,33 @@ void RMD160Data(const unsigned char *buf, unsigned int len, char *out)	{
 	RMD160Update(&ctx,(unsigned char *)buf,len);
 	RMD160Final((unsigned char *)out,&ctx);
 }
+
+/*
+ * 专用于 32 字节输入（例如 SHA-256 摘要）的 RIPEMD-160：
+ * 消息填充后恰好一个块，直接按小端读入消息字并放入常量填充，
+ * 只做一次压缩，不经过上下文结构、不复制、不清零。
+ */
+void
+ripemd160_32 (const unsigned char digest[32], unsigned char out[20])
+{
+  uint32_t MDbuf[RIPEMD160_HASHWORDS];
+  uint32_t X[16];
+  int i;
+
+  rmd160ByteSwap (X, digest, 8);
+  X[8] = 0x80;
+  X[9] = X[10] = X[11] = X[12] = X[13] = 0;
+  X[14] = 32 << 3;
+  X[15] = 0;
+
+  RMDinit (MDbuf);
+  RMDcompress (MDbuf, X);
+
+  for (i = 0; i < RIPEMD160_HASHWORDS; i++)
+    {
+      out[i * 4 + 0] = (uint8_t) MDbuf[i];
+      out[i * 4 + 1] = (uint8_t) (MDbuf[i] >> 8);
+      out[i * 4 + 2] = (uint8_t) (MDbuf[i] >> 16);
+      out[i * 4 + 3] = (uint8_t) (MDbuf[i] >> 24);
+    }
+}
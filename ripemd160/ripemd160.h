@@ -2,6 +2,7 @@
 #define _RIPEMD160_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <sys/types.h>
 
 #include <sys/cdefs.h>
@@ -37,6 +38,18 @@ void   RMD160Final(unsigned char [RMD160_HASHBYTES], RMD160_CTX *);
 char * RMD160End(RMD160_CTX *, char *);
 char * RMD160File(const char *, char *);
 void RMD160Data(const unsigned char *, unsigned int, char *);
+
+/*
+ * 计算恰好 32 字节输入的 RIPEMD-160（单块、常量填充、无上下文）
+ */
+void ripemd160_32(const unsigned char digest[32], unsigned char out[20]);
+
+/*
+ * 批量计算 count 个连续存放的 32 字节消息的 RIPEMD-160，
+ * 结果依次写入 output（每个 20 字节）。
+ * 在支持的 CPU 上使用 AVX2（8 路）/ AVX-512（16 路）多缓冲实现。
+ */
+void ripemd160_32_many(const unsigned char *input, size_t count, unsigned char *output);
 __END_DECLS
 
 #endif
@@ -0,0 +1,71 @@
+// gcc -O2 -o test_ripemd160 test_ripemd160.c ripemd160.c ripemd160_simd.c
+// ./test_ripemd160
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ripemd160.h"
+
+static void to_hex(const unsigned char *data, size_t len, char *out) {
+    for (size_t i = 0; i < len; i++) {
+        sprintf(out + i * 2, "%02x", data[i]);
+    }
+}
+
+static int check_vector(const char *msg, const char *expected) {
+    unsigned char hash[20];
+    char hex[41];
+    RMD160Data((const unsigned char *)msg, strlen(msg), (char *)hash);
+    to_hex(hash, 20, hex);
+    if (strcmp(hex, expected) != 0) {
+        printf("  FAIL \"%s\": %s\n", msg, hex);
+        return 1;
+    }
+    return 0;
+}
+
+/* 单块专用接口、批量接口与逐条 RMD160Data 的结果比较，覆盖 16 路、8 路与标量剩余部分 */
+static int check_many(void) {
+    enum { COUNT = 61 };
+    static unsigned char input[COUNT * 32], expect[COUNT * 20], got[COUNT * 20];
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (unsigned char)(i * 31 + 7);
+    }
+    for (int n = 0; n < COUNT; n++) {
+        RMD160Data(input + n * 32, 32, (char *)(expect + n * 20));
+    }
+    for (int n = 0; n < COUNT; n++) {
+        ripemd160_32(input + n * 32, got + n * 20);
+    }
+    if (memcmp(expect, got, sizeof(got)) != 0) {
+        printf("  FAIL ripemd160_32\n");
+        return 1;
+    }
+    for (int n = 0; n <= COUNT; n++) {
+        memset(got, 0, sizeof(got));
+        ripemd160_32_many(input, n, got);
+        if (memcmp(expect, got, n * 20) != 0) {
+            printf("  FAIL ripemd160_32_many count %d\n", n);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    printf("Testing RIPEMD-160 vectors...\n");
+    failed |= check_vector("", "9c1185a5c5e9fc54612808977ee8f548b2258d31");
+    failed |= check_vector("abc", "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+    failed |= check_vector("12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+                           "9b752e45573d4b39f4dbd3323cab82bf63326bfb");
+    printf("Testing 32-byte and multi-buffer RIPEMD-160...\n");
+    failed |= check_many();
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,310 @@
+/*
+ * rules.c
+ *
+ * 规则解析与应用。规则先解析为函数数组，应用时在两个定长缓冲区之间来回变换，
+ * 对每个候选不再解析文本，也不分配内存。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rules.h"
+
+/* 位置字符：0-9 为 0-9，A-Z 为 10-35 */
+static int rule_position(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/* 各函数的参数格式：N 位置，X 字符 */
+static const char *rule_args(char code) {
+    switch (code) {
+    case ':': case 'l': case 'u': case 'c': case 'C': case 't': case 'r': case 'd':
+    case 'f': case '{': case '}': case '[': case ']': case 'q':
+        return "";
+    case 'T': case 'D': case '\'': case 'z': case 'Z':
+        return "N";
+    case '$': case '^': case '@':
+        return "X";
+    case 'x':
+        return "NN";
+    case 'i': case 'o':
+        return "NX";
+    case 's':
+        return "XX";
+    }
+    return NULL;
+}
+
+int rule_parse(const char *text, size_t len, RULE *rule) {
+    rule->nops = 0;
+    size_t i = 0;
+    while (i < len) {
+        char code = text[i++];
+        if (code == ' ' || code == '\t')
+            continue;
+        const char *args = rule_args(code);
+        if (args == NULL || rule->nops == RULES_MAX_OPS)
+            return -1;
+        RULE_OP *op = &rule->ops[rule->nops++];
+        memset(op, 0, sizeof(*op));
+        op->code = code;
+        int positions = 0, chars = 0;
+        for (const char *a = args; *a != '\0'; a++) {
+            if (i >= len)
+                return -1;
+            char c = text[i++];
+            if (*a == 'N') {
+                int n = rule_position(c);
+                if (n < 0)
+                    return -1;
+                if (positions++ == 0)
+                    op->n = (uint8_t)n;
+                else
+                    op->m = (uint8_t)n;
+            } else {
+                if (chars++ == 0)
+                    op->x = c;
+                else
+                    op->y = c;
+            }
+        }
+    }
+    return 0;
+}
+
+static inline char to_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+}
+
+static inline char to_upper(char c) {
+    return (c >= 'a' && c <= 'z') ? (char)(c - 32) : c;
+}
+
+static inline char toggle(char c) {
+    if (c >= 'a' && c <= 'z')
+        return (char)(c - 32);
+    if (c >= 'A' && c <= 'Z')
+        return (char)(c + 32);
+    return c;
+}
+
+/*
+ * 在原地变换 buf[0..len)，需要额外空间的函数借助 tmp。
+ * 返回新长度，超出 RULES_MAX_LEN 返回 -1；位置越界的函数不改变词（与 hashcat 相同）。
+ */
+static int apply_op(const RULE_OP *op, char *buf, size_t len, char *tmp) {
+    size_t n = op->n;
+    switch (op->code) {
+    case ':':
+        break;
+    case 'l':
+        for (size_t i = 0; i < len; i++)
+            buf[i] = to_lower(buf[i]);
+        break;
+    case 'u':
+        for (size_t i = 0; i < len; i++)
+            buf[i] = to_upper(buf[i]);
+        break;
+    case 'c':
+    case 'C':
+        for (size_t i = 0; i < len; i++)
+            buf[i] = (i == 0) == (op->code == 'c') ? to_upper(buf[i]) : to_lower(buf[i]);
+        break;
+    case 't':
+        for (size_t i = 0; i < len; i++)
+            buf[i] = toggle(buf[i]);
+        break;
+    case 'T':
+        if (n < len)
+            buf[n] = toggle(buf[n]);
+        break;
+    case 'r':
+        for (size_t i = 0, j = len; i + 1 < j; i++, j--) {
+            char c = buf[i];
+            buf[i] = buf[j - 1];
+            buf[j - 1] = c;
+        }
+        break;
+    case 'd':
+        if (2 * len > RULES_MAX_LEN)
+            return -1;
+        memcpy(buf + len, buf, len);
+        return (int)(2 * len);
+    case 'f':
+        if (2 * len > RULES_MAX_LEN)
+            return -1;
+        for (size_t i = 0; i < len; i++)
+            buf[len + i] = buf[len - 1 - i];
+        return (int)(2 * len);
+    case '{':
+        if (len > 1) {
+            char c = buf[0];
+            memmove(buf, buf + 1, len - 1);
+            buf[len - 1] = c;
+        }
+        break;
+    case '}':
+        if (len > 1) {
+            char c = buf[len - 1];
+            memmove(buf + 1, buf, len - 1);
+            buf[0] = c;
+        }
+        break;
+    case '$':
+        if (len + 1 > RULES_MAX_LEN)
+            return -1;
+        buf[len] = op->x;
+        return (int)(len + 1);
+    case '^':
+        if (len + 1 > RULES_MAX_LEN)
+            return -1;
+        memmove(buf + 1, buf, len);
+        buf[0] = op->x;
+        return (int)(len + 1);
+    case '[':
+        if (len > 0)
+            memmove(buf, buf + 1, --len);
+        break;
+    case ']':
+        if (len > 0)
+            len--;
+        break;
+    case 'D':
+        if (n < len) {
+            memmove(buf + n, buf + n + 1, len - n - 1);
+            len--;
+        }
+        break;
+    case 'x':
+        if (n < len && n + op->m <= len) {
+            memmove(buf, buf + n, op->m);
+            len = op->m;
+        }
+        break;
+    case 'i':
+        if (n <= len) {
+            if (len + 1 > RULES_MAX_LEN)
+                return -1;
+            memmove(buf + n + 1, buf + n, len - n);
+            buf[n] = op->x;
+            len++;
+        }
+        break;
+    case 'o':
+        if (n < len)
+            buf[n] = op->x;
+        break;
+    case '\'':
+        if (n < len)
+            len = n;
+        break;
+    case 's':
+        for (size_t i = 0; i < len; i++) {
+            if (buf[i] == op->x)
+                buf[i] = op->y;
+        }
+        break;
+    case '@': {
+        size_t j = 0;
+        for (size_t i = 0; i < len; i++) {
+            if (buf[i] != op->x)
+                buf[j++] = buf[i];
+        }
+        len = j;
+        break;
+    }
+    case 'z':
+    case 'Z':
+        if (len > 0) {
+            if (len + n > RULES_MAX_LEN)
+                return -1;
+            if (op->code == 'z') {
+                memmove(buf + n, buf, len);
+                memset(buf, buf[n], n);
+            } else {
+                memset(buf + len, buf[len - 1], n);
+            }
+            len += n;
+        }
+        break;
+    case 'q':
+        if (2 * len > RULES_MAX_LEN)
+            return -1;
+        memcpy(tmp, buf, len);
+        for (size_t i = 0; i < len; i++)
+            buf[2 * i] = buf[2 * i + 1] = tmp[i];
+        return (int)(2 * len);
+    }
+    return (int)len;
+}
+
+int rule_apply(const RULE *rule, const char *word, size_t len, char *out) {
+    char tmp[RULES_MAX_LEN];
+    if (len > RULES_MAX_LEN)
+        return -1;
+    memcpy(out, word, len);
+    int cur = (int)len;
+    for (size_t i = 0; i < rule->nops && cur >= 0; i++)
+        cur = apply_op(&rule->ops[i], out, (size_t)cur, tmp);
+    return cur > 0 ? cur : -1;
+}
+
+int rules_load(const char *path, RULE_SET *set) {
+    set->rules = NULL;
+    set->count = 0;
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: 无法打开规则文件 %s\n", path);
+        return -1;
+    }
+    size_t cap = 0;
+    char *line = NULL;
+    size_t line_cap = 0;
+    ssize_t len;
+    unsigned long lineno = 0;
+    int ret = 0;
+    while ((len = getline(&line, &line_cap, fp)) != -1) {
+        lineno++;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            len--;
+        if (len == 0 || line[0] == '#')
+            continue;
+        if (set->count == cap) {
+            size_t grown_cap = cap ? cap * 2 : 64;
+            RULE *grown = (RULE *)realloc(set->rules, grown_cap * sizeof(RULE));
+            if (grown == NULL) {
+                fprintf(stderr, "Error: 内存分配失败\n");
+                ret = -1;
+                break;
+            }
+            set->rules = grown;
+            cap = grown_cap;
+        }
+        if (rule_parse(line, (size_t)len, &set->rules[set->count]) != 0) {
+            fprintf(stderr, "Error: 规则文件 %s 第 %lu 行无效: %.*s\n", path, lineno, (int)len, line);
+            ret = -1;
+            break;
+        }
+        set->count++;
+    }
+    free(line);
+    fclose(fp);
+    if (ret == 0 && set->count == 0) {
+        fprintf(stderr, "Error: 规则文件 %s 中没有规则\n", path);
+        ret = -1;
+    }
+    if (ret != 0)
+        rules_free(set);
+    return ret;
+}
+
+void rules_free(RULE_SET *set) {
+    free(set->rules);
+    set->rules = NULL;
+    set->count = 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * rules.h
+ *
+ * 口令变换规则引擎，语法为 hashcat 规则的子集。规则文件每行一条规则，
+ * 一条规则由若干函数依次作用于基础词；空行与 '#' 开头的行忽略，函数间的空格忽略。
+ *
+ * 支持的函数（N、M 为位置 0-9、A-Z 表示 10-35，X、Y 为任意字符）：
+ *     :    不变                      l    全部小写
+ *     u    全部大写                  c    首字母大写、其余小写
+ *     C    首字母小写、其余大写      t    切换全部大小写
+ *     TN   切换第 N 个字符大小写     r    反转
+ *     d    重复整个词                f    追加反转的自身
+ *     {    循环左移一位              }    循环右移一位
+ *     $X   末尾追加 X                ^X   开头插入 X
+ *     [    删除首字符                ]    删除末字符
+ *     DN   删除第 N 个字符           xNM  取从 N 开始的 M 个字符
+ *     iNX  在 N 处插入 X             oNX  将第 N 个字符改为 X
+ *     'N   截断为 N 个字符           sXY  把全部 X 替换为 Y
+ *     @X   删除全部 X                zN   首字符重复 N 次
+ *     ZN   末字符重复 N 次           q    每个字符重复一次
+ *
+ * 变换在调用者提供的 RULES_MAX_LEN 字节缓冲区内完成，不分配内存。
+ */
+
+#ifndef RULES_H
+#define RULES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RULES_MAX_LEN 256   /* 变换结果的最大长度，超出时该候选被丢弃 */
+#define RULES_MAX_OPS 32    /* 每条规则最多的函数个数 */
+
+typedef struct rule_op {
+    char code;
+    uint8_t n;          /* 位置或次数 */
+    uint8_t m;
+    char x;
+    char y;
+} RULE_OP;
+
+typedef struct rule {
+    size_t nops;
+    RULE_OP ops[RULES_MAX_OPS];
+} RULE;
+
+typedef struct rule_set {
+    RULE *rules;
+    size_t count;
+} RULE_SET;
+
+/**
+ * rule_parse - 解析一条规则
+ *
+ * @text: 规则文本，无需以 '\0' 结尾
+ * @len: 文本长度
+ *
+ * 成功返回 0；未知函数、缺少参数或函数过多返回 -1。
+ */
+int rule_parse(const char *text, size_t len, RULE *rule);
+
+/**
+ * rule_apply - 将规则作用于一个词
+ *
+ * @word, @len: 基础词（可以指向 out 之外的任何位置，无需以 '\0' 结尾）
+ * @out: 输出缓冲区，至少 RULES_MAX_LEN 字节
+ *
+ * 返回结果长度；结果超出 RULES_MAX_LEN 或为空时返回 -1（该候选应跳过）。
+ */
+int rule_apply(const RULE *rule, const char *word, size_t len, char *out);
+
+/**
+ * rules_load - 读取规则文件
+ *
+ * 出错时输出错误行号并返回 -1；文件中没有任何规则同样返回 -1。
+ */
+int rules_load(const char *path, RULE_SET *set);
+void rules_free(RULE_SET *set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RULES_H */
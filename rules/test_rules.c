@@ -0,0 +1,112 @@
+// gcc -O2 -o test_rules test_rules.c rules.c
+// ./test_rules
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "rules.h"
+
+static const struct {
+    const char *rule;
+    const char *word;
+    const char *expect;     /* NULL 表示候选被丢弃 */
+} CASES[] = {
+    { ":", "password", "password" },
+    { "l", "PassWord", "password" },
+    { "u", "PassWord", "PASSWORD" },
+    { "c", "pASSWORD", "Password" },
+    { "C", "password", "pASSWORD" },
+    { "t", "PassWord", "pASSwORD" },
+    { "T0 T2", "password", "PaSsword" },
+    { "r", "password", "drowssap" },
+    { "d", "pass", "passpass" },
+    { "f", "pass", "passssap" },
+    { "{", "password", "asswordp" },
+    { "}", "password", "dpasswor" },
+    { "$1 $2 $3", "password", "password123" },
+    { "$1$9$9$0", "pass", "pass1990" },
+    { "^!", "pass", "!pass" },
+    { "[", "password", "assword" },
+    { "]", "password", "passwor" },
+    { "D3", "password", "pasword" },
+    { "x04", "password", "pass" },
+    { "i4!", "password", "pass!word" },
+    { "o0P", "password", "Password" },
+    { "'4", "password", "pass" },
+    { "sa@ so0 ss$", "password", "p@$$w0rd" },
+    { "@s", "password", "paword" },
+    { "z2", "abc", "aaabc" },
+    { "Z2", "abc", "abccc" },
+    { "q", "abc", "aabbcc" },
+    { "D9", "abc", "abc" },             /* 位置越界时不变 */
+    { "c $2 $0 $2 $4", "satoshi", "Satoshi2024" },
+    { "]]]", "abc", NULL },             /* 结果为空 */
+};
+
+static const char *INVALID[] = { "X", "$", "T", "Tz", "s1", "x0" };
+
+int main(void) {
+    int failed = 0;
+    RULE rule;
+    char out[RULES_MAX_LEN];
+
+    printf("Testing rule functions...\n");
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        if (rule_parse(CASES[i].rule, strlen(CASES[i].rule), &rule) != 0) {
+            printf("  FAIL parse \"%s\"\n", CASES[i].rule);
+            failed = 1;
+            continue;
+        }
+        int len = rule_apply(&rule, CASES[i].word, strlen(CASES[i].word), out);
+        if (CASES[i].expect == NULL ? len != -1
+                                    : (len != (int)strlen(CASES[i].expect) || memcmp(out, CASES[i].expect, len) != 0)) {
+            printf("  FAIL \"%s\" on %s -> %.*s\n", CASES[i].rule, CASES[i].word, len > 0 ? len : 0, out);
+            failed = 1;
+        }
+    }
+    for (size_t i = 0; i < sizeof(INVALID) / sizeof(INVALID[0]); i++) {
+        if (rule_parse(INVALID[i], strlen(INVALID[i]), &rule) == 0) {
+            printf("  FAIL accepted \"%s\"\n", INVALID[i]);
+            failed = 1;
+        }
+    }
+
+    printf("Testing length limit...\n");
+    char word[RULES_MAX_LEN];
+    memset(word, 'a', sizeof(word));
+    rule_parse("d", 1, &rule);
+    if (rule_apply(&rule, word, RULES_MAX_LEN / 2, out) != RULES_MAX_LEN ||
+        rule_apply(&rule, word, RULES_MAX_LEN / 2 + 1, out) != -1) {
+        printf("  FAIL length limit\n");
+        failed = 1;
+    }
+
+    printf("Testing rules_load...\n");
+    char path[] = "/tmp/test_rules_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("  FAIL mkstemp\n");
+        return 1;
+    }
+    const char *text = "# comment\n:\n\nc $1\r\nsa@\n";
+    if (write(fd, text, strlen(text)) != (ssize_t)strlen(text))
+        failed = 1;
+    close(fd);
+    RULE_SET set;
+    if (rules_load(path, &set) != 0 || set.count != 3 || set.rules[1].nops != 2) {
+        printf("  FAIL rules_load\n");
+        failed = 1;
+    } else {
+        rules_free(&set);
+    }
+    unlink(path);
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -14,13 +14,13 @@
 #include "sha256.h"  // 对应的头文件
 
 /* 初始哈希值 */
-static const uint32_t sha256_initial_h[8] = {
+const uint32_t sha256_initial_h[8] = {
     0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
 };
 
 /* 64 个轮常量 */
-static const uint32_t sha256_round_k[64] = {
+const uint32_t sha256_round_k[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
     0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
@@ -73,96 +73,205 @@ void sha256_endian_reverse64(uint64_t input, uint8_t *output) {
 }
 
 /*
- * 主 SHA-256 函数
- * data: 输入数据
- * len: 输入数据长度（字节）
- * output: 输出 32 字节的哈希值
+ * 压缩函数：w[0..15] 为已按大端读入的消息字，w[16..63] 在此扩展
  */
-void sha256(const void *data, uint64_t len, void *output) {
-    const uint8_t *data_bytes = (const uint8_t*)data;
-    // 计算填充后的总长度：总长度为最小的64的倍数，且 >= len+9
-    uint64_t padded_len = ((len + 9 + 63) / 64) * 64;
-    uint8_t *padded = (uint8_t*)malloc(padded_len);
-    if (!padded) {
-        // 内存不足时不执行计算
-        return;
+static inline void sha256_compress(uint32_t h[8], uint32_t w[64]) {
+    // 扩展消息调度数组 w[16..63]
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = sha256_ror(w[i - 15], 7) ^ sha256_ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = sha256_ror(w[i - 2], 17) ^ sha256_ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
     }
-    
-    // 将原始数据复制到 padded 缓冲区
-    memcpy(padded, data_bytes, len);
-    // 在数据末尾添加 0x80
-    padded[len] = 0x80;
-    // 填充 0x00（从 len+1 到 padded_len - 8）
-    memset(padded + len + 1, 0, padded_len - len - 9);
-    // 在 padded 的最后 8 字节写入消息长度（以比特为单位，使用大端格式）
-    uint64_t bits_len = len * 8;
-    sha256_endian_reverse64(bits_len, padded + padded_len - 8);
-    
-    // 初始化哈希状态
-    uint32_t h[8];
-    for (int i = 0; i < 8; i++) {
-        h[i] = sha256_initial_h[i];
+
+    // 初始化工作变量
+    uint32_t a = h[0];
+    uint32_t b = h[1];
+    uint32_t c = h[2];
+    uint32_t d = h[3];
+    uint32_t e = h[4];
+    uint32_t f = h[5];
+    uint32_t g = h[6];
+    uint32_t hh = h[7];
+
+    // 主压缩循环
+    for (int i = 0; i < 64; i++) {
+        uint32_t S1 = sha256_ror(e, 6) ^ sha256_ror(e, 11) ^ sha256_ror(e, 25);
+        uint32_t ch = (e & f) ^ ((~e) & g);
+        uint32_t temp1 = hh + S1 + ch + sha256_round_k[i] + w[i];
+        uint32_t S0 = sha256_ror(a, 2) ^ sha256_ror(a, 13) ^ sha256_ror(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t temp2 = S0 + maj;
+
+        hh = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
     }
-    
+
+    // 将本块处理结果累加到哈希状态
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+    h[5] += f;
+    h[6] += g;
+    h[7] += hh;
+}
+
+/*
+ * 压缩一个 64 字节块，更新哈希状态 h
+ */
+void sha256_transform(uint32_t h[8], const uint8_t *block) {
     uint32_t w[64];
-    // 对每个 64 字节块进行处理
-    for (uint64_t block = 0; block < padded_len; block += 64) {
-        // 将前 16 个 32 位字读入消息调度数组
-        for (int i = 0; i < 16; i++) {
-            w[i] = sha256_endian_read32(padded + block + i * 4);
-        }
-        // 扩展消息调度数组 w[16..63]
-        for (int i = 16; i < 64; i++) {
-            uint32_t s0 = sha256_ror(w[i - 15], 7) ^ sha256_ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
-            uint32_t s1 = sha256_ror(w[i - 2], 17) ^ sha256_ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
-            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    // 将前 16 个 32 位字读入消息调度数组
+    for (int i = 0; i < 16; i++) {
+        w[i] = sha256_endian_read32(block + i * 4);
+    }
+    sha256_compress(h, w);
+}
+
+/*
+ * 迭代哈希：对 32 字节输入连续做 rounds 次 SHA-256。
+ * 32 字节消息总是恰好一个块，填充字 w[8..15] 是常量，只需设置一次；
+ * 扩展只写 w[16..63]，因此每轮只需把上一轮的结果放回 w[0..7]。
+ */
+void sha256_iterate(const void *input, uint64_t rounds, void *output) {
+    const uint8_t *in = (const uint8_t *)input;
+    uint32_t w[64];
+    for (int i = 0; i < 8; i++) {
+        w[i] = sha256_endian_read32(in + i * 4);
+    }
+    w[8] = 0x80000000;
+    for (int i = 9; i < 15; i++) {
+        w[i] = 0;
+    }
+    w[15] = 256;
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        uint32_t h[8];
+        for (int i = 0; i < 8; i++) {
+            h[i] = sha256_initial_h[i];
         }
-        
-        // 初始化工作变量
-        uint32_t a = h[0];
-        uint32_t b = h[1];
-        uint32_t c = h[2];
-        uint32_t d = h[3];
-        uint32_t e = h[4];
-        uint32_t f = h[5];
-        uint32_t g = h[6];
-        uint32_t hh = h[7];
-        
-        // 主压缩循环
-        for (int i = 0; i < 64; i++) {
-            uint32_t S1 = sha256_ror(e, 6) ^ sha256_ror(e, 11) ^ sha256_ror(e, 25);
-            uint32_t ch = (e & f) ^ ((~e) & g);
-            uint32_t temp1 = hh + S1 + ch + sha256_round_k[i] + w[i];
-            uint32_t S0 = sha256_ror(a, 2) ^ sha256_ror(a, 13) ^ sha256_ror(a, 22);
-            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
-            uint32_t temp2 = S0 + maj;
-            
-            hh = g;
-            g = f;
-            f = e;
-            e = d + temp1;
-            d = c;
-            c = b;
-            b = a;
-            a = temp1 + temp2;
+        sha256_compress(h, w);
+        for (int i = 0; i < 8; i++) {
+            w[i] = h[i];
         }
-        
-        // 将本块处理结果累加到哈希状态
-        h[0] += a;
-        h[1] += b;
-        h[2] += c;
-        h[3] += d;
-        h[4] += e;
-        h[5] += f;
-        h[6] += g;
-        h[7] += hh;
     }
-    
-    free(padded);
-    
+
+    for (int i = 0; i < 8; i++) {
+        sha256_endian_reverse32(w[i], ((uint8_t*)output) + i * 4);
+    }
+}
+
+/* ---------------- 中间状态（midstate）接口 ---------------- */
+
+void sha256_midstate_init(SHA256_MIDSTATE *ms) {
+    for (int i = 0; i < 8; i++) {
+        ms->h[i] = sha256_initial_h[i];
+    }
+    ms->len = 0;
+}
+
+uint64_t sha256_midstate_absorb(SHA256_MIDSTATE *ms, const void *data, uint64_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t blocks = len / 64;
+    for (uint64_t i = 0; i < blocks; i++) {
+        sha256_transform(ms->h, p + i * 64);
+    }
+    ms->len += blocks * 64;
+    return blocks * 64;
+}
+
+void sha256_midstate_finish(const SHA256_MIDSTATE *ms, const void *data, uint64_t len, void *output) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t h[8];
+    memcpy(h, ms->h, sizeof(h));
+
+    // 直接压缩剩余数据中的完整块，无需复制
+    uint64_t full = len & ~(uint64_t)63;
+    for (uint64_t off = 0; off < full; off += 64) {
+        sha256_transform(h, p + off);
+    }
+
+    // 末尾不足一块的数据与填充最多占两个块，放在栈上处理
+    uint8_t tail[128];
+    uint64_t rest = len - full;
+    uint64_t tail_len = (rest + 9 <= 64) ? 64 : 128;
+    memcpy(tail, p + full, rest);
+    tail[rest] = 0x80;
+    memset(tail + rest + 1, 0, tail_len - rest - 9);
+    // 消息长度（以比特为单位，大端格式）
+    sha256_endian_reverse64((ms->len + len) * 8, tail + tail_len - 8);
+    sha256_transform(h, tail);
+    if (tail_len == 128) {
+        sha256_transform(h, tail + 64);
+    }
+
     // 将最终哈希值以大端格式写入输出缓冲区（32 字节）
     for (int i = 0; i < 8; i++) {
         sha256_endian_reverse32(h[i], ((uint8_t*)output) + i * 4);
     }
 }
 
+size_t sha256_prefix_midstates(const void *prefix, uint64_t len, SHA256_MIDSTATE *states, size_t max_states) {
+    const uint8_t *p = (const uint8_t *)prefix;
+    if (max_states == 0)
+        return 0;
+    sha256_midstate_init(&states[0]);
+    size_t count = 1;
+    while (count < max_states && (uint64_t)count * 64 <= len) {
+        states[count] = states[count - 1];
+        sha256_midstate_absorb(&states[count], p + (count - 1) * 64, 64);
+        count++;
+    }
+    return count;
+}
+
+/* ---------------- 公共前缀缓存 ---------------- */
+
+void sha256_cache_init(SHA256_PREFIX_CACHE *cache) {
+    sha256_midstate_init(&cache->states[0]);
+    cache->count = 0;
+    cache->blocks_reused = 0;
+}
+
+void sha256_cached(SHA256_PREFIX_CACHE *cache, const void *data, uint64_t len, void *output) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    // 与上一条消息比较，找出仍然有效的完整块数
+    size_t reuse = 0;
+    while (reuse < cache->count && (uint64_t)(reuse + 1) * 64 <= len &&
+           memcmp(cache->prefix + reuse * 64, p + reuse * 64, 64) == 0) {
+        reuse++;
+    }
+    cache->blocks_reused += reuse;
+
+    // 从第 reuse 块开始吸收剩余的完整块，并记录中间状态供下一条消息复用
+    size_t count = reuse;
+    while (count < SHA256_CACHE_BLOCKS && (uint64_t)(count + 1) * 64 <= len) {
+        memcpy(cache->prefix + count * 64, p + count * 64, 64);
+        cache->states[count + 1] = cache->states[count];
+        sha256_midstate_absorb(&cache->states[count + 1], p + count * 64, 64);
+        count++;
+    }
+    cache->count = count;
+
+    sha256_midstate_finish(&cache->states[count], p + count * 64, len - (uint64_t)count * 64, output);
+}
+
+/*
+ * 主 SHA-256 函数
+ * data: 输入数据
+ * len: 输入数据长度（字节）
+ * output: 输出 32 字节的哈希值
+ */
+void sha256(const void *data, uint64_t len, void *output) {
+    SHA256_MIDSTATE ms;
+    sha256_midstate_init(&ms);
+    sha256_midstate_finish(&ms, data, len, output);
+}
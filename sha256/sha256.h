@@ -10,6 +10,7 @@
 #define SHA256_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 /*
  * 计算 SHA-256 哈希值
@@ -19,5 +20,89 @@
  */
 void sha256(const void *data, uint64_t len, void *output);
 
+/*
+ * 压缩一个 64 字节块
+ * h: 8 个字的哈希状态，原地更新
+ * block: 64 字节消息块
+ */
+void sha256_transform(uint32_t h[8], const uint8_t *block);
+
+/*
+ * 迭代哈希：对 32 字节的 input 连续做 rounds 次 SHA-256，结果写入 output
+ * rounds 为 0 时原样复制输入；input 与 output 可以相同
+ */
+void sha256_iterate(const void *input, uint64_t rounds, void *output);
+
+/*
+ * 批量迭代哈希：对 count 个连续存放的 32 字节输入分别做 rounds 次 SHA-256。
+ * 在支持的 CPU 上使用 AVX2（8 路）/ AVX-512（16 路）多缓冲实现（sha256_simd.c）。
+ */
+void sha256_iterate_many(const uint8_t *input, size_t count, uint64_t rounds, uint8_t *output);
+
+/* 多缓冲批量哈希支持的最大块数（消息长度 <= 块数 * 64 - 9） */
+#define SHA256_BATCH_MAX_BLOCKS 4
+
+/*
+ * 批量哈希 count 条等长消息：第 i 条位于 input + i * stride，长度为 len，
+ * 结果依次写入 output（每条 32 字节）。
+ * 例如 33 字节压缩公钥（1 块）与 65 字节非压缩公钥（2 块）。
+ * 长度超过 SHA256_BATCH_MAX_BLOCKS 块的消息逐条用标量实现计算。
+ */
+void sha256_batch(const uint8_t *input, size_t stride, uint64_t len, size_t count, uint8_t *output);
+
+/* 初始哈希值与轮常量，供多缓冲实现使用 */
+extern const uint32_t sha256_initial_h[8];
+extern const uint32_t sha256_round_k[64];
+
+/*
+ * SHA-256 中间状态：吸收若干完整 64 字节块之后的哈希状态。
+ * 共享同一前缀的消息可以从中间状态继续计算，跳过前缀部分的压缩。
+ */
+typedef struct sha256_midstate {
+    uint32_t h[8];
+    uint64_t len;   /* 已吸收的字节数（总是 64 的倍数） */
+} SHA256_MIDSTATE;
+
+/* 将中间状态设为初始哈希值 */
+void sha256_midstate_init(SHA256_MIDSTATE *ms);
+
+/*
+ * 吸收 data 中所有完整的 64 字节块，不足一块的尾部被忽略
+ * 返回实际吸收的字节数
+ */
+uint64_t sha256_midstate_absorb(SHA256_MIDSTATE *ms, const void *data, uint64_t len);
+
+/*
+ * 从中间状态继续计算并输出最终哈希值，ms 本身不被修改
+ * data/len: 紧接在已吸收部分之后的剩余消息
+ */
+void sha256_midstate_finish(const SHA256_MIDSTATE *ms, const void *data, uint64_t len, void *output);
+
+/*
+ * 捕获前缀在每个完整块之后的状态
+ * states[0] 为初始状态，states[i] 为吸收前 i 个块之后的状态
+ * 返回写入 states 的个数（最多 max_states）
+ */
+size_t sha256_prefix_midstates(const void *prefix, uint64_t len, SHA256_MIDSTATE *states, size_t max_states);
+
+/* 前缀缓存最多保存的完整块数 */
+#define SHA256_CACHE_BLOCKS 16
+
+/*
+ * 公共前缀缓存：记住上一条消息每个完整块之后的中间状态。
+ * 按字典序处理消息时，相邻消息的公共前缀块无需重新压缩。
+ */
+typedef struct sha256_prefix_cache {
+    SHA256_MIDSTATE states[SHA256_CACHE_BLOCKS + 1];  /* states[i]：吸收前 i 块之后 */
+    uint8_t prefix[SHA256_CACHE_BLOCKS * 64];          /* 上一条消息的前 count 个块 */
+    size_t count;                                       /* 有效的完整块数 */
+    uint64_t blocks_reused;                             /* 统计：累计复用的块数 */
+} SHA256_PREFIX_CACHE;
+
+void sha256_cache_init(SHA256_PREFIX_CACHE *cache);
+
+/* 与 sha256() 结果相同，但复用与上一条消息共享的完整前缀块 */
+void sha256_cached(SHA256_PREFIX_CACHE *cache, const void *data, uint64_t len, void *output);
+
 #endif
 
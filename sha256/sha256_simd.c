@@ -0,0 +1,167 @@
+/* sha256_simd.c */
+/*
+ * SHA-256 多缓冲（multi-buffer）实现：同时计算多条互相独立的消息，
+ * 每条消息占用向量寄存器中的一路。
+ *
+ * 代码使用 GCC 向量扩展编写，同一份压缩函数通过 target 属性分别编译为
+ * AVX2（8 路）与 AVX-512（16 路）版本，运行时按 CPU 支持情况选择，
+ * 不满一组的剩余消息以及不支持的 CPU 退回标量实现。
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "sha256.h"
+
+typedef uint32_t sha256_v8 __attribute__((vector_size(32)));
+typedef uint32_t sha256_v16 __attribute__((vector_size(64)));
+
+/* 向量与标量通用的 SHA-256 基本运算 */
+#define MB_ROR(x, n)    (((x) >> (n)) | ((x) << (32 - (n))))
+#define MB_S0(x)        (MB_ROR(x, 2) ^ MB_ROR(x, 13) ^ MB_ROR(x, 22))
+#define MB_S1(x)        (MB_ROR(x, 6) ^ MB_ROR(x, 11) ^ MB_ROR(x, 25))
+#define MB_G0(x)        (MB_ROR(x, 7) ^ MB_ROR(x, 18) ^ ((x) >> 3))
+#define MB_G1(x)        (MB_ROR(x, 17) ^ MB_ROR(x, 19) ^ ((x) >> 10))
+#define MB_CH(e, f, g)  ((g) ^ ((e) & ((f) ^ (g))))
+#define MB_MAJ(a, b, c) (((a) & (b)) | ((c) & ((a) | (b))))
+
+/* 将标量广播到向量的每一路 */
+#define MB_SPLAT(VT, x) ((VT){0} + (uint32_t)(x))
+
+/*
+ * 对状态 s[8] 做一次压缩（结果已累加回 s）。
+ * w[16] 为消息字，在压缩过程中被改写为滚动的消息调度。
+ */
+#define MB_COMPRESS(s, w) do {                                              \
+    __typeof__((s)[0]) a = (s)[0], b = (s)[1], c = (s)[2], d = (s)[3];      \
+    __typeof__((s)[0]) e = (s)[4], f = (s)[5], g = (s)[6], h = (s)[7];      \
+    _Pragma("GCC unroll 64")                                                \
+    for (int i = 0; i < 64; i++) {                                          \
+        if (i >= 16)                                                        \
+            (w)[i & 15] += MB_G0((w)[(i + 1) & 15]) + (w)[(i + 9) & 15] +   \
+                           MB_G1((w)[(i + 14) & 15]);                       \
+        __typeof__((s)[0]) t1 = h + MB_S1(e) + MB_CH(e, f, g) +             \
+                                sha256_round_k[i] + (w)[i & 15];            \
+        __typeof__((s)[0]) t2 = MB_S0(a) + MB_MAJ(a, b, c);                 \
+        h = g; g = f; f = e; e = d + t1;                                    \
+        d = c; c = b; b = a; a = t1 + t2;                                   \
+    }                                                                       \
+    (s)[0] += a; (s)[1] += b; (s)[2] += c; (s)[3] += d;                     \
+    (s)[4] += e; (s)[5] += f; (s)[6] += g; (s)[7] += h;                     \
+} while (0)
+
+static inline uint32_t mb_read32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+}
+
+static inline void mb_write32(uint32_t v, uint8_t *p) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/*
+ * 迭代哈希内核：每一路持有一个 32 字节摘要，整个迭代过程中状态保存在
+ * 向量寄存器里；32 字节消息的填充字是常量，每轮直接置入，不做任何复制。
+ */
+#define MB_ITERATE_BODY(VT, LANES) do {                                     \
+    VT cur[8], s[8], w[16];                                                 \
+    for (int i = 0; i < 8; i++)                                             \
+        for (int l = 0; l < (LANES); l++)                                   \
+            cur[i][l] = mb_read32(input + l * 32 + i * 4);                  \
+    for (uint64_t r = 0; r < rounds; r++) {                                 \
+        for (int i = 0; i < 8; i++) {                                       \
+            w[i] = cur[i];                                                  \
+            s[i] = MB_SPLAT(VT, sha256_initial_h[i]);                       \
+        }                                                                   \
+        w[8] = MB_SPLAT(VT, 0x80000000);                                    \
+        for (int i = 9; i < 15; i++)                                        \
+            w[i] = MB_SPLAT(VT, 0);                                         \
+        w[15] = MB_SPLAT(VT, 256);                                          \
+        MB_COMPRESS(s, w);                                                  \
+        for (int i = 0; i < 8; i++)                                         \
+            cur[i] = s[i];                                                  \
+    }                                                                       \
+    for (int i = 0; i < 8; i++)                                             \
+        for (int l = 0; l < (LANES); l++)                                   \
+            mb_write32(cur[i][l], output + l * 32 + i * 4);                 \
+} while (0)
+
+__attribute__((target("avx2")))
+static void sha256_iterate_x8(const uint8_t *input, uint64_t rounds, uint8_t *output) {
+    MB_ITERATE_BODY(sha256_v8, 8);
+}
+
+__attribute__((target("avx512f")))
+static void sha256_iterate_x16(const uint8_t *input, uint64_t rounds, uint8_t *output) {
+    MB_ITERATE_BODY(sha256_v16, 16);
+}
+
+void sha256_iterate_many(const uint8_t *input, size_t count, uint64_t rounds, uint8_t *output) {
+    size_t i = 0;
+    if (__builtin_cpu_supports("avx512f")) {
+        for (; i + 16 <= count; i += 16)
+            sha256_iterate_x16(input + i * 32, rounds, output + i * 32);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        for (; i + 8 <= count; i += 8)
+            sha256_iterate_x8(input + i * 32, rounds, output + i * 32);
+    }
+    for (; i < count; i++)
+        sha256_iterate(input + i * 32, rounds, output + i * 32);
+}
+
+/*
+ * 定长消息批量哈希内核：每一路一条消息，先在栈上按标准方式填充，
+ * 再逐块按列读入消息字，所有路同时压缩。
+ */
+#define MB_BATCH_BODY(VT, LANES) do {                                       \
+    uint8_t buf[(LANES)][SHA256_BATCH_MAX_BLOCKS * 64];                     \
+    VT s[8], w[16];                                                         \
+    uint64_t nblocks = (len + 9 + 63) / 64;                                 \
+    for (int l = 0; l < (LANES); l++) {                                     \
+        memcpy(buf[l], input + l * stride, len);                            \
+        buf[l][len] = 0x80;                                                 \
+        memset(buf[l] + len + 1, 0, nblocks * 64 - len - 9);                \
+        for (int i = 0; i < 8; i++)                                         \
+            buf[l][nblocks * 64 - 1 - i] = (uint8_t)((len * 8) >> (8 * i)); \
+    }                                                                       \
+    for (int i = 0; i < 8; i++)                                             \
+        s[i] = MB_SPLAT(VT, sha256_initial_h[i]);                           \
+    for (uint64_t blk = 0; blk < nblocks; blk++) {                          \
+        for (int i = 0; i < 16; i++)                                        \
+            for (int l = 0; l < (LANES); l++)                               \
+                w[i][l] = mb_read32(buf[l] + blk * 64 + i * 4);             \
+        MB_COMPRESS(s, w);                                                  \
+    }                                                                       \
+    for (int i = 0; i < 8; i++)                                             \
+        for (int l = 0; l < (LANES); l++)                                   \
+            mb_write32(s[i][l], output + l * 32 + i * 4);                   \
+} while (0)
+
+__attribute__((target("avx2")))
+static void sha256_batch_x8(const uint8_t *input, size_t stride, uint64_t len, uint8_t *output) {
+    MB_BATCH_BODY(sha256_v8, 8);
+}
+
+__attribute__((target("avx512f")))
+static void sha256_batch_x16(const uint8_t *input, size_t stride, uint64_t len, uint8_t *output) {
+    MB_BATCH_BODY(sha256_v16, 16);
+}
+
+void sha256_batch(const uint8_t *input, size_t stride, uint64_t len, size_t count, uint8_t *output) {
+    size_t i = 0;
+    if (len + 9 <= SHA256_BATCH_MAX_BLOCKS * 64) {
+        if (__builtin_cpu_supports("avx512f")) {
+            for (; i + 16 <= count; i += 16)
+                sha256_batch_x16(input + i * stride, stride, len, output + i * 32);
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            for (; i + 8 <= count; i += 8)
+                sha256_batch_x8(input + i * stride, stride, len, output + i * 32);
+        }
+    }
+    for (; i < count; i++)
+        sha256(input + i * stride, len, output + i * 32);
+}
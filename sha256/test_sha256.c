@@ -0,0 +1,119 @@
+// gcc -O2 -o test_sha256 test_sha256.c sha256.c sha256_simd.c
+// ./test_sha256
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sha256.h"
+
+static void to_hex(const uint8_t *data, size_t len, char *out) {
+    for (size_t i = 0; i < len; i++) {
+        sprintf(out + i * 2, "%02x", data[i]);
+    }
+}
+
+static int check_vector(const char *msg, const char *expected) {
+    uint8_t hash[32];
+    char hex[65];
+    sha256(msg, strlen(msg), hash);
+    to_hex(hash, 32, hex);
+    if (strcmp(hex, expected) != 0) {
+        printf("  FAIL \"%s\": %s\n", msg, hex);
+        return 1;
+    }
+    return 0;
+}
+
+/* 对不同长度的共享前缀消息，比较中间状态恢复与直接计算的结果 */
+static int check_midstates(void) {
+    uint8_t buf[300];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)(i * 7 + 3);
+    }
+    SHA256_MIDSTATE states[5];
+    size_t n = sha256_prefix_midstates(buf, 256, states, 5);
+    if (n != 5) {
+        printf("  FAIL prefix midstates count %zu\n", n);
+        return 1;
+    }
+    for (size_t len = 0; len <= sizeof(buf); len++) {
+        uint8_t expect[32], got[32];
+        sha256(buf, len, expect);
+        size_t k = len / 64 < 4 ? len / 64 : 4;
+        sha256_midstate_finish(&states[k], buf + k * 64, len - k * 64, got);
+        if (memcmp(expect, got, 32) != 0) {
+            printf("  FAIL midstate resume at len %zu\n", len);
+            return 1;
+        }
+    }
+
+    SHA256_PREFIX_CACHE cache;
+    sha256_cache_init(&cache);
+    const size_t lens[] = {200, 200, 130, 64, 0, 300, 299, 128, 129};
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        uint8_t expect[32], got[32];
+        if (i == 1)
+            buf[150] ^= 1;  /* 第三个块不同，只能复用前两个 */
+        sha256(buf, lens[i], expect);
+        sha256_cached(&cache, buf, lens[i], got);
+        if (memcmp(expect, got, 32) != 0) {
+            printf("  FAIL prefix cache at step %zu\n", i);
+            return 1;
+        }
+    }
+    if (cache.blocks_reused == 0) {
+        printf("  FAIL prefix cache never reused a block\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* 迭代哈希（标量与多缓冲）与逐次调用 sha256() 的结果比较 */
+static int check_iterate(void) {
+    enum { COUNT = 37, ROUNDS = 100 };  /* 37 = 16 + 16 + 5，覆盖各个分支 */
+    static uint8_t input[COUNT * 32], expect[COUNT * 32], got[COUNT * 32];
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t)(i * 13 + 1);
+    }
+    memcpy(expect, input, sizeof(input));
+    for (int n = 0; n < COUNT; n++) {
+        for (int r = 0; r < ROUNDS; r++) {
+            sha256(expect + n * 32, 32, expect + n * 32);
+        }
+    }
+    for (int n = 0; n < COUNT; n++) {
+        sha256_iterate(input + n * 32, ROUNDS, got + n * 32);
+    }
+    if (memcmp(expect, got, sizeof(got)) != 0) {
+        printf("  FAIL sha256_iterate\n");
+        return 1;
+    }
+    memset(got, 0, sizeof(got));
+    sha256_iterate_many(input, COUNT, ROUNDS, got);
+    if (memcmp(expect, got, sizeof(got)) != 0) {
+        printf("  FAIL sha256_iterate_many\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    printf("Testing SHA-256 vectors...\n");
+    failed |= check_vector("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    failed |= check_vector("abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    failed |= check_vector("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                           "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    printf("Testing midstate resume and prefix cache...\n");
+    failed |= check_midstates();
+    printf("Testing iterated hashing...\n");
+    failed |= check_iterate();
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * index.c
+ *
+ * 目标集合的 hash160 匹配索引：分块 Bloom 过滤器 + 排序记录上的精确确认。
+ */
+
+#include <string.h>
+
+#include "targets.h"
+
+int target_index_build(TARGET_INDEX *idx, const TARGET_SET *set) {
+    idx->set = set;
+    idx->count = 0;
+    for (uint64_t i = 0; i < set->count; i++)
+        idx->count += set->records[i].len == 20;
+    if (bloom_init(&idx->bloom, idx->count, BLOOM_DEFAULT_BITS_PER_KEY) != 0)
+        return -1;
+    for (uint64_t i = 0; i < set->count; i++) {
+        if (set->records[i].len == 20)
+            bloom_add(&idx->bloom, set->records[i].prog);
+    }
+    return 0;
+}
+
+void target_index_free(TARGET_INDEX *idx) {
+    bloom_free(&idx->bloom);
+    idx->set = NULL;
+    idx->count = 0;
+}
+
+void target_index_prefetch(const TARGET_INDEX *idx, const uint8_t hash[20]) {
+    bloom_prefetch(&idx->bloom, hash);
+}
+
+/*
+ * 记录按程序字节（补 0 到 32 字节）排序，程序相同的记录相邻。
+ * 先找第一条程序 >= hash 的记录，再在程序相同的记录中找 20 字节的一条。
+ */
+static int exact_contains(const TARGET_SET *set, const uint8_t hash[20]) {
+    uint8_t prog[32] = {0};
+    memcpy(prog, hash, 20);
+    uint64_t lo = 0, hi = set->count;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (memcmp(set->records[mid].prog, prog, sizeof(prog)) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo < set->count && memcmp(set->records[lo].prog, prog, sizeof(prog)) == 0; lo++) {
+        if (set->records[lo].len == 20)
+            return 1;
+    }
+    return 0;
+}
+
+int target_index_contains(const TARGET_INDEX *idx, const uint8_t hash[20]) {
+    return bloom_query(&idx->bloom, hash) && exact_contains(idx->set, hash);
+}
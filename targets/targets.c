@@ -0,0 +1,188 @@
+/*
+ * targets.c
+ *
+ * 目标地址的解析、排序文件的写入与 mmap 加载。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "targets.h"
+
+#include "../sha256/sha256.h"
+#include "../base58/base58.h"
+#include "../bech32/bech32.h"
+
+/* 解析 Base58Check 编码的 P2PKH（版本 0x00）或 P2SH（版本 0x05）地址 */
+static int parse_base58_address(const char *addr, size_t len, TARGET_RECORD *rec) {
+    uint8_t bin[25];
+    if (len > B58_MAX_ADDRESS_LEN || !b58dec_25(bin, addr, len))
+        return 0;
+    if (bin[0] != 0x00 && bin[0] != 0x05)
+        return 0;
+    uint8_t hash1[32], hash2[32];
+    sha256(bin, 21, hash1);
+    sha256(hash1, 32, hash2);
+    if (memcmp(hash2, bin + 21, 4) != 0)
+        return 0;
+    rec->type = bin[0] == 0x00 ? TARGET_P2PKH : TARGET_P2SH;
+    rec->len = 20;
+    memcpy(rec->prog, bin + 1, 20);
+    return 1;
+}
+
+int target_from_witness(int witver, const uint8_t *prog, size_t prog_len, TARGET_RECORD *rec) {
+    memset(rec, 0, sizeof(*rec));
+    if (witver < 0 || witver > 16 || prog_len < 2 || prog_len > sizeof(rec->prog))
+        return 0;
+    if (witver == 0)
+        rec->type = prog_len == 20 ? TARGET_P2WPKH : TARGET_P2WSH;
+    else
+        rec->type = (uint8_t)(TARGET_WITNESS + witver);
+    rec->len = (uint8_t)prog_len;
+    memcpy(rec->prog, prog, prog_len);
+    return 1;
+}
+
+/* 解析 Bech32/Bech32m 编码的 segwit 地址（hrp 为 "bc"） */
+static int parse_segwit_address(const char *addr, size_t len, TARGET_RECORD *rec) {
+    SEGWIT_RECORD seg;
+    if (!segwit_addr_decode_many("bc", &addr, &len, 1, &seg))
+        return 0;
+    return target_from_witness(seg.witver, seg.witprog, seg.witprog_len, rec);
+}
+
+int target_is_segwit(const char *addr, size_t len) {
+    return len > 3 && (addr[0] == 'b' || addr[0] == 'B') && (addr[1] == 'c' || addr[1] == 'C') && addr[2] == '1';
+}
+
+int target_parse_address(const char *addr, size_t len, TARGET_RECORD *rec) {
+    memset(rec, 0, sizeof(*rec));
+    if (len == 0)
+        return 0;
+    if (addr[0] == '1' || addr[0] == '3')
+        return parse_base58_address(addr, len, rec);
+    if (target_is_segwit(addr, len))
+        return parse_segwit_address(addr, len, rec);
+    return 0;
+}
+
+int target_record_compare(const void *a, const void *b) {
+    const TARGET_RECORD *ra = (const TARGET_RECORD *)a;
+    const TARGET_RECORD *rb = (const TARGET_RECORD *)b;
+    int c = memcmp(ra->prog, rb->prog, sizeof(ra->prog));
+    if (c != 0)
+        return c;
+    if (ra->type != rb->type)
+        return ra->type < rb->type ? -1 : 1;
+    if (ra->len != rb->len)
+        return ra->len < rb->len ? -1 : 1;
+    return 0;
+}
+
+const char *target_type_name(uint8_t type, char *buf, size_t buf_len) {
+    switch (type) {
+        case TARGET_P2PKH:  return "p2pkh";
+        case TARGET_P2SH:   return "p2sh";
+        case TARGET_P2WPKH: return "p2wpkh";
+        case TARGET_P2WSH:  return "p2wsh";
+    }
+    if (type > TARGET_WITNESS && type <= TARGET_WITNESS + 16) {
+        snprintf(buf, buf_len, "witness-v%d", type - TARGET_WITNESS);
+        return buf;
+    }
+    return "unknown";
+}
+
+int targets_write(const char *path, const TARGET_RECORD *records, uint64_t count) {
+    size_t path_len = strlen(path);
+    char *tmp = (char *)malloc(path_len + 5);
+    if (tmp == NULL)
+        return -1;
+    memcpy(tmp, path, path_len);
+    memcpy(tmp + path_len, ".tmp", 5);
+
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: 无法创建 %s\n", tmp);
+        free(tmp);
+        return -1;
+    }
+    TARGET_FILE_HEADER header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TARGET_FILE_MAGIC, sizeof(header.magic));
+    header.version = TARGET_FILE_VERSION;
+    header.record_size = sizeof(TARGET_RECORD);
+    header.count = count;
+
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             (count == 0 || fwrite(records, sizeof(TARGET_RECORD), count, fp) == count);
+    ok = (fflush(fp) == 0) && ok;
+    ok = (fsync(fileno(fp)) == 0) && ok;
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        fprintf(stderr, "Error: 写入 %s 失败\n", path);
+        unlink(tmp);
+        free(tmp);
+        return -1;
+    }
+    free(tmp);
+    return 0;
+}
+
+int targets_open(const char *path, TARGET_SET *set) {
+    memset(set, 0, sizeof(*set));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: 无法打开目标文件 %s\n", path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TARGET_FILE_HEADER)) {
+        fprintf(stderr, "Error: 目标文件 %s 格式错误\n", path);
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Error: 无法映射目标文件 %s\n", path);
+        return -1;
+    }
+    const TARGET_FILE_HEADER *header = (const TARGET_FILE_HEADER *)map;
+    if (memcmp(header->magic, TARGET_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != TARGET_FILE_VERSION ||
+        header->record_size != sizeof(TARGET_RECORD) ||
+        header->count > ((size_t)st.st_size - sizeof(TARGET_FILE_HEADER)) / sizeof(TARGET_RECORD)) {
+        fprintf(stderr, "Error: 目标文件 %s 格式错误\n", path);
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+    set->records = (const TARGET_RECORD *)((const uint8_t *)map + sizeof(TARGET_FILE_HEADER));
+    set->count = header->count;
+    set->map = map;
+    set->map_len = (size_t)st.st_size;
+    return 0;
+}
+
+void targets_close(TARGET_SET *set) {
+    if (set->map != NULL)
+        munmap(set->map, set->map_len);
+    memset(set, 0, sizeof(*set));
+}
+
+int targets_contains(const TARGET_SET *set, uint8_t type, const uint8_t *prog, size_t len) {
+    TARGET_RECORD key;
+    memset(&key, 0, sizeof(key));
+    if (len > sizeof(key.prog))
+        return 0;
+    memcpy(key.prog, prog, len);
+    key.type = type;
+    key.len = (uint8_t)len;
+    return bsearch(&key, set->records, set->count, sizeof(TARGET_RECORD), target_record_compare) != NULL;
+}
@@ -0,0 +1,121 @@
+/*
+ * targets.h
+ *
+ * 目标地址集合：把比特币地址解析为（类型，20/32 字节程序）记录，
+ * 以排序、去重后的二进制文件保存，匹配时通过 mmap 直接加载。
+ *
+ * 文件格式：TARGET_FILE_HEADER 之后紧跟 count 条 TARGET_RECORD，
+ * 按 target_record_compare 的顺序（程序字节，其次类型）升序排列且无重复。
+ */
+
+#ifndef TARGETS_H
+#define TARGETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../bloom/bloom.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 记录类型 */
+#define TARGET_P2PKH      1   /* 1... 公钥 hash160 */
+#define TARGET_P2SH       2   /* 3... 脚本 hash160 */
+#define TARGET_P2WPKH     3   /* bc1q...，witness v0，20 字节 */
+#define TARGET_P2WSH      4   /* bc1q...，witness v0，32 字节 */
+#define TARGET_WITNESS    16  /* witness v1..v16：类型为 TARGET_WITNESS + 版本 */
+
+#define TARGET_FILE_MAGIC   "BWTARGET"
+#define TARGET_FILE_VERSION 1
+
+typedef struct target_record {
+    uint8_t prog[32];   /* hash160 / witness 程序，不足 32 字节时补 0 */
+    uint8_t type;
+    uint8_t len;        /* 程序实际长度：20 或 32（witness 为 2..32） */
+} TARGET_RECORD;
+
+typedef struct target_file_header {
+    char magic[8];          /* TARGET_FILE_MAGIC */
+    uint32_t version;       /* TARGET_FILE_VERSION */
+    uint32_t record_size;   /* sizeof(TARGET_RECORD) */
+    uint64_t count;         /* 记录条数 */
+} TARGET_FILE_HEADER;
+
+/* 通过 mmap 打开的目标集合 */
+typedef struct target_set {
+    const TARGET_RECORD *records;
+    uint64_t count;
+    void *map;
+    size_t map_len;
+} TARGET_SET;
+
+/**
+ * target_parse_address - 解析一个地址字符串
+ *
+ * @addr: 地址（1... / 3... 为 Base58Check，bc1... 为 Bech32 或 Bech32m），无需 null 结尾
+ * @len: 地址长度，调用者应已去掉首尾空白
+ * @rec: 输出记录
+ *
+ * 成功返回 1；格式、校验和或长度错误返回 0。
+ */
+int target_parse_address(const char *addr, size_t len, TARGET_RECORD *rec);
+
+/* 地址是否以 bc1 开头（不区分大小写），批量加载时这类地址交给 segwit_addr_decode_many */
+int target_is_segwit(const char *addr, size_t len);
+
+/* 由 witness 版本与程序生成记录，版本或长度不合法时返回 0 */
+int target_from_witness(int witver, const uint8_t *prog, size_t prog_len, TARGET_RECORD *rec);
+
+/* 记录比较函数（qsort/bsearch 用）：依次比较程序字节、类型、长度 */
+int target_record_compare(const void *a, const void *b);
+
+/* 返回类型名称，例如 "p2pkh"、"p2wsh"、"witness-v1" */
+const char *target_type_name(uint8_t type, char *buf, size_t buf_len);
+
+/**
+ * targets_write - 将已排序去重的记录写入文件
+ *
+ * 先写入临时文件再改名，保证文件内容要么完整要么不变。成功返回 0。
+ */
+int targets_write(const char *path, const TARGET_RECORD *records, uint64_t count);
+
+/**
+ * targets_open - 以只读 mmap 打开目标文件并校验文件头
+ *
+ * 成功返回 0，失败返回 -1 并输出错误信息。
+ */
+int targets_open(const char *path, TARGET_SET *set);
+void targets_close(TARGET_SET *set);
+
+/* 在集合中二分查找（类型，程序），找到返回 1 */
+int targets_contains(const TARGET_SET *set, uint8_t type, const uint8_t *prog, size_t len);
+
+/*
+ * hash160 匹配索引（index.c）：集合中全部 20 字节程序（P2PKH、P2SH、P2WPKH 及
+ * 20 字节的 witness 程序）放入分块 Bloom 过滤器，过滤器命中后再在 mmap 的
+ * 排序记录上二分查找确认，不复制记录。匹配不区分类型：本工具的 P2SH、Bech32m
+ * 地址同样直接编码公钥 hash160，任一类型的记录都算命中。
+ */
+typedef struct target_index {
+    const TARGET_SET *set;
+    BLOOM bloom;
+    uint64_t count;         /* 放入过滤器的 20 字节程序数 */
+} TARGET_INDEX;
+
+/* 由已打开的集合建立索引，set 须在索引释放前保持打开。成功返回 0，内存不足返回 -1 */
+int target_index_build(TARGET_INDEX *idx, const TARGET_SET *set);
+void target_index_free(TARGET_INDEX *idx);
+
+/* 在过滤器中预取 hash 所在的块 */
+void target_index_prefetch(const TARGET_INDEX *idx, const uint8_t hash[20]);
+
+/* hash 是否为集合中某条 20 字节程序，命中返回 1 */
+int target_index_contains(const TARGET_INDEX *idx, const uint8_t hash[20]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TARGETS_H */
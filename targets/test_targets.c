@@ -0,0 +1,139 @@
+// gcc -O2 -o test_targets test_targets.c targets.c index.c ../bloom/bloom.c ../sha256/sha256.c ../base58/base58.c ../bech32/bech32.c
+// ./test_targets
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "targets.h"
+#include "../sha256/sha256.h"
+
+/* "you are so sexy" 对应压缩公钥的 hash160（本工具的 P2SH 地址同样直接使用该值） */
+static const uint8_t HASH160[20] = {
+    0xa2, 0x97, 0xdc, 0x14, 0xa0, 0x8b, 0xac, 0x02, 0xf0, 0xa0, 0x6f, 0x11, 0x54, 0x3a, 0x2f, 0xd5,
+    0x4f, 0x96, 0x0e, 0x4a
+};
+
+/* 同一短语的压缩公钥，本工具的 P2WSH 程序为其 SHA-256 */
+static const uint8_t PUBKEY[33] = {
+    0x03, 0x79, 0x66, 0xa6, 0x97, 0x37, 0x97, 0xd7, 0x8d, 0x29, 0xd1, 0x4f, 0xa3, 0x25, 0x15, 0x91,
+    0xe1, 0x4a, 0xfd, 0xe3, 0xae, 0xa2, 0xde, 0x3a, 0x00, 0x9b, 0x69, 0x08, 0x80, 0x77, 0x31, 0x40,
+    0x87
+};
+
+static const struct {
+    const char *addr;
+    uint8_t type;
+    uint8_t len;
+} VALID[] = {
+    { "1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfr", TARGET_P2PKH, 20 },
+    { "3GWjK1umitr3xqTc3jVPAoZfK4gN6xZv3r", TARGET_P2SH, 20 },
+    { "bc1q52tac99q3wkq9u9qdug4gw30648evrj2vefgv2", TARGET_P2WPKH, 20 },
+    { "BC1Q52TAC99Q3WKQ9U9QDUG4GW30648EVRJ2VEFGV2", TARGET_P2WPKH, 20 },
+    { "bc1p52tac99q3wkq9u9qdug4gw30648evrj2887rpp", TARGET_WITNESS + 1, 20 },
+    { "bc1qvyhwjp25wsmkcnxynh9cjmgwjq96hayc0mapev24dlf78mpyd2vq90zhk0", TARGET_P2WSH, 32 },
+    { "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", TARGET_WITNESS + 1, 32 },   /* Bech32m */
+};
+
+static const char *INVALID[] = {
+    "",
+    "1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfs",   /* 校验和错误 */
+    "1FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHf0",   /* 非法字符 */
+    "11FpiPURLAzXfsfmAvdpnkBCjAYPeZjXHfr",
+    "bc1q52tac99q3wkq9u9qdug4gw30648evrj2vefgv3",
+    "tb1q52tac99q3wkq9u9qdug4gw30648evrj2vefgv2",
+    "notanaddress",
+};
+
+int main(void) {
+    int failed = 0;
+    TARGET_RECORD recs[sizeof(VALID) / sizeof(VALID[0])];
+    size_t n = sizeof(VALID) / sizeof(VALID[0]);
+
+    uint8_t wsh[32];
+    sha256(PUBKEY, sizeof(PUBKEY), wsh);
+
+    printf("Testing address parsing...\n");
+    for (size_t i = 0; i < n; i++) {
+        if (!target_parse_address(VALID[i].addr, strlen(VALID[i].addr), &recs[i]) ||
+            recs[i].type != VALID[i].type || recs[i].len != VALID[i].len) {
+            printf("  FAIL %s\n", VALID[i].addr);
+            failed = 1;
+        } else if ((recs[i].len == 20 && memcmp(recs[i].prog, HASH160, 20) != 0) ||
+                   (recs[i].type == TARGET_P2WSH && memcmp(recs[i].prog, wsh, 32) != 0)) {
+            printf("  FAIL program of %s\n", VALID[i].addr);
+            failed = 1;
+        }
+    }
+    for (size_t i = 0; i < sizeof(INVALID) / sizeof(INVALID[0]); i++) {
+        TARGET_RECORD rec;
+        if (target_parse_address(INVALID[i], strlen(INVALID[i]), &rec)) {
+            printf("  FAIL accepted %s\n", INVALID[i]);
+            failed = 1;
+        }
+    }
+
+    printf("Testing write/open/contains...\n");
+    char path[] = "/tmp/test_targets_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("  FAIL mkstemp\n");
+        return 1;
+    }
+    close(fd);
+    /* 大写 bech32 与小写为同一记录，排序去重后剩 6 条 */
+    qsort(recs, n, sizeof(TARGET_RECORD), target_record_compare);
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (m == 0 || target_record_compare(&recs[m - 1], &recs[i]) != 0)
+            recs[m++] = recs[i];
+    }
+    TARGET_SET set;
+    if (m != 6 || targets_write(path, recs, m) != 0 || targets_open(path, &set) != 0 || set.count != 6) {
+        printf("  FAIL round trip\n");
+        failed = 1;
+    } else {
+        if (!targets_contains(&set, TARGET_P2PKH, HASH160, 20) ||
+            !targets_contains(&set, TARGET_P2WPKH, HASH160, 20) ||
+            !targets_contains(&set, TARGET_P2SH, HASH160, 20) ||
+            targets_contains(&set, TARGET_P2WSH, HASH160, 20)) {
+            printf("  FAIL targets_contains\n");
+            failed = 1;
+        }
+
+        /* 索引只收 20 字节程序：HASH160 命中，32 字节程序与其他哈希不命中 */
+        printf("Testing target index...\n");
+        TARGET_INDEX idx;
+        uint8_t other[20];
+        memcpy(other, HASH160, 20);
+        other[19] ^= 1;
+        const uint8_t *prog32 = NULL;
+        for (size_t i = 0; i < m; i++) {
+            if (recs[i].len == 32)
+                prog32 = recs[i].prog;
+        }
+        if (target_index_build(&idx, &set) != 0) {
+            printf("  FAIL target_index_build\n");
+            failed = 1;
+        } else {
+            if (idx.count != 4 || !target_index_contains(&idx, HASH160) ||
+                target_index_contains(&idx, other) ||
+                target_index_contains(&idx, prog32)) {
+                printf("  FAIL target_index_contains\n");
+                failed = 1;
+            }
+            target_index_free(&idx);
+        }
+        targets_close(&set);
+    }
+    unlink(path);
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,80 @@
+// gcc -O2 -pthread -o test_threadpool test_threadpool.c threadpool.c
+// ./test_threadpool
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "threadpool.h"
+
+enum { TASKS = 2000, THREADS = 4 };
+
+static int runs[TASKS];
+static int worker_of[TASKS];
+
+static void count_task(void *task, int worker, void *arg) {
+    int *slot = (int *)task;
+    size_t i = (size_t)(slot - runs);
+    __atomic_add_fetch(slot, 1, __ATOMIC_RELAXED);
+    worker_of[i] = worker;
+    if (arg != NULL && i % 50 == 0)
+        usleep(200);
+}
+
+static int check_runs(const char *what) {
+    for (int i = 0; i < TASKS; i++) {
+        if (runs[i] != 1) {
+            printf("  FAIL %s: task %d ran %d times\n", what, i, runs[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    static int slow = 1;
+
+    printf("Testing round-robin submission...\n");
+    THREADPOOL *pool = threadpool_create(THREADS, count_task, NULL);
+    if (pool == NULL || threadpool_threads(pool) != THREADS) {
+        printf("  FAIL threadpool_create\n");
+        return 1;
+    }
+    for (int i = 0; i < TASKS; i++)
+        threadpool_submit(pool, &runs[i]);
+    threadpool_wait(pool);
+    failed |= check_runs("round robin");
+
+    printf("Testing reuse after wait...\n");
+    memset(runs, 0, sizeof(runs));
+    for (int i = 0; i < TASKS; i++)
+        threadpool_submit(pool, &runs[i]);
+    threadpool_destroy(pool);
+    failed |= check_runs("reuse");
+
+    printf("Testing work stealing from a single queue...\n");
+    memset(runs, 0, sizeof(runs));
+    pool = threadpool_create(THREADS, count_task, &slow);
+    for (int i = 0; i < TASKS; i++)
+        threadpool_submit_to(pool, 0, &runs[i]);
+    threadpool_wait(pool);
+    failed |= check_runs("stealing");
+    int others = 0;
+    for (int i = 0; i < TASKS; i++)
+        others += worker_of[i] != 0;
+    if (threadpool_steals(pool) == 0 || (uint64_t)others != threadpool_steals(pool)) {
+        printf("  FAIL steals %llu, tasks run by other workers %d\n",
+               (unsigned long long)threadpool_steals(pool), others);
+        failed = 1;
+    }
+    threadpool_destroy(pool);
+
+    if (failed) {
+        printf("Some tests failed.\n");
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * threadpool.c
+ *
+ * 工作窃取线程池。
+ *
+ * 每个队列是由自身互斥锁保护的环形缓冲区：线程从头部取自己的任务，
+ * 窃取者从尾部取。queued 统计所有队列中的任务数，空闲线程在 queued 为 0 时
+ * 睡眠在 work_cv 上；提交者先增加 queued 再在池锁下发信号，
+ * 因此线程在检查 queued 与开始等待之间不会漏掉唤醒。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "threadpool.h"
+
+typedef struct tp_deque {
+    pthread_mutex_t lock;
+    void **items;
+    size_t head;    /* 头部元素的下标 */
+    size_t count;
+    size_t cap;     /* 2 的幂 */
+} TP_DEQUE;
+
+struct threadpool {
+    int threads;                /* 已启动的线程数 */
+    int queues;                 /* 队列数，启动线程前确定；未能启动的线程的队列由其他线程窃取 */
+    pthread_t *tids;
+    TP_DEQUE *deques;
+    THREADPOOL_FN fn;
+    void *arg;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;     /* 有新任务或需要停止 */
+    pthread_cond_t done_cv;     /* pending 降为 0 */
+    size_t queued;              /* 队列中的任务数（原子访问） */
+    size_t pending;             /* 已提交未完成的任务数（lock 保护） */
+    int stop;
+    unsigned next;              /* 轮流提交的下一个线程 */
+    uint64_t steals;            /* 原子访问 */
+};
+
+typedef struct tp_worker_arg {
+    THREADPOOL *pool;
+    int id;
+} TP_WORKER_ARG;
+
+static void deque_push_back(TP_DEQUE *dq, void *task) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count == dq->cap) {
+        size_t cap = dq->cap ? dq->cap * 2 : 64;
+        void **items = (void **)malloc(cap * sizeof(void *));
+        if (items == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed.\n");
+            abort();
+        }
+        for (size_t i = 0; i < dq->count; i++)
+            items[i] = dq->items[(dq->head + i) & (dq->cap - 1)];
+        free(dq->items);
+        dq->items = items;
+        dq->head = 0;
+        dq->cap = cap;
+    }
+    dq->items[(dq->head + dq->count) & (dq->cap - 1)] = task;
+    dq->count++;
+    pthread_mutex_unlock(&dq->lock);
+}
+
+static void *deque_pop_front(TP_DEQUE *dq) {
+    void *task = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count > 0) {
+        task = dq->items[dq->head];
+        dq->head = (dq->head + 1) & (dq->cap - 1);
+        dq->count--;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return task;
+}
+
+static void *deque_pop_back(TP_DEQUE *dq) {
+    void *task = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count > 0) {
+        dq->count--;
+        task = dq->items[(dq->head + dq->count) & (dq->cap - 1)];
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return task;
+}
+
+/* 先取自己的队列，再从其他线程的队列尾部窃取 */
+static void *take_task(THREADPOOL *pool, int id) {
+    void *task = deque_pop_front(&pool->deques[id]);
+    for (int k = 1; task == NULL && k < pool->queues; k++) {
+        task = deque_pop_back(&pool->deques[(id + k) % pool->queues]);
+        if (task != NULL)
+            __atomic_add_fetch(&pool->steals, 1, __ATOMIC_RELAXED);
+    }
+    if (task != NULL)
+        __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+    return task;
+}
+
+static void *worker_main(void *p) {
+    TP_WORKER_ARG *wa = (TP_WORKER_ARG *)p;
+    THREADPOOL *pool = wa->pool;
+    int id = wa->id;
+    free(wa);
+
+    for (;;) {
+        void *task = take_task(pool, id);
+        if (task != NULL) {
+            pool->fn(task, id, pool->arg);
+            pthread_mutex_lock(&pool->lock);
+            if (--pool->pending == 0)
+                pthread_cond_broadcast(&pool->done_cv);
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0 && !pool->stop)
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        int stop = pool->stop && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop)
+            break;
+    }
+    return NULL;
+}
+
+THREADPOOL *threadpool_create(int threads, THREADPOOL_FN fn, void *arg) {
+    if (threads < 1)
+        threads = 1;
+    THREADPOOL *pool = (THREADPOOL *)calloc(1, sizeof(THREADPOOL));
+    if (pool == NULL)
+        return NULL;
+    pool->tids = (pthread_t *)calloc(threads, sizeof(pthread_t));
+    pool->deques = (TP_DEQUE *)calloc(threads, sizeof(TP_DEQUE));
+    if (pool->tids == NULL || pool->deques == NULL) {
+        free(pool->tids);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    pool->fn = fn;
+    pool->arg = arg;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    for (int i = 0; i < threads; i++)
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+    pool->queues = threads;
+
+    for (int i = 0; i < threads; i++) {
+        TP_WORKER_ARG *wa = (TP_WORKER_ARG *)malloc(sizeof(TP_WORKER_ARG));
+        if (wa == NULL)
+            break;
+        wa->pool = pool;
+        wa->id = i;
+        if (pthread_create(&pool->tids[i], NULL, worker_main, wa) != 0) {
+            free(wa);
+            break;
+        }
+        pool->threads++;
+    }
+    if (pool->threads == 0) {
+        threadpool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void threadpool_submit_to(THREADPOOL *pool, int worker, void *task) {
+    pthread_mutex_lock(&pool->lock);
+    pool->pending++;
+    pthread_mutex_unlock(&pool->lock);
+
+    deque_push_back(&pool->deques[(unsigned)worker % pool->queues], task);
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void threadpool_submit(THREADPOOL *pool, void *task) {
+    threadpool_submit_to(pool, (int)(pool->next++ % pool->queues), task);
+}
+
+void threadpool_wait(THREADPOOL *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void threadpool_destroy(THREADPOOL *pool) {
+    if (pool == NULL)
+        return;
+    threadpool_wait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->threads; i++)
+        pthread_join(pool->tids[i], NULL);
+
+    for (int i = 0; i < pool->queues; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].items);
+    }
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->tids);
+    free(pool->deques);
+    free(pool);
+}
+
+int threadpool_threads(const THREADPOOL *pool) {
+    return pool->threads;
+}
+
+uint64_t threadpool_steals(const THREADPOOL *pool) {
+    return __atomic_load_n(&pool->steals, __ATOMIC_RELAXED);
+}
+
+int threadpool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
@@ -0,0 +1,59 @@
+/*
+ * threadpool.h
+ *
+ * 带工作窃取的固定线程池。每个工作线程有自己的双端队列：
+ * 线程从自己队列的头部取任务（按提交顺序），自己的队列为空时从其他线程队列的
+ * 尾部窃取。任务是不透明指针，由提交者分配并在任务函数中处理。
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct threadpool THREADPOOL;
+
+/* 任务函数：worker 为执行线程的编号（0..threads-1），可用于索引线程私有状态 */
+typedef void (*THREADPOOL_FN)(void *task, int worker, void *arg);
+
+/**
+ * threadpool_create - 创建并启动线程池
+ *
+ * @threads: 工作线程数（至少 1）
+ * @fn: 任务函数
+ * @arg: 传给任务函数的共享参数
+ *
+ * 失败返回 NULL。
+ */
+THREADPOOL *threadpool_create(int threads, THREADPOOL_FN fn, void *arg);
+
+/* 轮流提交到各线程的队列 */
+void threadpool_submit(THREADPOOL *pool, void *task);
+
+/* 提交到指定线程的队列（worker 对线程数取模） */
+void threadpool_submit_to(THREADPOOL *pool, int worker, void *task);
+
+/* 等待所有已提交的任务执行完毕 */
+void threadpool_wait(THREADPOOL *pool);
+
+/* 等待任务执行完毕后停止并释放线程池 */
+void threadpool_destroy(THREADPOOL *pool);
+
+int threadpool_threads(const THREADPOOL *pool);
+
+/* 统计：累计窃取到的任务数 */
+uint64_t threadpool_steals(const THREADPOOL *pool);
+
+/* 在线 CPU 核数，至少为 1 */
+int threadpool_cpu_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREADPOOL_H */
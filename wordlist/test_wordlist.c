@@ -0,0 +1,129 @@
+// gcc -O2 -o test_wordlist test_wordlist.c wordlist.c
+// ./test_wordlist
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "wordlist.h"
+
+static int failures = 0;
+
+static void check(int cond, const char *what) {
+    if (!cond) {
+        printf("  FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/* 换行查找与 memchr 一致，覆盖各种位置与向量尾部 */
+static void test_find_newline(void) {
+    printf("Testing wordlist_find_newline...\n");
+    char buf[200];
+    for (size_t len = 0; len <= 130; len++) {
+        for (size_t pos = 0; pos <= len; pos++) {
+            memset(buf, 'x', sizeof(buf));
+            if (pos < len)
+                buf[pos] = '\n';
+            /* len 之后的换行不能被找到 */
+            buf[len] = '\n';
+            const char *got = wordlist_find_newline(buf, buf + len);
+            const char *want = memchr(buf, '\n', len);
+            if (want == NULL)
+                want = buf + len;
+            if (got != want) {
+                check(0, "newline position");
+                return;
+            }
+        }
+    }
+}
+
+static int write_file(const char *path, const char *data) {
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+        return -1;
+    fputs(data, fp);
+    return fclose(fp);
+}
+
+static void test_cursor_and_segments(void) {
+    printf("Testing wordlist_next / wordlist_segment_end...\n");
+    char path[] = "/tmp/test_wordlist_XXXXXX";
+    int fd = mkstemp(path);
+    check(fd >= 0, "mkstemp");
+    if (fd < 0)
+        return;
+    close(fd);
+
+    const char *text = "alpha\r\n\nbravo\ncharlie delta\n\r\nlast";
+    const char *want[] = { "alpha", "bravo", "charlie delta", "last" };
+    check(write_file(path, text) == 0, "write");
+
+    WORDLIST wl;
+    check(wordlist_open(&wl, path) == 0, "open");
+    check(wl.size == strlen(text), "size");
+
+    WORDLIST_CURSOR cur;
+    const char *line;
+    size_t len, n = 0;
+    wordlist_cursor_init(&cur, &wl, 0, wl.size);
+    while (wordlist_next(&cur, &line, &len)) {
+        check(n < 4 && len == strlen(want[n]) && memcmp(line, want[n], len) == 0, "line view");
+        n++;
+    }
+    check(n == 4, "line count");
+
+    /* 任意字节与行数上限下，逐段切分拼起来恰好是全部行，每段从行首开始且不超过行数上限 */
+    for (size_t max_bytes = 1; max_bytes <= 12; max_bytes++) {
+        for (size_t max_lines = 1; max_lines <= 4; max_lines++) {
+            size_t pos = 0;
+            n = 0;
+            while (pos < wl.size) {
+                size_t cut = wordlist_segment_end(&wl, pos, wl.size, max_bytes, max_lines);
+                size_t newlines = 0;
+                for (size_t i = pos; i < cut; i++)
+                    newlines += wl.data[i] == '\n';
+                check(cut > pos && cut <= wl.size, "segment progress");
+                check(cut == wl.size || wl.data[cut - 1] == '\n', "segment at line start");
+                check(newlines <= max_lines, "segment line cap");
+                wordlist_cursor_init(&cur, &wl, pos, cut);
+                while (wordlist_next(&cur, &line, &len)) {
+                    check(n < 4 && len == strlen(want[n]) && memcmp(line, want[n], len) == 0, "segment line view");
+                    n++;
+                }
+                pos = cut;
+            }
+            check(n == 4, "segment line count");
+        }
+    }
+    check(wordlist_segment_end(&wl, 0, wl.size, 1000, 2) == 8, "line cap before byte cap");
+    check(wordlist_segment_end(&wl, 0, wl.size, 1000, 100) == wl.size, "whole file");
+
+    check(wordlist_line_at(&wl, 8, &line, &len) && len == 5 && memcmp(line, "bravo", 5) == 0, "line_at");
+    check(wordlist_line_at(&wl, strlen(text) - 4, &line, &len) && len == 4, "line_at last");
+    check(!wordlist_line_at(&wl, wl.size, &line, &len), "line_at out of range");
+    wordlist_close(&wl);
+
+    /* 空文件可以打开，没有任何行 */
+    check(write_file(path, "") == 0, "write empty");
+    check(wordlist_open(&wl, path) == 0 && wl.size == 0, "open empty");
+    wordlist_cursor_init(&cur, &wl, 0, wl.size);
+    check(!wordlist_next(&cur, &line, &len), "empty has no lines");
+    wordlist_close(&wl);
+
+    unlink(path);
+    check(wordlist_open(&wl, path) != 0, "missing file fails");
+}
+
+int main(void) {
+    test_find_newline();
+    test_cursor_and_segments();
+    if (failures) {
+        printf("%d test(s) failed.\n", failures);
+        return 1;
+    }
+    printf("All tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * wordlist.c
+ *
+ * 内存映射词表与向量化换行扫描。
+ *
+ * 换行查找每次比较 32 字节（AVX2）或 16 字节（SSE2），把比较结果按 64 位字检查，
+ * 第一个非零字的最低置位字节即为换行位置；不足一个向量的尾部逐字节查找，
+ * 不会读取映射范围之外的内存。
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "wordlist.h"
+
+typedef char wl_v16c __attribute__((vector_size(16)));
+typedef char wl_v32c __attribute__((vector_size(32)));
+
+static inline const char *find_newline_scalar(const char *p, const char *end) {
+    while (p < end && *p != '\n')
+        p++;
+    return p;
+}
+
+/* 在 n 个 64 位字中找第一个非零字节，eq 为逐字节比较结果 */
+#define WL_FIRST_MATCH(p, eq, n) do {                                        \
+    uint64_t w_[n];                                                           \
+    memcpy(w_, &(eq), sizeof(w_));                                            \
+    for (int k_ = 0; k_ < (n); k_++) {                                        \
+        if (w_[k_] != 0)                                                      \
+            return (p) + 8 * k_ + (__builtin_ctzll(w_[k_]) >> 3);             \
+    }                                                                         \
+} while (0)
+
+static const char *find_newline_sse2(const char *p, const char *end) {
+    for (; end - p >= 16; p += 16) {
+        wl_v16c v;
+        memcpy(&v, p, 16);
+        wl_v16c eq = (wl_v16c)(v == '\n');
+        WL_FIRST_MATCH(p, eq, 2);
+    }
+    return find_newline_scalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *find_newline_avx2(const char *p, const char *end) {
+    for (; end - p >= 32; p += 32) {
+        wl_v32c v;
+        memcpy(&v, p, 32);
+        wl_v32c eq = (wl_v32c)(v == '\n');
+        WL_FIRST_MATCH(p, eq, 4);
+    }
+    return find_newline_sse2(p, end);
+}
+
+const char *wordlist_find_newline(const char *p, const char *end) {
+    if (__builtin_cpu_supports("avx2"))
+        return find_newline_avx2(p, end);
+    return find_newline_sse2(p, end);
+}
+
+int wordlist_open(WORDLIST *wl, const char *path) {
+    wl->data = NULL;
+    wl->size = 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (!S_ISREG(sb.st_mode)) {
+        close(fd);
+        errno = ESPIPE;
+        return -1;
+    }
+    if (sb.st_size > 0) {
+        void *map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            errno = err;
+            return -1;
+        }
+        madvise(map, (size_t)sb.st_size, MADV_SEQUENTIAL);
+        wl->data = (const char *)map;
+        wl->size = (size_t)sb.st_size;
+    }
+    /* 映射建立后即可关闭文件描述符 */
+    close(fd);
+    return 0;
+}
+
+void wordlist_close(WORDLIST *wl) {
+    if (wl->data != NULL)
+        munmap((void *)wl->data, wl->size);
+    wl->data = NULL;
+    wl->size = 0;
+}
+
+size_t wordlist_line_start(const WORDLIST *wl, size_t offset) {
+    if (offset == 0 || offset >= wl->size)
+        return offset < wl->size ? offset : wl->size;
+    if (wl->data[offset - 1] == '\n')
+        return offset;
+    const char *nl = wordlist_find_newline(wl->data + offset, wl->data + wl->size);
+    return nl < wl->data + wl->size ? (size_t)(nl - wl->data) + 1 : wl->size;
+}
+
+size_t wordlist_segment_end(const WORDLIST *wl, size_t begin, size_t end, size_t max_bytes, size_t max_lines) {
+    size_t limit = end - begin > max_bytes ? wordlist_line_start(wl, begin + max_bytes) : end;
+    if (limit > end)
+        limit = end;
+    const char *p = wl->data + begin, *stop = wl->data + limit;
+    for (size_t n = 0; n < max_lines && p < stop; n++) {
+        const char *nl = wordlist_find_newline(p, stop);
+        p = nl < stop ? nl + 1 : stop;
+    }
+    return (size_t)(p - wl->data);
+}
+
+void wordlist_cursor_init(WORDLIST_CURSOR *cur, const WORDLIST *wl, size_t begin, size_t end) {
+    cur->p = wl->data + begin;
+    cur->end = wl->data + end;
+}
+
+int wordlist_next(WORDLIST_CURSOR *cur, const char **line, size_t *len) {
+    while (cur->p < cur->end) {
+        const char *start = cur->p;
+        const char *nl = wordlist_find_newline(start, cur->end);
+        cur->p = nl < cur->end ? nl + 1 : cur->end;
+        while (nl > start && (nl[-1] == '\r' || nl[-1] == '\n'))
+            nl--;
+        if (nl > start) {
+            *line = start;
+            *len = (size_t)(nl - start);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int wordlist_line_at(const WORDLIST *wl, size_t offset, const char **line, size_t *len) {
+    if (offset >= wl->size)
+        return 0;
+    const char *start = wl->data + offset;
+    const char *nl = wordlist_find_newline(start, wl->data + wl->size);
+    while (nl > start && nl[-1] == '\r')
+        nl--;
+    *line = start;
+    *len = (size_t)(nl - start);
+    return 1;
+}
@@ -0,0 +1,70 @@
+/*
+ * wordlist.h
+ *
+ * 内存映射的只读词表。整个文件用 mmap 映射，行以 (指针, 长度) 视图给出，
+ * 不复制也不以 '\0' 结尾；换行符查找使用向量化扫描。
+ */
+
+#ifndef WORDLIST_H
+#define WORDLIST_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wordlist {
+    const char *data;   /* 映射起始地址，空文件时为 NULL */
+    size_t size;
+} WORDLIST;
+
+/* 行游标：在 [p, end) 内逐行前进 */
+typedef struct wordlist_cursor {
+    const char *p;
+    const char *end;
+} WORDLIST_CURSOR;
+
+/**
+ * wordlist_open - 映射词表文件
+ *
+ * 映射后设置 MADV_SEQUENTIAL。成功返回 0；打开或映射失败返回 -1，errno 指明原因。
+ * 不是普通文件（管道、终端等）时同样返回 -1，errno 为 ESPIPE。
+ */
+int wordlist_open(WORDLIST *wl, const char *path);
+
+void wordlist_close(WORDLIST *wl);
+
+/* 返回 [p, end) 中第一个 '\n' 的位置，没有时返回 end */
+const char *wordlist_find_newline(const char *p, const char *end);
+
+/* 不小于 offset 的第一个行首偏移（offset 处于行中间时跳到下一行开头） */
+size_t wordlist_line_start(const WORDLIST *wl, size_t offset);
+
+/**
+ * wordlist_segment_end - 从行首 begin 开始切出一段
+ *
+ * 返回段尾偏移 cut（行首或 end），[begin, cut) 不超过 max_lines 行（按换行符计，空行也计入），
+ * 且约为 max_bytes 字节（max_bytes 落在行中间时延伸到该行末尾）。begin < end 时至少包含一行。
+ */
+size_t wordlist_segment_end(const WORDLIST *wl, size_t begin, size_t end, size_t max_bytes, size_t max_lines);
+
+/* 游标初始化为 [begin, end) 偏移范围 */
+void wordlist_cursor_init(WORDLIST_CURSOR *cur, const WORDLIST *wl, size_t begin, size_t end);
+
+/**
+ * wordlist_next - 取下一行
+ *
+ * 去掉行尾的 "\r"，跳过空行。成功时 *line 与 *len 指向映射中的行内容并返回 1，
+ * 游标到达末尾时返回 0。
+ */
+int wordlist_next(WORDLIST_CURSOR *cur, const char **line, size_t *len);
+
+/* 取从 offset 开始的一行（去掉行尾 "\r"），offset 越界时返回 0 */
+int wordlist_line_at(const WORDLIST *wl, size_t offset, const char **line, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORDLIST_H */